@@ -0,0 +1,293 @@
+/**
+ * @file benchmark/benchmark_ray_triangle.cpp
+ * @brief Compares Plucker ray-triangle tests with Moller-Trumbore on procedural scenes.
+ *
+ * Every ray is tested against every triangle, so the numbers are of the kernels,
+ * not of an acceleration structure. Each kernel reports the pair tests per second,
+ * the rays per second, the number of hits, and the number of pairs on which it disagrees
+ * with Moller-Trumbore.
+ * All tests cull back faces, and the Plucker tests work on the whole line of a ray,
+ * so Moller-Trumbore is not restricted to t >= 0 either.
+ * The closest hit kernels compare per ray: the triangle found, or a miss.
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <plucker/plucker.h>
+#include "scenes.h"
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Returns true if a ray hits the front face of a triangle, as in the README.
+ */
+template<typename T>
+bool readme_has_intersection(
+    const plucker::Plucker<T>& ray,
+    const plucker::Vector4<T>& p1,
+    const plucker::Vector4<T>& p2,
+    const plucker::Vector4<T>& p3)
+{
+    if(ray * plucker::Plucker<T>(p1, p2) > static_cast<T>(0))
+        return false;
+    if(ray * plucker::Plucker<T>(p2, p3) > static_cast<T>(0))
+        return false;
+    if(ray * plucker::Plucker<T>(p3, p1) > static_cast<T>(0))
+        return false;
+    return true;
+}
+
+/**
+ * Returns true if a ray hits the front face of a triangle, with its parameter t.
+ */
+template<typename T>
+bool moller_trumbore(
+    const plucker::Vector3<T>& origin,
+    const plucker::Vector3<T>& direction,
+    const plucker::Vector3<T>& p0,
+    const plucker::Vector3<T>& p1,
+    const plucker::Vector3<T>& p2,
+    T& t)
+{
+    const plucker::Vector3<T> e1 = p1 - p0;
+    const plucker::Vector3<T> e2 = p2 - p0;
+    const plucker::Vector3<T> q = direction.cross(e2);
+    const auto det = e1.dot(q);
+    if(det <= static_cast<T>(0))
+        return false;
+    const plucker::Vector3<T> s = origin - p0;
+    const auto u = s.dot(q) / det;
+    if(u < static_cast<T>(0) || u > static_cast<T>(1))
+        return false;
+    const plucker::Vector3<T> r = s.cross(e1);
+    const auto v = direction.dot(r) / det;
+    if(v < static_cast<T>(0) || u + v > static_cast<T>(1))
+        return false;
+    t = e2.dot(r) / det;
+    return true;
+}
+
+/**
+ * Result of a kernel over all pairs of a scene.
+ */
+struct Result
+{
+    double seconds;
+    std::size_t hits;
+    std::size_t disagreements;
+};
+
+/**
+ * Runs `kernel(k, &hits[k * triangle_count])` for each ray k, which sets a hit flag per triangle.
+ */
+template<typename Kernel>
+Result run_pairs(std::size_t ray_count, std::size_t triangle_count, std::vector<std::uint8_t>& hits, Kernel kernel)
+{
+    hits.assign(ray_count * triangle_count, 0);
+
+    const auto start = Clock::now();
+    for(std::size_t k = 0; k < ray_count; k++)
+        kernel(k, &hits[k * triangle_count]);
+    const auto stop = Clock::now();
+
+    Result res = {std::chrono::duration<double>(stop - start).count(), 0, 0};
+    for(const auto hit : hits)
+        res.hits += hit;
+    return res;
+}
+
+std::size_t count_disagreements(const std::vector<std::uint8_t>& hits, const std::vector<std::uint8_t>& reference)
+{
+    std::size_t res = 0;
+    for(std::size_t i = 0; i < hits.size(); i++)
+    {
+        if(hits[i] != reference[i])
+            res++;
+    }
+    return res;
+}
+
+void print_header()
+{
+    std::printf("%-7s %-8s %-8s %-26s %10s %12s %12s %12s %10s\n",
+        "type", "scene", "rays", "kernel", "triangles", "Mtests/s", "rays/s", "hits", "disagree");
+}
+
+void print_row(const char* type, const std::string& scene, const std::string& rays, const char* kernel,
+    std::size_t ray_count, std::size_t triangle_count, const Result& res)
+{
+    const auto tests = static_cast<double>(ray_count) * static_cast<double>(triangle_count);
+    std::printf("%-7s %-8s %-8s %-26s %10zu %12.2f %12.0f %12zu %10zu\n",
+        type, scene.c_str(), rays.c_str(), kernel, triangle_count,
+        tests / res.seconds * 1e-6, static_cast<double>(ray_count) / res.seconds, res.hits, res.disagreements);
+}
+
+template<typename T>
+void run(const char* type, const bench::Scene<T>& scene, const bench::Rays<T>& rays)
+{
+    const plucker::EdgeMesh<T> mesh(scene.vertices, scene.triangles);
+
+    const auto ray_count = static_cast<std::size_t>(rays.origins.rows());
+    const auto triangle_count = mesh.triangle_count();
+
+    const auto vertex = [&](std::size_t t, Eigen::Index i)
+    {
+        return mesh.vertex(scene.triangles(static_cast<Eigen::Index>(t), i));
+    };
+    const auto origin = [&](std::size_t k)
+    {
+        return plucker::Vector3<T>(rays.origins.row(static_cast<Eigen::Index>(k)).transpose());
+    };
+    const auto direction = [&](std::size_t k)
+    {
+        return plucker::Vector3<T>(rays.directions.row(static_cast<Eigen::Index>(k)).transpose());
+    };
+    const auto line = [&](std::size_t k)
+    {
+        return plucker::Plucker<T>(origin(k).homogeneous().eval(), (origin(k) + direction(k)).homogeneous().eval());
+    };
+
+    // Moller-Trumbore is the reference.
+    std::vector<std::uint8_t> reference;
+    const auto mt = run_pairs(ray_count, triangle_count, reference,
+        [&](std::size_t k, std::uint8_t* hits)
+        {
+            const plucker::Vector3<T> o = origin(k);
+            const plucker::Vector3<T> d = direction(k);
+            T t;
+            for(std::size_t i = 0; i < triangle_count; i++)
+                hits[i] = moller_trumbore(o, d, vertex(i, 0), vertex(i, 1), vertex(i, 2), t) ? 1 : 0;
+        });
+    print_row(type, scene.name, rays.name, "moller_trumbore", ray_count, triangle_count, mt);
+
+    // The README test builds the lines of the edges for every pair.
+    std::vector<std::uint8_t> hits;
+    auto readme = run_pairs(ray_count, triangle_count, hits,
+        [&](std::size_t k, std::uint8_t* res)
+        {
+            const auto ray = line(k);
+            for(std::size_t i = 0; i < triangle_count; i++)
+                res[i] = readme_has_intersection(ray,
+                    vertex(i, 0).homogeneous().eval(), vertex(i, 1).homogeneous().eval(), vertex(i, 2).homogeneous().eval()) ? 1 : 0;
+        });
+    readme.disagreements = count_disagreements(hits, reference);
+    print_row(type, scene.name, rays.name, "plucker_readme", ray_count, triangle_count, readme);
+
+    // The lines of the triangle edges are made once, three per triangle, and viewed in place.
+    Eigen::Matrix<T, Eigen::Dynamic, 6, Eigen::RowMajor> triangle_edges(static_cast<Eigen::Index>(3 * triangle_count), 6);
+    for(std::size_t i = 0; i < triangle_count; i++)
+    {
+        for(auto j = 0; j < 3; j++)
+            triangle_edges.row(static_cast<Eigen::Index>(3 * i) + j) = mesh.triangle_edge(i, j).coord().transpose();
+    }
+    auto cached = run_pairs(ray_count, triangle_count, hits,
+        [&](std::size_t k, std::uint8_t* res)
+        {
+            const auto ray = line(k);
+            const T* edge = triangle_edges.data();
+            for(std::size_t i = 0; i < triangle_count; i++, edge += 18)
+            {
+                const auto outside = ray * plucker::PluckerView<const T>(edge) > static_cast<T>(0)
+                    || ray * plucker::PluckerView<const T>(edge + 6) > static_cast<T>(0)
+                    || ray * plucker::PluckerView<const T>(edge + 12) > static_cast<T>(0);
+                res[i] = outside ? 0 : 1;
+            }
+        });
+    cached.disagreements = count_disagreements(hits, reference);
+    print_row(type, scene.name, rays.name, "plucker_cached_edges", ray_count, triangle_count, cached);
+
+    // The edges shared by triangles are evaluated once per ray, with one matrix product.
+    plucker::VectorX<T> products;
+    auto shared = run_pairs(ray_count, triangle_count, hits,
+        [&](std::size_t k, std::uint8_t* res)
+        {
+            mesh.edge_products(line(k), products);
+            for(std::size_t i = 0; i < triangle_count; i++)
+            {
+                const auto w0 = plucker::detail::triangle_product(mesh, products, i, 0);
+                const auto w1 = plucker::detail::triangle_product(mesh, products, i, 1);
+                const auto w2 = plucker::detail::triangle_product(mesh, products, i, 2);
+                res[i] = (w0 > static_cast<T>(0) || w1 > static_cast<T>(0) || w2 > static_cast<T>(0)) ? 0 : 1;
+            }
+        });
+    shared.disagreements = count_disagreements(hits, reference);
+    print_row(type, scene.name, rays.name, "plucker_edge_mesh", ray_count, triangle_count, shared);
+
+    // Closest hits for t >= 0, per ray.
+    const auto inf = std::numeric_limits<T>::infinity();
+    std::vector<std::size_t> closest(ray_count);
+    const auto mt_closest = run_pairs(ray_count, 1, hits,
+        [&](std::size_t k, std::uint8_t* hit)
+        {
+            const plucker::Vector3<T> o = origin(k);
+            const plucker::Vector3<T> d = direction(k);
+            auto best = inf;
+            closest[k] = triangle_count;
+            for(std::size_t i = 0; i < triangle_count; i++)
+            {
+                T t;
+                if(moller_trumbore(o, d, vertex(i, 0), vertex(i, 1), vertex(i, 2), t) && t >= static_cast<T>(0) && t <= best)
+                {
+                    best = t;
+                    closest[k] = i;
+                }
+            }
+            *hit = closest[k] < triangle_count ? 1 : 0;
+        });
+    print_row(type, scene.name, rays.name, "closest_moller_trumbore", ray_count, triangle_count, mt_closest);
+
+    std::vector<std::size_t> plucker_triangles(ray_count);
+    auto plucker_closest = run_pairs(ray_count, 1, hits,
+        [&](std::size_t k, std::uint8_t* hit)
+        {
+            const auto res = plucker::find_closest_hit(mesh, origin(k), direction(k), static_cast<T>(0), inf, products);
+            *hit = std::get<0>(res) ? 1 : 0;
+            plucker_triangles[k] = std::get<0>(res) ? std::get<1>(res).triangle : triangle_count;
+        });
+    for(std::size_t k = 0; k < ray_count; k++)
+    {
+        if(plucker_triangles[k] != closest[k])
+            plucker_closest.disagreements++;
+    }
+    print_row(type, scene.name, rays.name, "closest_plucker_edge_mesh", ray_count, triangle_count, plucker_closest);
+}
+
+template<typename T>
+void run_all(const char* type)
+{
+    std::mt19937 engine(42);
+
+    std::vector<bench::Scene<T>> scenes;
+    scenes.push_back(bench::make_sphere<T>(24, 48));
+    scenes.push_back(bench::make_terrain<T>(32, engine));
+    scenes.push_back(bench::make_soup<T>(2000, static_cast<T>(0.1), engine));
+    scenes.push_back(bench::make_slivers<T>(2000, static_cast<T>(0.002), engine));
+
+    std::vector<bench::Rays<T>> rays;
+    rays.push_back(bench::make_camera_rays<T>(48));
+    rays.push_back(bench::make_diffuse_rays<T>(2304, engine));
+
+    for(const auto& scene : scenes)
+    {
+        for(const auto& r : rays)
+            run(type, scene, r);
+    }
+}
+
+}   // namespace
+
+int main()
+{
+    print_header();
+    run_all<float>("float");
+    run_all<double>("double");
+    return 0;
+}
@@ -0,0 +1,221 @@
+/**
+ * @file benchmark/scenes.h
+ * @brief This file provides procedural meshes and ray distributions for benchmarks.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <plucker/plucker.h>
+
+namespace bench
+{
+
+/**
+ * Triangle mesh of a benchmark scene, counterclockwise seen from the front.
+ */
+template<typename T>
+struct Scene
+{
+    std::string name;
+    plucker::Vector3Batch<T> vertices;
+    typename plucker::EdgeMesh<T>::Triangles triangles;
+};
+
+/**
+ * Rays `origins.row(k) + t directions.row(k)` of a benchmark.
+ */
+template<typename T>
+struct Rays
+{
+    std::string name;
+    plucker::Vector3Batch<T> origins;
+    plucker::Vector3Batch<T> directions;
+};
+
+/**
+ * Returns a unit sphere of `rings` latitudes and `segments` longitudes, facing outward.
+ */
+template<typename T>
+Scene<T> make_sphere(std::uint32_t rings, std::uint32_t segments)
+{
+    const auto pi = static_cast<T>(3.14159265358979323846);
+
+    Scene<T> scene;
+    scene.name = "sphere";
+    scene.vertices.resize((rings + 1) * segments, 3);
+    for(std::uint32_t i = 0; i <= rings; i++)
+    {
+        const auto theta = pi * static_cast<T>(i) / static_cast<T>(rings);
+        for(std::uint32_t j = 0; j < segments; j++)
+        {
+            const auto phi = static_cast<T>(2) * pi * static_cast<T>(j) / static_cast<T>(segments);
+            scene.vertices.row(i * segments + j) << std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta);
+        }
+    }
+
+    // Degenerate triangles at the poles are kept, as real meshes have them too.
+    scene.triangles.resize(2 * rings * segments, 3);
+    for(std::uint32_t i = 0; i < rings; i++)
+    {
+        for(std::uint32_t j = 0; j < segments; j++)
+        {
+            const auto a = i * segments + j;
+            const auto b = i * segments + (j + 1) % segments;
+            const auto c = a + segments;
+            const auto d = b + segments;
+            scene.triangles.row(2 * (i * segments + j)) << a, c, d;
+            scene.triangles.row(2 * (i * segments + j) + 1) << a, d, b;
+        }
+    }
+    return scene;
+}
+
+/**
+ * Returns a height field over [-1, 1]^2 of n x n squares, facing up.
+ */
+template<typename T>
+Scene<T> make_terrain(std::uint32_t n, std::mt19937& engine)
+{
+    std::uniform_real_distribution<T> phase(static_cast<T>(0), static_cast<T>(6.28318530717958647692));
+    const T p1 = phase(engine);
+    const T p2 = phase(engine);
+
+    Scene<T> scene;
+    scene.name = "terrain";
+    scene.vertices.resize((n + 1) * (n + 1), 3);
+    for(std::uint32_t y = 0; y <= n; y++)
+    {
+        for(std::uint32_t x = 0; x <= n; x++)
+        {
+            const auto u = static_cast<T>(2 * x) / static_cast<T>(n) - static_cast<T>(1);
+            const auto v = static_cast<T>(2 * y) / static_cast<T>(n) - static_cast<T>(1);
+            const auto h = static_cast<T>(0.2) * std::sin(static_cast<T>(3) * u + p1) * std::cos(static_cast<T>(4) * v + p2)
+                         + static_cast<T>(0.05) * std::sin(static_cast<T>(17) * u * v);
+            scene.vertices.row(y * (n + 1) + x) << u, v, h;
+        }
+    }
+
+    scene.triangles.resize(2 * n * n, 3);
+    for(std::uint32_t y = 0; y < n; y++)
+    {
+        for(std::uint32_t x = 0; x < n; x++)
+        {
+            const auto v = y * (n + 1) + x;
+            scene.triangles.row(2 * (y * n + x)) << v, v + 1, v + n + 2;
+            scene.triangles.row(2 * (y * n + x) + 1) << v, v + n + 2, v + n + 1;
+        }
+    }
+    return scene;
+}
+
+/**
+ * Returns `count` triangles of random vertices in [-1, 1]^3, facing anywhere.
+ */
+template<typename T>
+Scene<T> make_soup(std::uint32_t count, T size, std::mt19937& engine)
+{
+    std::uniform_real_distribution<T> dist(static_cast<T>(-1), static_cast<T>(1));
+
+    Scene<T> scene;
+    scene.name = "soup";
+    scene.vertices.resize(3 * count, 3);
+    scene.triangles.resize(count, 3);
+    for(std::uint32_t t = 0; t < count; t++)
+    {
+        const plucker::Vector3<T> center(dist(engine), dist(engine), dist(engine));
+        for(std::uint32_t i = 0; i < 3; i++)
+        {
+            const plucker::Vector3<T> offset(dist(engine), dist(engine), dist(engine));
+            scene.vertices.row(3 * t + i) = (center + size * offset).transpose();
+        }
+        scene.triangles.row(t) << 3 * t, 3 * t + 1, 3 * t + 2;
+    }
+    return scene;
+}
+
+/**
+ * Returns `count` long and thin triangles near z = 0, facing up.
+ * Their width is `width` times their length, which stresses the edge tests.
+ */
+template<typename T>
+Scene<T> make_slivers(std::uint32_t count, T width, std::mt19937& engine)
+{
+    std::uniform_real_distribution<T> dist(static_cast<T>(-1), static_cast<T>(1));
+
+    Scene<T> scene;
+    scene.name = "slivers";
+    scene.vertices.resize(3 * count, 3);
+    scene.triangles.resize(count, 3);
+    for(std::uint32_t t = 0; t < count; t++)
+    {
+        const plucker::Vector3<T> a(dist(engine), dist(engine), static_cast<T>(0.1) * dist(engine));
+        const plucker::Vector3<T> b(dist(engine), dist(engine), static_cast<T>(0.1) * dist(engine));
+        const plucker::Vector3<T> d = b - a;
+        const plucker::Vector3<T> side = width * plucker::Vector3<T>(-d.y(), d.x(), static_cast<T>(0));
+        scene.vertices.row(3 * t) = a.transpose();
+        scene.vertices.row(3 * t + 1) = b.transpose();
+        scene.vertices.row(3 * t + 2) = (static_cast<T>(0.5) * (a + b) + side).transpose();
+        scene.triangles.row(t) << 3 * t, 3 * t + 1, 3 * t + 2;
+    }
+    return scene;
+}
+
+/**
+ * Returns the rays of a pinhole camera of n x n pixels looking at the origin from above.
+ */
+template<typename T>
+Rays<T> make_camera_rays(int n)
+{
+    Eigen::Matrix<T, 3, 3> rotation;
+    rotation <<
+        static_cast<T>(1),  static_cast<T>(0),  static_cast<T>(0),
+        static_cast<T>(0), -static_cast<T>(1),  static_cast<T>(0),
+        static_cast<T>(0),  static_cast<T>(0), -static_cast<T>(1);
+    const auto f = static_cast<T>(n);
+    const auto c = static_cast<T>(n) / static_cast<T>(2);
+    const plucker::PinholeCamera<T> camera(
+        plucker::Vector3<T>(static_cast<T>(0.1), static_cast<T>(0.05), static_cast<T>(3)), rotation, f, f, c, c, n, n);
+
+    Rays<T> rays;
+    rays.name = "camera";
+    rays.origins.resize(static_cast<Eigen::Index>(camera.pixel_count()), 3);
+    rays.directions.resize(static_cast<Eigen::Index>(camera.pixel_count()), 3);
+    for(auto y = 0; y < n; y++)
+    {
+        for(auto x = 0; x < n; x++)
+        {
+            const auto row = static_cast<Eigen::Index>(x + n * y);
+            rays.origins.row(row) = camera.position().transpose();
+            rays.directions.row(row) = camera.direction(x, y).transpose();
+        }
+    }
+    return rays;
+}
+
+/**
+ * Returns `count` rays of random origins in [-1.5, 1.5]^3 and uniformly random directions,
+ * as bounced diffuse rays are.
+ */
+template<typename T>
+Rays<T> make_diffuse_rays(Eigen::Index count, std::mt19937& engine)
+{
+    std::uniform_real_distribution<T> dist(static_cast<T>(-1.5), static_cast<T>(1.5));
+    std::normal_distribution<T> normal;
+
+    Rays<T> rays;
+    rays.name = "diffuse";
+    rays.origins.resize(count, 3);
+    rays.directions.resize(count, 3);
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        rays.origins.row(k) << dist(engine), dist(engine), dist(engine);
+        rays.directions.row(k) = plucker::Vector3<T>(normal(engine), normal(engine), normal(engine)).normalized().transpose();
+    }
+    return rays;
+}
+
+}   // namespace bench
@@ -0,0 +1,204 @@
+/**
+ * @file plucker/aligned_box.h
+ * @brief This file provides ray versus axis-aligned box tests.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <Eigen/Geometry>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+
+namespace plucker
+{
+
+template<typename T>
+using AlignedBox3 = Eigen::AlignedBox<T, 3>;
+
+/**
+ * Batch of axis-aligned boxes, one per row: (min.x, min.y, min.z, max.x, max.y, max.z).
+ */
+template<typename T>
+using AlignedBoxBatch = Eigen::Matrix<T, Eigen::Dynamic, 6>;
+
+/**
+ * Ray classified for box tests.
+ *
+ * Axes along which the ray runs in the positive direction are mirrored,
+ * so that every box test sees a ray with a non-positive direction.
+ * A box is then hit if the ray does not start past it, and if the ray passes
+ * on the inner side of the six silhouette edges of the box. Each of those
+ * sides is the sign of the reciprocal product of the ray with an edge,
+ * which reduces to a 2D cross product for an axis-aligned edge,
+ * so no division is needed.
+ */
+template<typename T>
+class BoxRay
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+
+/* Constructors */
+    BoxRay(const Vector3<T>& origin, const Vector3<T>& direction)
+    {
+        for(auto i = 0; i < 3; i++)
+        {
+            mirrored_[i] = direction(i) > static_cast<T>(0);
+            origin_(i) = mirrored_[i] ? -origin(i) : origin(i);
+            direction_(i) = mirrored_[i] ? -direction(i) : direction(i);
+        }
+    }
+    /**
+     * Creates from a line and a point on it where the ray starts.
+     */
+    template<typename Derived>
+    BoxRay(const PluckerBase<T, Derived>& line, const Vector3<T>& origin)
+        : BoxRay(origin, Vector3<T>(line.l()))
+    {}
+    /**
+     * Creates from distinct homogeneous points, and a ray is directed `from -> to`.
+     */
+    BoxRay(const Vector4<T>& from, const Vector4<T>& to)
+        : BoxRay(Plucker<T>(from, to), Vector3<T>(from.hnormalized()))
+    {}
+
+/* Accessors */
+    /**
+     * Returns true if axis i is mirrored.
+     */
+    bool mirrored(int i) const noexcept { return mirrored_[i]; }
+    const Vector3<T>& origin() const noexcept { return origin_; }
+    const Vector3<T>& direction() const noexcept { return direction_; }
+
+private:
+    Vector3<T> origin_;
+    Vector3<T> direction_;
+    bool mirrored_[3];
+};
+
+namespace detail
+{
+
+template<typename U>
+struct mask_of
+{
+    using type = bool;
+};
+
+template<typename T, int N>
+struct mask_of<Eigen::Array<T, N, 1>>
+{
+    using type = Eigen::Array<bool, N, 1>;
+};
+
+/**
+ * Returns true if a classified ray hits a box, given the box mirrored as the ray.
+ * Works on scalars or element-wise on arrays.
+ */
+template<typename T, typename U>
+typename mask_of<U>::type
+has_intersection(
+    const BoxRay<T>& ray,
+    const U& lo_x, const U& lo_y, const U& lo_z,
+    const U& hi_x, const U& hi_y, const U& hi_z)
+{
+    const auto i = ray.direction().x();
+    const auto j = ray.direction().y();
+    const auto k = ray.direction().z();
+
+    const U xa = lo_x - ray.origin().x();
+    const U ya = lo_y - ray.origin().y();
+    const U za = lo_z - ray.origin().z();
+    const U xb = hi_x - ray.origin().x();
+    const U yb = hi_y - ray.origin().y();
+    const U zb = hi_z - ray.origin().z();
+
+    return (xa <= static_cast<T>(0)) && (ya <= static_cast<T>(0)) && (za <= static_cast<T>(0))
+        && (i * ya - j * xb >= static_cast<T>(0))
+        && (i * yb - j * xa <= static_cast<T>(0))
+        && (i * zb - k * xa <= static_cast<T>(0))
+        && (i * za - k * xb >= static_cast<T>(0))
+        && (j * za - k * yb >= static_cast<T>(0))
+        && (j * zb - k * ya <= static_cast<T>(0));
+}
+
+}   // namespace detail
+
+/**
+ * Returns true if a ray hits a box.
+ */
+template<typename T>
+bool has_intersection(const BoxRay<T>& ray, const AlignedBox3<T>& box)
+{
+    const auto lo = [&](int i) { return ray.mirrored(i) ? -box.max()(i) : box.min()(i); };
+    const auto hi = [&](int i) { return ray.mirrored(i) ? -box.min()(i) : box.max()(i); };
+    return detail::has_intersection(ray, lo(0), lo(1), lo(2), hi(0), hi(1), hi(2));
+}
+
+/**
+ * Tests a ray against `Lanes` boxes starting at row `first`.
+ * Returns a mask whose bit i is set if box `first + i` is hit.
+ */
+template<int Lanes, typename T>
+std::uint32_t has_intersection(const BoxRay<T>& ray, const AlignedBoxBatch<T>& boxes, Eigen::Index first)
+{
+    static_assert(Lanes == 4 || Lanes == 8 || Lanes == 16,
+        "Lanes must be 4, 8 or 16.");
+    assert(first >= 0 && static_cast<std::size_t>(first + Lanes) <= static_cast<std::size_t>(boxes.rows()));
+
+    using Array = Eigen::Array<T, Lanes, 1>;
+
+    // Column c of the boxes is contiguous, e.g. the lanes of it start at `column(c)`.
+    const auto column = [&](int c) { return boxes.data() + c * boxes.rows() + first; };
+    const auto lo = [&](int i) -> Array
+    {
+        return ray.mirrored(i) ? Array(-Eigen::Map<const Array>(column(3 + i)))
+                               : Array(Eigen::Map<const Array>(column(i)));
+    };
+    const auto hi = [&](int i) -> Array
+    {
+        return ray.mirrored(i) ? Array(-Eigen::Map<const Array>(column(i)))
+                               : Array(Eigen::Map<const Array>(column(3 + i)));
+    };
+
+    const Eigen::Array<bool, Lanes, 1> hits = detail::has_intersection(ray, lo(0), lo(1), lo(2), hi(0), hi(1), hi(2));
+
+    std::uint32_t mask = 0;
+    for(unsigned i = 0; i < Lanes; i++)
+        mask |= static_cast<std::uint32_t>(hits(i)) << i;
+    return mask;
+}
+
+/**
+ * Tests a ray against all boxes.
+ * e.g. `res[i]` is 1 if box i is hit.
+ */
+template<typename T>
+void has_intersection(const BoxRay<T>& ray, const AlignedBoxBatch<T>& boxes, std::vector<std::uint8_t>& res)
+{
+    constexpr int lanes = 8;
+
+    const auto rows = boxes.rows();
+    res.resize(static_cast<std::size_t>(rows));
+
+    const auto count = static_cast<std::size_t>(rows);
+    const auto blocked = count - count % lanes;
+    for(std::size_t first = 0; first < blocked; first += lanes)
+    {
+        const auto mask = has_intersection<lanes>(ray, boxes, static_cast<Eigen::Index>(first));
+        for(std::size_t i = 0; i < lanes; i++)
+            res[first + i] = static_cast<std::uint8_t>((mask >> i) & 1u);
+    }
+    for(auto i = blocked; i < count; i++)
+    {
+        const auto row = static_cast<Eigen::Index>(i);
+        const AlignedBox3<T> box(boxes.row(row).template head<3>().transpose(), boxes.row(row).template tail<3>().transpose());
+        res[i] = has_intersection(ray, box) ? 1 : 0;
+    }
+}
+
+}   // namespace plucker
@@ -0,0 +1,513 @@
+/**
+ * @file plucker/camera.h
+ * @brief This file provides pinhole camera rays generated per image tile.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "edge_mesh.h"
+#include "ray_hit.h"
+#include "uniform_grid.h"
+#include "parallel.h"
+
+namespace plucker
+{
+
+template<typename T>
+using Vector2 = Eigen::Matrix<T, 2, 1>;
+
+/**
+ * Pinhole camera looking down its z axis, with x to the right and y down the image.
+ *
+ * Image coordinates (u, v) put the top left corner of the image at (0, 0),
+ * so pixel (x, y) covers [x, x + 1) x [y, y + 1) and its center is (x + 1/2, y + 1/2).
+ * The principal point (cx, cy) is in image coordinates, and a point (u, v) sees
+ * along the direction `R ((u - cx) / fx, (v - cy) / fy, 1)`.
+ *
+ * The ray through the center of pixel (x, y) has the direction
+ * `R ((x + 1/2 - cx) / fx, (y + 1/2 - cy) / fy, 1)`, so both its direction l
+ * and its moment m = c x l are linear in x and y. A tile of rays is generated
+ * from those linear forms without constructing each line from two points,
+ * and the ray parameter t of a hit is its depth along the optical axis.
+ */
+template<typename T>
+class PinholeCamera
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using Matrix3 = Eigen::Matrix<T, 3, 3>;
+
+/* Constructors */
+    PinholeCamera()
+    {}
+
+    /**
+     * Creates from the position, the rotation from camera to world coordinates,
+     * the focal lengths and the principal point in pixels, and the image size.
+     */
+    PinholeCamera(
+        const Vector3<T>& position,
+        const Matrix3& rotation,
+        T fx, T fy, T cx, T cy,
+        int width, int height);
+
+/* Accessors */
+    const Vector3<T>& position() const noexcept { return position_; }
+    const Matrix3& rotation() const noexcept { return rotation_; }
+    T fx() const noexcept { return fx_; }
+    T fy() const noexcept { return fy_; }
+    T cx() const noexcept { return cx_; }
+    T cy() const noexcept { return cy_; }
+    int width() const noexcept { return width_; }
+    int height() const noexcept { return height_; }
+    std::size_t pixel_count() const noexcept { return static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_); }
+
+/* Queries */
+    /**
+     * Returns the direction of the ray through the center of pixel (x, y).
+     */
+    Vector3<T> direction(int x, int y) const
+    {
+        return l0_ + static_cast<T>(x) * lx_ + static_cast<T>(y) * ly_;
+    }
+    /**
+     * Returns the ray through the center of pixel (x, y).
+     */
+    Plucker<T> ray(int x, int y) const
+    {
+        return Plucker<T>(direction(x, y), m0_ + static_cast<T>(x) * mx_ + static_cast<T>(y) * my_);
+    }
+    /**
+     * Returns the direction of the ray through a point in image coordinates.
+     */
+    Vector3<T> direction(const Vector2<T>& point) const
+    {
+        return rotation_ * Vector3<T>((point.x() - cx_) / fx_, (point.y() - cy_) / fy_, static_cast<T>(1));
+    }
+    /**
+     * Returns the normalized ray through a point in image coordinates, directed away from the camera.
+     */
+    Plucker<T> back_project(const Vector2<T>& point) const
+    {
+        const Vector3<T> l = direction(point).normalized();
+        return Plucker<T>(l, position_.cross(l));
+    }
+    /**
+     * Computes the rays through the pixels [x0, x0 + w) x [y0, y0 + h), one per row,
+     * e.g. row `i + w j` is the ray through pixel (x0 + i, y0 + j).
+     */
+    void tile_rays(int x0, int y0, int w, int h, PluckerBatch<T>& res) const;
+    /**
+     * Returns the matrix K such that the product of a line with the ray
+     * through the center of pixel (x, y) is `line.coord().transpose() K (1, x, y)`.
+     * e.g. `edges * K` gives the product of each edge as an affine function of the pixel.
+     */
+    Eigen::Matrix<T, 6, 3> product_coefficients() const
+    {
+        Eigen::Matrix<T, 6, 3> res;
+        res << m0_, mx_, my_,
+               l0_, lx_, ly_;
+        return res;
+    }
+
+private:
+    Vector3<T> position_;
+    Matrix3 rotation_;
+    T fx_ = static_cast<T>(1);
+    T fy_ = static_cast<T>(1);
+    T cx_ = static_cast<T>(0);
+    T cy_ = static_cast<T>(0);
+    int width_ = 0;
+    int height_ = 0;
+    // Directions and moments at pixel (0, 0), and their steps along x and y.
+    Vector3<T> l0_, lx_, ly_;
+    Vector3<T> m0_, mx_, my_;
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/* Constructors */
+
+template<typename T>
+PinholeCamera<T>::PinholeCamera(
+    const Vector3<T>& position,
+    const Matrix3& rotation,
+    T fx, T fy, T cx, T cy,
+    int width, int height)
+    : position_(position),
+      rotation_(rotation),
+      fx_(fx),
+      fy_(fy),
+      cx_(cx),
+      cy_(cy),
+      width_(width),
+      height_(height)
+{
+    const auto half = static_cast<T>(0.5);
+    l0_ = rotation * Vector3<T>((half - cx) / fx, (half - cy) / fy, static_cast<T>(1));
+    lx_ = rotation.col(0) / fx;
+    ly_ = rotation.col(1) / fy;
+    m0_ = position.cross(l0_);
+    mx_ = position.cross(lx_);
+    my_ = position.cross(ly_);
+}
+
+/* Queries */
+
+template<typename T>
+void
+PinholeCamera<T>::tile_rays(int x0, int y0, int w, int h, PluckerBatch<T>& res) const
+{
+    using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+    const auto count = static_cast<Eigen::Index>(w) * h;
+    Array xs(count);
+    Array ys(count);
+    for(auto j = 0; j < h; j++)
+    {
+        xs.segment(static_cast<Eigen::Index>(j) * w, w) = Array::LinSpaced(w, static_cast<T>(x0), static_cast<T>(x0 + w - 1));
+        ys.segment(static_cast<Eigen::Index>(j) * w, w).setConstant(static_cast<T>(y0 + j));
+    }
+
+    res.resize(count, 6);
+    for(Eigen::Index i = 0; i < 3; i++)
+    {
+        res.col(i) = (l0_(i) + xs * lx_(i) + ys * ly_(i)).matrix();
+        res.col(i + 3) = (m0_(i) + xs * mx_(i) + ys * my_(i)).matrix();
+    }
+}
+
+namespace detail
+{
+
+/**
+ * Returns the range of pixels [x0, x1) x [y0, y1) covered by a triangle of given vertices,
+ * or the whole image if a vertex is not in front of the camera.
+ */
+template<typename T>
+Eigen::Vector4i
+pixel_bounds(const PinholeCamera<T>& camera, const Vector3<T>& p0, const Vector3<T>& p1, const Vector3<T>& p2)
+{
+    Eigen::Matrix<T, 3, 3> q;
+    q << p0 - camera.position(), p1 - camera.position(), p2 - camera.position();
+    q = camera.rotation().transpose() * q;
+
+    if((q.row(2).array() <= static_cast<T>(0)).any())
+        return Eigen::Vector4i(0, 0, camera.width(), camera.height());
+
+    const auto half = static_cast<T>(0.5);
+    const Eigen::Array<T, 1, 3> xs = camera.fx() * q.row(0).array() / q.row(2).array() + (camera.cx() - half);
+    const Eigen::Array<T, 1, 3> ys = camera.fy() * q.row(1).array() / q.row(2).array() + (camera.cy() - half);
+
+    // Clamp in floating point first, as far away pixels may not fit int.
+    const auto clamp = [](T value, int size)
+    {
+        return static_cast<int>(std::min(std::max(value, static_cast<T>(0)), static_cast<T>(size)));
+    };
+    return Eigen::Vector4i(
+        clamp(std::floor(xs.minCoeff()), camera.width()),
+        clamp(std::floor(ys.minCoeff()), camera.height()),
+        clamp(std::floor(xs.maxCoeff()) + 1, camera.width()),
+        clamp(std::floor(ys.maxCoeff()) + 1, camera.height()));
+}
+
+/**
+ * Triangles binned into the square tiles of an image, in compressed rows.
+ * e.g. The triangles of tile k are `triangles[offsets[k], offsets[k + 1])`, in order.
+ */
+template<typename Index>
+struct TileBins
+{
+    std::vector<std::size_t> offsets;
+    std::vector<Index> triangles;
+    // Entries of each tile counted by each thread, then where each thread writes them.
+    std::vector<Index> cursors;
+};
+
+/**
+ * Bins the triangles of a mesh into the square tiles of an image they may cover,
+ * skipping those entirely out of depth [t_min, t_max].
+ * e.g. `bounds.row(t)` is the range of pixels of triangle t.
+ *
+ * Each thread counts the entries of its triangles per tile, the counts are summed
+ * into the offsets of the tiles, and each thread then writes its entries in place.
+ */
+template<typename T, typename Index>
+void bin_triangles(
+    const EdgeMesh<T>& mesh,
+    const PinholeCamera<T>& camera,
+    int tile_size,
+    T t_min,
+    T t_max,
+    unsigned num_threads,
+    Eigen::Matrix<int, Eigen::Dynamic, 4, Eigen::RowMajor>& bounds,
+    TileBins<Index>& bins)
+{
+    const auto columns = (camera.width() + tile_size - 1) / tile_size;
+    const auto rows = (camera.height() + tile_size - 1) / tile_size;
+    const auto tile_count = static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows);
+    const auto triangle_count = mesh.triangle_count();
+    bounds.resize(static_cast<Eigen::Index>(triangle_count), 4);
+
+    const auto threads = thread_count(num_threads, triangle_count);
+    bins.cursors.assign(threads * tile_count, 0);
+
+    const Vector3<T> axis = camera.rotation().col(2);
+    const auto& triangles = mesh.triangles();
+
+    parallel_for(triangle_count, threads,
+        [&](std::size_t first, std::size_t last, unsigned thread_index)
+        {
+            const auto counts = bins.cursors.data() + thread_index * tile_count;
+            for(auto t = first; t < last; t++)
+            {
+                const auto row = static_cast<Eigen::Index>(t);
+                const Vector3<T> p0 = mesh.vertex(triangles(row, 0));
+                const Vector3<T> p1 = mesh.vertex(triangles(row, 1));
+                const Vector3<T> p2 = mesh.vertex(triangles(row, 2));
+                const Vector3<T> z((p0 - camera.position()).dot(axis), (p1 - camera.position()).dot(axis), (p2 - camera.position()).dot(axis));
+                if(z.maxCoeff() < t_min || z.minCoeff() > t_max)
+                {
+                    bounds.row(row).setZero();
+                    continue;
+                }
+
+                bounds.row(row) = pixel_bounds(camera, p0, p1, p2).transpose();
+                if(bounds(row, 0) >= bounds(row, 2) || bounds(row, 1) >= bounds(row, 3))
+                    continue;
+
+                for(auto ty = bounds(row, 1) / tile_size; ty <= (bounds(row, 3) - 1) / tile_size; ty++)
+                {
+                    for(auto tx = bounds(row, 0) / tile_size; tx <= (bounds(row, 2) - 1) / tile_size; tx++)
+                        counts[static_cast<std::size_t>(ty * columns + tx)]++;
+                }
+            }
+        });
+
+    // Within a tile, the entries of lower threads, i.e. lower triangles, come first.
+    bins.offsets.resize(tile_count + 1);
+    std::size_t total = 0;
+    for(std::size_t tile = 0; tile < tile_count; tile++)
+    {
+        bins.offsets[tile] = total;
+        Index offset = 0;
+        for(std::size_t k = 0; k < threads; k++)
+        {
+            auto& cursor = bins.cursors[k * tile_count + tile];
+            const auto count = cursor;
+            cursor = offset;
+            offset = static_cast<Index>(offset + count);
+        }
+        total += offset;
+    }
+    bins.offsets[tile_count] = total;
+    bins.triangles.resize(total);
+
+    parallel_for(triangle_count, threads,
+        [&](std::size_t first, std::size_t last, unsigned thread_index)
+        {
+            const auto cursors = bins.cursors.data() + thread_index * tile_count;
+            for(auto t = first; t < last; t++)
+            {
+                const auto row = static_cast<Eigen::Index>(t);
+                if(bounds(row, 0) >= bounds(row, 2) || bounds(row, 1) >= bounds(row, 3))
+                    continue;
+
+                for(auto ty = bounds(row, 1) / tile_size; ty <= (bounds(row, 3) - 1) / tile_size; ty++)
+                {
+                    for(auto tx = bounds(row, 0) / tile_size; tx <= (bounds(row, 2) - 1) / tile_size; tx++)
+                    {
+                        const auto tile = static_cast<std::size_t>(ty * columns + tx);
+                        bins.triangles[bins.offsets[tile] + cursors[tile]++] = static_cast<Index>(t);
+                    }
+                }
+            }
+        });
+}
+
+/**
+ * Calls `func(x0, y0, w, h, thread_index)` for the tiles of an image on threads.
+ */
+template<typename T, typename Function>
+void for_each_tile(const PinholeCamera<T>& camera, int tile_size, unsigned num_threads, Function func)
+{
+    const auto columns = (camera.width() + tile_size - 1) / tile_size;
+    const auto rows = (camera.height() + tile_size - 1) / tile_size;
+    const auto count = static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows);
+
+    parallel_for(count, num_threads,
+        [&](std::size_t first, std::size_t last, unsigned thread_index)
+        {
+            for(auto k = first; k < last; k++)
+            {
+                const auto x0 = static_cast<int>(k % static_cast<std::size_t>(columns)) * tile_size;
+                const auto y0 = static_cast<int>(k / static_cast<std::size_t>(columns)) * tile_size;
+                func(x0, y0, std::min(tile_size, camera.width() - x0), std::min(tile_size, camera.height() - y0), thread_index);
+            }
+        });
+}
+
+}   // namespace detail
+
+/**
+ * Finds the closest hit of the ray through each pixel, for t in [t_min, t_max].
+ * e.g. `res[x + width y]` is the hit of pixel (x, y), and its t is infinity if the ray misses.
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ *
+ * Triangles are binned into the tiles they may cover, as in `rasterize`, and the rays
+ * of a tile are generated in place and tested against the triangles of its bin only.
+ */
+template<typename T>
+void find_closest_hits(
+    const EdgeMesh<T>& mesh,
+    const PinholeCamera<T>& camera,
+    T t_min,
+    T t_max,
+    std::vector<RayHit<T>>& res,
+    unsigned num_threads = 0)
+{
+    using index_type = typename EdgeMesh<T>::index_type;
+    using Products = Eigen::Matrix<T, Eigen::Dynamic, 3>;
+
+    constexpr auto tile_size = 8;
+    constexpr auto tile_pixels = static_cast<std::size_t>(tile_size * tile_size);
+
+    res.resize(camera.pixel_count());
+
+    const auto columns = (camera.width() + tile_size - 1) / tile_size;
+    const auto rows = (camera.height() + tile_size - 1) / tile_size;
+    const auto tile_count = static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows);
+
+    Eigen::Matrix<int, Eigen::Dynamic, 4, Eigen::RowMajor> bounds;
+    detail::TileBins<index_type> bins;
+    detail::bin_triangles(mesh, camera, tile_size, t_min, t_max, num_threads, bounds, bins);
+
+    const auto& edges = mesh.edges();
+    const auto threads = detail::thread_count(num_threads, tile_count);
+    std::vector<PluckerBatch<T>> tiles(threads);
+    std::vector<Products> products(threads);
+
+    detail::for_each_tile(camera, tile_size, threads,
+        [&](int x0, int y0, int w, int h, unsigned thread_index)
+        {
+            auto& tile = tiles[thread_index];
+            auto& p = products[thread_index];
+            camera.tile_rays(x0, y0, w, h, tile);
+            p.resize(tile.rows(), 3);
+
+            RayHit<T> closest[tile_pixels];
+            bool found[tile_pixels] = {};
+            for(Eigen::Index i = 0; i < tile.rows(); i++)
+                closest[i].t = t_max;
+
+            RayHit<T> hit;
+            const auto bin = static_cast<std::size_t>((y0 / tile_size) * columns + x0 / tile_size);
+            for(auto k = bins.offsets[bin]; k < bins.offsets[bin + 1]; k++)
+            {
+                const auto t = bins.triangles[k];
+
+                // The products of the rays with the edges of the triangle, oriented counterclockwise.
+                for(auto j = 0; j < 3; j++)
+                {
+                    const auto e = static_cast<Eigen::Index>(mesh.triangle_edges()(static_cast<Eigen::Index>(t), j));
+                    p.col(j).noalias() = tile.template leftCols<3>() * edges.row(e).template tail<3>().transpose();
+                    p.col(j).noalias() += tile.template rightCols<3>() * edges.row(e).template head<3>().transpose();
+                    if((mesh.orientations()[t] >> j) & 1u)
+                        p.col(j) = -p.col(j);
+                }
+
+                for(Eigen::Index i = 0; i < tile.rows(); i++)
+                {
+                    const Vector3<T> direction = tile.row(i).template head<3>().transpose();
+                    if(!detail::hit_from_products(mesh, static_cast<std::size_t>(t), p(i, 0), p(i, 1), p(i, 2), camera.position(), direction, hit))
+                        continue;
+
+                    if(hit.t >= t_min && hit.t <= closest[i].t)
+                    {
+                        closest[i] = hit;
+                        found[i] = true;
+                    }
+                }
+            }
+
+            for(Eigen::Index i = 0; i < tile.rows(); i++)
+            {
+                const auto x = x0 + static_cast<int>(i % w);
+                const auto y = y0 + static_cast<int>(i / w);
+                auto& pixel = res[static_cast<std::size_t>(x) + static_cast<std::size_t>(camera.width()) * static_cast<std::size_t>(y)];
+                if(found[i])
+                {
+                    pixel = closest[i];
+                }
+                else
+                {
+                    pixel = RayHit<T>();
+                    pixel.t = std::numeric_limits<T>::infinity();
+                }
+            }
+        });
+}
+
+/**
+ * Finds the closest hit of the ray through each pixel, for t in [t_min, t_max].
+ * e.g. `res[x + width y]` is the hit of pixel (x, y), and its t is infinity if the ray misses.
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ *
+ * Tiles keep the rays of one thread coherent, walking mostly the same cells,
+ * and the rays of a tile are generated at once from the linear forms of the camera.
+ */
+template<typename T>
+void find_closest_hits(
+    const UniformGrid<T>& grid,
+    const PinholeCamera<T>& camera,
+    T t_min,
+    T t_max,
+    std::vector<RayHit<T>>& res,
+    unsigned num_threads = 0)
+{
+    constexpr auto tile_size = 8;
+
+    res.resize(camera.pixel_count());
+
+    const auto threads = detail::thread_count(num_threads, camera.pixel_count());
+    std::vector<PluckerBatch<T>> tiles(threads);
+    std::vector<typename UniformGrid<T>::Mailbox> mailboxes(threads);
+
+    detail::for_each_tile(camera, tile_size, threads,
+        [&](int x0, int y0, int w, int h, unsigned thread_index)
+        {
+            auto& tile = tiles[thread_index];
+            camera.tile_rays(x0, y0, w, h, tile);
+
+            for(Eigen::Index i = 0; i < tile.rows(); i++)
+            {
+                const Plucker<T> ray(Vector6<T>(tile.row(i).transpose()));
+                const auto hit = grid.find_closest_hit(ray, camera.position(), Vector3<T>(ray.l()), t_min, t_max, mailboxes[thread_index]);
+
+                const auto x = x0 + static_cast<int>(i % w);
+                const auto y = y0 + static_cast<int>(i / w);
+                auto& pixel = res[static_cast<std::size_t>(x) + static_cast<std::size_t>(camera.width()) * static_cast<std::size_t>(y)];
+                if(std::get<0>(hit))
+                {
+                    pixel = std::get<1>(hit);
+                }
+                else
+                {
+                    pixel = RayHit<T>();
+                    pixel.t = std::numeric_limits<T>::infinity();
+                }
+            }
+        });
+}
+
+}   // namespace plucker
@@ -0,0 +1,309 @@
+/**
+ * @file plucker/clipping.h
+ * @brief This file provides clipping of polygons and segments by planes.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "plucker_find.h"
+#include "parallel.h"
+#include "segment.h"
+
+namespace plucker
+{
+
+/*
+ * Here, a plane keeps the points x where `plane.coord().dot(x) <= 0`,
+ * i.e. its normal points away from the kept side,
+ * and points within the tolerance of the plane are kept as well.
+ */
+
+namespace detail
+{
+
+/**
+ * Returns -1, 0 or 1 as a point is inside, on or outside a plane.
+ */
+template<typename T, typename Derived>
+int side_of(const PlaneBase<T, Derived>& plane, const Vector4<T>& point, T tolerance)
+{
+    if(contains(plane, point, tolerance))
+        return 0;
+    return (plane.coord().dot(point) < static_cast<T>(0)) ? -1 : 1;
+}
+
+}   // namespace detail
+
+/**
+ * Returns a convex polygon clipped by a plane, as vertices one per row.
+ * The result has no rows if nothing is kept.
+ */
+template<typename T, typename Derived>
+Vector3Batch<T> clip(const Vector3Batch<T>& polygon, const PlaneBase<T, Derived>& plane, T tolerance)
+{
+    const auto n = polygon.rows();
+
+    std::vector<Vector3<T>> kept;
+    kept.reserve(static_cast<std::size_t>(n + 1));
+    for(Eigen::Index i = 0; i < n; i++)
+    {
+        const Vector4<T> a = polygon.row(i).transpose().homogeneous();
+        const Vector4<T> b = polygon.row((i + 1) % n).transpose().homogeneous();
+        const auto side_a = detail::side_of(plane, a, tolerance);
+        const auto side_b = detail::side_of(plane, b, tolerance);
+
+        if(side_a <= 0)
+            kept.push_back(a.template head<3>());
+
+        if(side_a * side_b < 0)
+        {
+            bool found;
+            Vector4<T> point;
+            std::tie(found, point) = find_intersection(Plucker<T>(a, b), plane, tolerance);
+            if(found)
+                kept.push_back(point.hnormalized());
+        }
+    }
+
+    Vector3Batch<T> res(static_cast<Eigen::Index>(kept.size()), 3);
+    for(std::size_t i = 0; i < kept.size(); i++)
+        res.row(static_cast<Eigen::Index>(i)) = kept[i].transpose();
+    return res;
+}
+
+/**
+ * Returns a convex polygon clipped by planes, as vertices one per row.
+ */
+template<typename T, typename InputIt>
+Vector3Batch<T> clip(const Vector3Batch<T>& polygon, InputIt first, InputIt last, T tolerance)
+{
+    Vector3Batch<T> res = polygon;
+    for(; first != last && res.rows() > 0; ++first)
+        res = clip(res, *first, tolerance);
+    return res;
+}
+
+/**
+ * Returns a segment clipped by a plane.
+ */
+template<typename T, typename Derived>
+std::tuple<bool, Segment<T>>
+clip(const Segment<T>& segment, const PlaneBase<T, Derived>& plane, T tolerance)
+{
+    const Vector4<T> a = segment.p0().homogeneous();
+    const Vector4<T> b = segment.p1().homogeneous();
+    const auto side_a = detail::side_of(plane, a, tolerance);
+    const auto side_b = detail::side_of(plane, b, tolerance);
+
+    if(side_a <= 0 && side_b <= 0)
+        return std::make_tuple(true, segment);
+    if(side_a > 0 && side_b > 0)
+        return std::make_tuple(false, Segment<T>());
+
+    // Down to the point on the plane.
+    if(side_a == 0)
+        return std::make_tuple(true, Segment<T>(segment.p0(), segment.p0()));
+    if(side_b == 0)
+        return std::make_tuple(true, Segment<T>(segment.p1(), segment.p1()));
+
+    bool found;
+    Vector4<T> point;
+    std::tie(found, point) = find_intersection(Plucker<T>(a, b), plane, tolerance);
+    if(!found)
+        return std::make_tuple(false, Segment<T>());
+
+    const Vector3<T> p = point.hnormalized();
+    return std::make_tuple(true, (side_a < 0) ? Segment<T>(segment.p0(), p) : Segment<T>(p, segment.p1()));
+}
+
+/**
+ * Returns a segment clipped by planes.
+ */
+template<typename T, typename InputIt>
+std::tuple<bool, Segment<T>>
+clip(const Segment<T>& segment, InputIt first, InputIt last, T tolerance)
+{
+    auto res = std::make_tuple(true, segment);
+    for(; first != last && std::get<0>(res); ++first)
+        res = clip(std::get<1>(res), *first, tolerance);
+    return res;
+}
+
+namespace detail
+{
+
+/**
+ * Clips a convex polygon by one plane, given the signed distances of its vertices.
+ *
+ * The intersection of the edge `a -> b` with the plane p, `(n x m - d l, n . l)`,
+ * reduces to `((p . b) a - (p . a) b) / (p . b - p . a)` with the edge line (l, m) = (b - a, a x b).
+ */
+template<typename T>
+void clip_polygon(
+    const Vector3Batch<T>& polygon,
+    const VectorX<T>& distances,
+    T tolerance,
+    Vector3Batch<T>& res)
+{
+    const auto n = polygon.rows();
+    res.resize(n + 1, 3);
+
+    Eigen::Index count = 0;
+    for(Eigen::Index i = 0; i < n; i++)
+    {
+        const auto j = (i + 1) % n;
+        const auto da = distances(i);
+        const auto db = distances(j);
+        if(da <= tolerance)
+            res.row(count++) = polygon.row(i);
+        if((da < -tolerance && db > tolerance) || (da > tolerance && db < -tolerance))
+            res.row(count++) = (db * polygon.row(i) - da * polygon.row(j)) / (db - da);
+    }
+    res.conservativeResize(count, 3);
+}
+
+}   // namespace detail
+
+/**
+ * Clips convex polygons by all planes, one per row of `planes`.
+ * e.g. Polygon `k` consists of the vertices in rows [offsets[k], offsets[k + 1]),
+ * and so does clipped polygon `k` in `res_vertices` and `res_offsets`.
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ *
+ * The distances of all vertices to all planes are one matrix product,
+ * which accepts polygons entirely inside and rejects those entirely outside one plane
+ * before any per-edge work.
+ */
+template<typename T>
+void clip(
+    const Vector3Batch<T>& vertices,
+    const std::vector<std::size_t>& offsets,
+    const Vector4Batch<T>& planes,
+    T tolerance,
+    Vector3Batch<T>& res_vertices,
+    std::vector<std::size_t>& res_offsets,
+    unsigned num_threads = 0)
+{
+    assert(!offsets.empty() && offsets.back() == static_cast<std::size_t>(vertices.rows()));
+
+    using Distances = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+    const Distances distances = (vertices * planes.template leftCols<3>().transpose()).rowwise()
+        + planes.col(3).transpose();
+
+    const auto count = offsets.size() - 1;
+    const auto threads = detail::thread_count(num_threads, count);
+    std::vector<std::vector<T>> partial_coords(threads);
+    std::vector<std::vector<std::size_t>> partial_sizes(threads);
+
+    detail::parallel_for(count, threads,
+        [&](std::size_t first, std::size_t last, unsigned thread_index)
+        {
+            auto& coords = partial_coords[thread_index];
+            auto& sizes = partial_sizes[thread_index];
+            sizes.reserve(last - first);
+
+            const auto append = [&coords](const Vector3Batch<T>& polygon)
+            {
+                for(Eigen::Index i = 0; i < polygon.rows(); i++)
+                    for(Eigen::Index j = 0; j < 3; j++)
+                        coords.push_back(polygon(i, j));
+            };
+
+            Vector3Batch<T> polygon;
+            Vector3Batch<T> clipped;
+            VectorX<T> d;
+            for(auto k = first; k < last; k++)
+            {
+                const auto row = static_cast<Eigen::Index>(offsets[k]);
+                const auto n = static_cast<Eigen::Index>(offsets[k + 1] - offsets[k]);
+                const auto block = distances.middleRows(row, n);
+
+                polygon = vertices.middleRows(row, n);
+                if((block.array() > tolerance).colwise().all().any())
+                {
+                    polygon.resize(0, 3);
+                }
+                else if(!(block.array() <= tolerance).all())
+                {
+                    for(Eigen::Index p = 0; p < planes.rows() && polygon.rows() > 0; p++)
+                    {
+                        if(p == 0)
+                            d = block.col(0);
+                        else
+                            d = polygon * planes.row(p).template head<3>().transpose() + VectorX<T>::Constant(polygon.rows(), planes(p, 3));
+                        detail::clip_polygon(polygon, d, tolerance, clipped);
+                        polygon.swap(clipped);
+                    }
+                }
+                append(polygon);
+                sizes.push_back(static_cast<std::size_t>(polygon.rows()));
+            }
+        });
+
+    detail::join_rows(partial_coords, partial_sizes, res_vertices, res_offsets);
+}
+
+/**
+ * Clips segments by all planes, one per row of `planes`.
+ * e.g. `kept[k]` is 1 if anything of segment k is kept, and then `res.row(k)` is the clipped segment.
+ *
+ * Each segment keeps a parameter interval [s0, s1], narrowed plane by plane
+ * on all segments at once. Endpoints are inside, on or outside each plane
+ * as in the clip of one segment, e.g. a segment from a point on the plane
+ * to one outside is kept down to the point on the plane.
+ */
+template<typename T>
+void clip(
+    const SegmentBatch<T>& segments,
+    const Vector4Batch<T>& planes,
+    T tolerance,
+    SegmentBatch<T>& res,
+    std::vector<std::uint8_t>& kept)
+{
+    using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+    const auto rows = segments.rows();
+    const auto a = segments.template leftCols<3>();
+    const auto b = segments.template rightCols<3>();
+
+    Array s0 = Array::Zero(rows);
+    Array s1 = Array::Ones(rows);
+    Eigen::Array<bool, Eigen::Dynamic, 1> alive = Eigen::Array<bool, Eigen::Dynamic, 1>::Constant(rows, true);
+    for(Eigen::Index p = 0; p < planes.rows(); p++)
+    {
+        const Vector3<T> n = planes.row(p).template head<3>().transpose();
+        const Array da = (a * n).array() + planes(p, 3);
+        const Array db = (b * n).array() + planes(p, 3);
+        const auto out_a = da > tolerance;
+        const auto out_b = db > tolerance;
+        const auto in_a = da < -tolerance;
+        const auto in_b = db < -tolerance;
+
+        // The parameter of the plane only where the endpoints are strictly on opposite sides,
+        // and otherwise the endpoint on the plane.
+        const auto crossing = (out_a && in_b) || (in_a && out_b);
+        const Array s = da / crossing.select(da - db, Array::Ones(rows));
+
+        alive = alive && !(out_a && out_b);
+        s0 = out_a.select(s0.max(in_b.select(s, Array::Ones(rows))), s0);
+        s1 = out_b.select(s1.min(in_a.select(s, Array::Zero(rows))), s1);
+    }
+    alive = alive && (s0 <= s1);
+
+    res.resize(rows, 6);
+    res.template leftCols<3>() = a + (s0.matrix().asDiagonal() * (b - a));
+    res.template rightCols<3>() = a + (s1.matrix().asDiagonal() * (b - a));
+
+    kept.resize(static_cast<std::size_t>(rows));
+    for(Eigen::Index i = 0; i < rows; i++)
+        kept[static_cast<std::size_t>(i)] = alive(i) ? 1 : 0;
+}
+
+}   // namespace plucker
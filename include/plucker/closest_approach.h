@@ -0,0 +1,177 @@
+/**
+ * @file plucker/closest_approach.h
+ * @brief This file provides parametric closest approach queries of lines.
+ *
+ * A point of a line is given by its parameter t as `point_on_line(line, t)`,
+ * i.e. `(l x m + t l) / |l|^2`, so t is the arc length from the point closest
+ * to the origin when the line is normalized.
+ * The queries return only parameters and distances, and points are made on request.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <tuple>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "plucker_common.h"
+#include "plucker_query.h"
+
+namespace plucker
+{
+
+/**
+ * Closest approach of two lines, at `point_on_line(line1, t1)` and `point_on_line(line2, t2)`.
+ */
+template<typename T>
+struct ClosestApproach
+{
+    T t1;
+    T t2;
+    T squared_distance;
+
+    /**
+     * Returns the point on the first line.
+     */
+    template<typename Derived>
+    Vector4<T> point1(const PluckerBase<T, Derived>& line1) const { return point_on_line(line1, t1); }
+    /**
+     * Returns the point on the second line.
+     */
+    template<typename Derived>
+    Vector4<T> point2(const PluckerBase<T, Derived>& line2) const { return point_on_line(line2, t2); }
+};
+
+/**
+ * Returns the parameters of the points on two skew lines closest to one another,
+ * and their squared distance.
+ * Here, two lines intersect if the squared distance is almost zero.
+ */
+template<typename T, typename Derived1, typename Derived2>
+std::tuple<bool, ClosestApproach<T>>
+find_closest_approach(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
+{
+    const Vector3<T> n = p1.l().cross(p2.l());
+    if(detail::almost_zero(n.norm(), tolerance))
+        return std::make_tuple(false, ClosestApproach<T>());
+
+    const auto w = n.squaredNorm();
+    const auto l12 = p1.l().dot(p2.l());
+    const auto m1n = p1.m().dot(n);
+    const auto m2n = p2.m().dot(n);
+    const auto product = p1 * p2;
+
+    ClosestApproach<T> res;
+    res.t1 = (m2n * p1.l().squaredNorm() - l12 * m1n) / w;
+    res.t2 = (l12 * m2n - m1n * p2.l().squaredNorm()) / w;
+    res.squared_distance = product * product / w;
+    return std::make_tuple(true, res);
+}
+
+/**
+ * Returns the parameter of the intersection of a line and a plane.
+ */
+template<typename T, typename Derived1, typename Derived2>
+std::tuple<bool, T>
+find_intersection_parameter(const PluckerBase<T, Derived1>& line, const PlaneBase<T, Derived2>& plane, T tolerance)
+{
+    const Vector3<T> n = plane.normal();
+    if(detail::are_perpendicular(line.l().eval(), n, tolerance))
+        return std::make_tuple(false, static_cast<T>(0));
+
+    // l . (n x m - d l) / (l . n), from the intersection point.
+    return std::make_tuple(true, (line.l().dot(n.cross(line.m())) - plane.d() * line.l().squaredNorm()) / line.l().dot(n));
+}
+
+/**
+ * Computes the closest approach of a line to each of lines, without making any point.
+ * e.g. `t1(k)` and `t2(k)` are the parameters on `line` and on line k.
+ * e.g. `t1(k)` and `t2(k)` are NaN if line k is parallel to `line`,
+ * and `squared_distances(k)` is still their squared distance.
+ */
+template<typename T, typename Derived>
+void find_closest_approaches(
+    const PluckerBase<T, Derived>& line,
+    const PluckerBatch<T>& lines,
+    T tolerance,
+    VectorXRef<T> t1,
+    VectorXRef<T> t2,
+    VectorXRef<T> squared_distances)
+{
+    constexpr Eigen::Index block = 64;
+    using Array = Eigen::Array<T, Eigen::Dynamic, 1, Eigen::ColMajor, block, 1>;
+
+    assert(lines.rows() == t1.rows());
+    assert(lines.rows() == t2.rows());
+    assert(lines.rows() == squared_distances.rows());
+
+    const Vector3<T> l = line.l();
+    const Vector3<T> m = line.m();
+    const auto ll = l.squaredNorm();
+    const auto tolerance2 = tolerance * tolerance;
+    const auto nan = std::numeric_limits<T>::quiet_NaN();
+
+    // Parallel lines are apart by the moment of the other line about the point of `line` closest to the origin.
+    const Vector3<T> p = l.cross(m) / ll;
+
+    // One pass over blocks of rows, whose terms stay on the stack, storing only the results.
+    const auto rows = lines.rows();
+    for(Eigen::Index first = 0; first < rows; first += block)
+    {
+        const auto count = std::min(block, rows - first);
+        const auto lines_block = lines.middleRows(first, count);
+        const auto lx = lines_block.col(0).array();
+        const auto ly = lines_block.col(1).array();
+        const auto lz = lines_block.col(2).array();
+        const auto mx = lines_block.col(3).array();
+        const auto my = lines_block.col(4).array();
+        const auto mz = lines_block.col(5).array();
+
+        // With n = l x l2 per line.
+        const Array nx = l.y() * lz - l.z() * ly;
+        const Array ny = l.z() * lx - l.x() * lz;
+        const Array nz = l.x() * ly - l.y() * lx;
+        const Array w = nx.square() + ny.square() + nz.square();
+        const Array l12 = l.x() * lx + l.y() * ly + l.z() * lz;
+        const Array l22 = lx.square() + ly.square() + lz.square();
+        const Array m1n = m.x() * nx + m.y() * ny + m.z() * nz;
+        const Array m2n = mx * nx + my * ny + mz * nz;
+        const auto parallel = w <= tolerance2;
+
+        t1.segment(first, count).array() = parallel.select(nan, (m2n * ll - l12 * m1n) / w);
+        t2.segment(first, count).array() = parallel.select(nan, (l12 * m2n - m1n * l22) / w);
+        squared_distances.segment(first, count).array() = parallel.select(
+            ((mx + ly * p.z() - lz * p.y()).square() + (my + lz * p.x() - lx * p.z()).square() + (mz + lx * p.y() - ly * p.x()).square()) / l22,
+            (m.x() * lx + m.y() * ly + m.z() * lz + l.x() * mx + l.y() * my + l.z() * mz).square() / w);
+    }
+}
+
+/**
+ * Computes the parameters of the intersections of lines with a plane, without making any point.
+ * e.g. `res(k)` is NaN if line k is parallel to the plane.
+ */
+template<typename T, typename Derived>
+void find_intersection_parameters(
+    const PluckerBatch<T>& lines,
+    const PlaneBase<T, Derived>& plane,
+    T tolerance,
+    VectorXRef<T> res)
+{
+    using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+    assert(lines.rows() == res.rows());
+
+    const Vector3<T> n = plane.normal();
+    const auto l = lines.template leftCols<3>();
+    const auto m = lines.template rightCols<3>();
+
+    // l . (n x m) = m . (l x n), from the intersection point.
+    const Array ln = (l * n).array();
+    const Array numerator = l.rowwise().cross(n.transpose()).cwiseProduct(m).rowwise().sum().array()
+                          - plane.d() * l.rowwise().squaredNorm().array();
+
+    res.array() = (ln.abs() <= tolerance).select(std::numeric_limits<T>::quiet_NaN(), numerator / ln);
+}
+
+}   // namespace plucker
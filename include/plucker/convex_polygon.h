@@ -0,0 +1,142 @@
+/**
+ * @file plucker/convex_polygon.h
+ * @brief This file provides ray versus convex polygon tests.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+
+namespace plucker
+{
+
+/**
+ * Convex polygon with cached edge lines.
+ * Here, the front facing of a polygon is counterclockwise,
+ * and the edge i runs from vertex i to vertex i + 1.
+ */
+template<typename T, int N = Eigen::Dynamic>
+class ConvexPolygon
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+    static_assert(N == Eigen::Dynamic || N >= 3,
+        "Template parameter N must be Eigen::Dynamic or at least 3.");
+public:
+    using value_type = T;
+    using Vertices = Eigen::Matrix<T, N, 3>;
+    using Edges = Eigen::Matrix<T, N, 6>;
+
+/* Constructors */
+    ConvexPolygon()
+    {}
+    /**
+     * Creates from vertices, one per row.
+     */
+    explicit ConvexPolygon(const Vertices& vertices)
+        : vertices_(vertices),
+          edges_(vertices.rows(), 6)
+    {
+        assert(vertices.rows() >= 3);
+
+        const auto n = vertices.rows();
+        for(Eigen::Index i = 0; i < n; i++)
+        {
+            const Vector4<T> from = vertices.row(i).transpose().homogeneous();
+            const Vector4<T> to = vertices.row((i + 1) % n).transpose().homogeneous();
+            edges_.row(i) = Plucker<T>(from, to).coord().transpose();
+        }
+    }
+
+/* Accessors */
+    Eigen::Index size() const noexcept { return vertices_.rows(); }
+    const Vertices& vertices() const noexcept { return vertices_; }
+    /**
+     * Returns the lines of the edges, one per row.
+     */
+    const Edges& edges() const noexcept { return edges_; }
+    Plucker<T> edge(Eigen::Index i) const { return Plucker<T>(edges_.row(i).transpose()); }
+
+private:
+    static constexpr bool needs_to_align = (sizeof(Vertices) % 16 == 0) || (sizeof(Edges) % 16 == 0);
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(needs_to_align)
+
+private:
+    Vertices vertices_;
+    Edges edges_;
+};
+
+template<typename T>
+using Quad = ConvexPolygon<T, 4>;
+
+/**
+ * Returns true if a ray hits a convex polygon,
+ * i.e. no reciprocal product of the ray with its edges is positive.
+ */
+template<typename T, typename Derived, int N>
+bool has_intersection(const PluckerBase<T, Derived>& ray, const ConvexPolygon<T, N>& polygon)
+{
+    const Vector3<T> l = ray.l();
+    const Vector3<T> m = ray.m();
+    const auto& edges = polygon.edges();
+    return ((edges.template rightCols<3>() * l + edges.template leftCols<3>() * m).array() <= static_cast<T>(0)).all();
+}
+
+/**
+ * Batch of quads, one per row.
+ * e.g. Columns [6 i, 6 i + 6) are the line of edge i.
+ */
+template<typename T>
+using QuadBatch = Eigen::Matrix<T, Eigen::Dynamic, 24>;
+
+/**
+ * Stores a quad into a row of a batch.
+ */
+template<typename T>
+void store(const Quad<T>& quad, QuadBatch<T>& quads, Eigen::Index row)
+{
+    for(Eigen::Index i = 0; i < 4; i++)
+        quads.row(row).template segment<6>(6 * i) = quad.edges().row(i);
+}
+
+/**
+ * Tests a ray against all quads of a batch.
+ * e.g. `res[i]` is 1 if quad i is hit.
+ */
+template<typename T, typename Derived>
+void has_intersection(const PluckerBase<T, Derived>& ray, const QuadBatch<T>& quads, std::vector<std::uint8_t>& res)
+{
+    const auto rows = quads.rows();
+    res.resize(static_cast<std::size_t>(rows));
+
+    const Vector3<T> l = ray.l();
+    const Vector3<T> m = ray.m();
+
+    // Tests blocks of quads to keep the products in cache.
+    constexpr Eigen::Index block = 256;
+    Eigen::Array<bool, Eigen::Dynamic, 1> hits(std::min(block, rows));
+    for(Eigen::Index first = 0; first < rows; first += block)
+    {
+        const auto n = std::min(block, rows - first);
+        const auto q = quads.middleRows(first, n);
+
+        hits.head(n).setConstant(true);
+        for(Eigen::Index i = 0; i < 4; i++)
+        {
+            const auto products = q.template middleCols<3>(6 * i + 3) * l + q.template middleCols<3>(6 * i) * m;
+            hits.head(n) = hits.head(n) && (products.array() <= static_cast<T>(0));
+        }
+
+        for(Eigen::Index i = 0; i < n; i++)
+            res[static_cast<std::size_t>(first + i)] = hits(i) ? 1 : 0;
+    }
+}
+
+}   // namespace plucker
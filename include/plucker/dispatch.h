@@ -0,0 +1,397 @@
+/**
+ * @file plucker/dispatch.h
+ * @brief This file provides batch kernels for lines dispatched on the instruction set of the CPU.
+ *
+ * Eigen vectorizes for the instruction set the code is compiled for, e.g. SSE4.2.
+ * With GCC and Clang on x86, the kernels here are compiled for AVX2 and AVX-512 as well,
+ * through target attributes, and the widest one the CPU supports is picked at the first call.
+ * So one binary runs at full width on newer CPUs, and on Eigen elsewhere.
+ *
+ * The kernels take batches of float or double, and are in `plucker::dispatch`
+ * beside the Eigen functions of the same names, e.g. `dispatch::normalize(lines)`.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "relational.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PLUCKER_DISPATCH 1
+#include <immintrin.h>
+#else
+#define PLUCKER_DISPATCH 0
+#endif
+
+namespace plucker
+{
+
+namespace dispatch
+{
+
+/**
+ * Instruction sets of the batch kernels, from narrowest to widest.
+ * e.g. `baseline` is the Eigen code for the instruction set of the build.
+ */
+enum class InstructionSet
+{
+    baseline,
+    avx2,
+    avx512
+};
+
+}   // namespace dispatch
+
+}   // namespace plucker
+
+#if PLUCKER_DISPATCH
+
+#define PLUCKER_AVX2_TARGET __attribute__((target("avx2,fma")))
+#define PLUCKER_AVX512_TARGET __attribute__((target("avx512f")))
+
+namespace plucker
+{
+
+namespace detail
+{
+
+namespace avx2
+{
+
+/**
+ * Packed values of a SIMD register.
+ */
+template<typename T>
+struct Pack;
+
+template<>
+struct Pack<float>
+{
+    using type = __m256;
+    static constexpr std::size_t width = 8;
+
+    PLUCKER_AVX2_TARGET static inline type set1(float x) { return _mm256_set1_ps(x); }
+    PLUCKER_AVX2_TARGET static inline type load(const float* p) { return _mm256_loadu_ps(p); }
+    PLUCKER_AVX2_TARGET static inline void store(float* p, type a) { _mm256_storeu_ps(p, a); }
+    PLUCKER_AVX2_TARGET static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+    PLUCKER_AVX2_TARGET static inline type div(type a, type b) { return _mm256_div_ps(a, b); }
+    PLUCKER_AVX2_TARGET static inline type sqrt(type a) { return _mm256_sqrt_ps(a); }
+    /** Returns a * b + c. */
+    PLUCKER_AVX2_TARGET static inline type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+    /** Returns c - a * b. */
+    PLUCKER_AVX2_TARGET static inline type fnmadd(type a, type b, type c) { return _mm256_fnmadd_ps(a, b, c); }
+};
+
+template<>
+struct Pack<double>
+{
+    using type = __m256d;
+    static constexpr std::size_t width = 4;
+
+    PLUCKER_AVX2_TARGET static inline type set1(double x) { return _mm256_set1_pd(x); }
+    PLUCKER_AVX2_TARGET static inline type load(const double* p) { return _mm256_loadu_pd(p); }
+    PLUCKER_AVX2_TARGET static inline void store(double* p, type a) { _mm256_storeu_pd(p, a); }
+    PLUCKER_AVX2_TARGET static inline type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+    PLUCKER_AVX2_TARGET static inline type div(type a, type b) { return _mm256_div_pd(a, b); }
+    PLUCKER_AVX2_TARGET static inline type sqrt(type a) { return _mm256_sqrt_pd(a); }
+    PLUCKER_AVX2_TARGET static inline type fmadd(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+    PLUCKER_AVX2_TARGET static inline type fnmadd(type a, type b, type c) { return _mm256_fnmadd_pd(a, b, c); }
+};
+
+}   // namespace avx2
+
+namespace avx512
+{
+
+/**
+ * Packed values of a SIMD register.
+ */
+template<typename T>
+struct Pack;
+
+template<>
+struct Pack<float>
+{
+    using type = __m512;
+    static constexpr std::size_t width = 16;
+
+    PLUCKER_AVX512_TARGET static inline type set1(float x) { return _mm512_set1_ps(x); }
+    PLUCKER_AVX512_TARGET static inline type load(const float* p) { return _mm512_loadu_ps(p); }
+    PLUCKER_AVX512_TARGET static inline void store(float* p, type a) { _mm512_storeu_ps(p, a); }
+    PLUCKER_AVX512_TARGET static inline type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+    PLUCKER_AVX512_TARGET static inline type div(type a, type b) { return _mm512_div_ps(a, b); }
+    /** Masks no lanes, as `_mm512_sqrt_ps` warns of its undefined source with GCC 12. */
+    PLUCKER_AVX512_TARGET static inline type sqrt(type a) { return _mm512_maskz_sqrt_ps(static_cast<__mmask16>(0xffff), a); }
+    PLUCKER_AVX512_TARGET static inline type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+    PLUCKER_AVX512_TARGET static inline type fnmadd(type a, type b, type c) { return _mm512_fnmadd_ps(a, b, c); }
+};
+
+template<>
+struct Pack<double>
+{
+    using type = __m512d;
+    static constexpr std::size_t width = 8;
+
+    PLUCKER_AVX512_TARGET static inline type set1(double x) { return _mm512_set1_pd(x); }
+    PLUCKER_AVX512_TARGET static inline type load(const double* p) { return _mm512_loadu_pd(p); }
+    PLUCKER_AVX512_TARGET static inline void store(double* p, type a) { _mm512_storeu_pd(p, a); }
+    PLUCKER_AVX512_TARGET static inline type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+    PLUCKER_AVX512_TARGET static inline type div(type a, type b) { return _mm512_div_pd(a, b); }
+    PLUCKER_AVX512_TARGET static inline type sqrt(type a) { return _mm512_maskz_sqrt_pd(static_cast<__mmask8>(0xff), a); }
+    PLUCKER_AVX512_TARGET static inline type fmadd(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+    PLUCKER_AVX512_TARGET static inline type fnmadd(type a, type b, type c) { return _mm512_fnmadd_pd(a, b, c); }
+};
+
+}   // namespace avx512
+
+}   // namespace detail
+
+}   // namespace plucker
+
+#define PLUCKER_DISPATCH_NAMESPACE avx2
+#define PLUCKER_DISPATCH_TARGET PLUCKER_AVX2_TARGET
+#include "dispatch_kernels.h"
+#undef PLUCKER_DISPATCH_TARGET
+#undef PLUCKER_DISPATCH_NAMESPACE
+
+#define PLUCKER_DISPATCH_NAMESPACE avx512
+#define PLUCKER_DISPATCH_TARGET PLUCKER_AVX512_TARGET
+#include "dispatch_kernels.h"
+#undef PLUCKER_DISPATCH_TARGET
+#undef PLUCKER_DISPATCH_NAMESPACE
+
+#undef PLUCKER_AVX512_TARGET
+#undef PLUCKER_AVX2_TARGET
+
+#endif
+
+namespace plucker
+{
+
+namespace detail
+{
+
+/**
+ * Returns the widest instruction set the CPU and the operating system support.
+ */
+inline dispatch::InstructionSet
+detect_instruction_set()
+{
+    using dispatch::InstructionSet;
+
+#if PLUCKER_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return __builtin_cpu_supports("avx512f") ? InstructionSet::avx512 : InstructionSet::avx2;
+#endif
+    return InstructionSet::baseline;
+}
+
+/**
+ * Returns the moment followed by the direction of a line,
+ * e.g. `lines * dual(line)` are the reciprocal products with it.
+ */
+template<typename T, typename Derived>
+Vector6<T>
+dual(const PluckerBase<T, Derived>& line)
+{
+    Vector6<T> res;
+    res << line.m(), line.l();
+    return res;
+}
+
+}   // namespace detail
+
+namespace dispatch
+{
+
+/**
+ * Returns the instruction set of the batch kernels, the widest one of the CPU.
+ * e.g. It is detected at the first call, once per process.
+ */
+inline InstructionSet
+instruction_set()
+{
+    static const auto res = detail::detect_instruction_set();
+    return res;
+}
+
+/**
+ * Computes the reciprocal products of a line and lines.
+ * e.g. `set` narrows the instruction set of the kernel, for comparisons.
+ */
+template<typename T, typename Derived>
+void product(
+    const PluckerBase<T, Derived>& line,
+    const PluckerBatch<T>& lines,
+    VectorXRef<T> res,
+    InstructionSet set = instruction_set())
+{
+    assert(lines.rows() == res.rows());
+    assert(set <= instruction_set());
+
+    const auto count = static_cast<std::size_t>(lines.rows());
+    const Vector6<T> coefs = detail::dual(line);
+    switch(set)
+    {
+#if PLUCKER_DISPATCH
+    case InstructionSet::avx512:
+        detail::avx512::product(lines.data(), count, coefs.data(), res.data());
+        return;
+    case InstructionSet::avx2:
+        detail::avx2::product(lines.data(), count, coefs.data(), res.data());
+        return;
+#endif
+    default:
+        res.noalias() = lines * coefs;
+    }
+}
+
+/**
+ * Scales lines in place to unit directions.
+ * e.g. `set` narrows the instruction set of the kernel, for comparisons.
+ */
+template<typename T>
+void normalize(PluckerBatch<T>& lines, InstructionSet set = instruction_set())
+{
+    assert(set <= instruction_set());
+
+    const auto count = static_cast<std::size_t>(lines.rows());
+    switch(set)
+    {
+#if PLUCKER_DISPATCH
+    case InstructionSet::avx512:
+        detail::avx512::normalize(lines.data(), count);
+        return;
+    case InstructionSet::avx2:
+        detail::avx2::normalize(lines.data(), count);
+        return;
+#endif
+    default:
+        lines.array().colwise() /= lines.template leftCols<3>().rowwise().norm().array();
+    }
+}
+
+/**
+ * Computes the squared distances from points to a line.
+ * e.g. Each row of `points` is a point, and `set` narrows the instruction set of the kernel.
+ */
+template<typename T, typename Derived>
+void squared_distance(
+    const PluckerBase<T, Derived>& line,
+    const Vector3Batch<T>& points,
+    VectorXRef<T> res,
+    InstructionSet set = instruction_set())
+{
+    assert(points.rows() == res.rows());
+    assert(set <= instruction_set());
+
+    const auto count = static_cast<std::size_t>(points.rows());
+    const Vector6<T> coefs = line.coord();
+    switch(set)
+    {
+#if PLUCKER_DISPATCH
+    case InstructionSet::avx512:
+        detail::avx512::squared_distance(points.data(), count, coefs.data(), res.data());
+        return;
+    case InstructionSet::avx2:
+        detail::avx2::squared_distance(points.data(), count, coefs.data(), res.data());
+        return;
+#endif
+    default:
+        plucker::squared_distance(line, points, res);
+    }
+}
+
+}   // namespace dispatch
+
+namespace detail
+{
+
+/**
+ * Tests a line against lines, e.g. `res[i]` is 1 if they are coplanar,
+ * and when `crossing` is set, also not parallel.
+ */
+template<typename T, typename Derived>
+void intersection_flags(
+    const PluckerBase<T, Derived>& line,
+    const PluckerBatch<T>& lines,
+    T tolerance,
+    bool crossing,
+    std::vector<std::uint8_t>& res,
+    dispatch::InstructionSet set)
+{
+    using dispatch::InstructionSet;
+
+    assert(set <= dispatch::instruction_set());
+
+    res.resize(static_cast<std::size_t>(lines.rows()));
+
+    const auto count = static_cast<std::size_t>(lines.rows());
+    const Vector6<T> coefs = line.coord();
+    switch(set)
+    {
+#if PLUCKER_DISPATCH
+    case InstructionSet::avx512:
+        avx512::intersection_flags(lines.data(), count, coefs.data(), tolerance, crossing, res.data());
+        return;
+    case InstructionSet::avx2:
+        avx2::intersection_flags(lines.data(), count, coefs.data(), tolerance, crossing, res.data());
+        return;
+#endif
+    default:
+        break;
+    }
+
+    const Vector3<T> l = line.l();
+    const VectorX<T> products = lines * dual(line);
+    const VectorX<T> norms = lines.template leftCols<3>().rowwise().cross(l.transpose()).rowwise().norm();
+    for(std::size_t i = 0; i < count; i++)
+    {
+        const auto k = static_cast<Eigen::Index>(i);
+        res[i] = (almost_zero(products(k), tolerance) && !(crossing && almost_zero(norms(k), tolerance))) ? 1 : 0;
+    }
+}
+
+}   // namespace detail
+
+namespace dispatch
+{
+
+/**
+ * Tests a line against lines for being coplanar.
+ * e.g. `res[i]` is 1 if the line and line `i` are coplanar.
+ */
+template<typename T, typename Derived>
+void are_coplanar(
+    const PluckerBase<T, Derived>& line,
+    const PluckerBatch<T>& lines,
+    T tolerance,
+    std::vector<std::uint8_t>& res,
+    InstructionSet set = instruction_set())
+{
+    detail::intersection_flags(line, lines, tolerance, false, res, set);
+}
+
+/**
+ * Tests a line against lines for intersections.
+ * e.g. `res[i]` is 1 if the line and line `i` are coplanar and not parallel.
+ */
+template<typename T, typename Derived>
+void has_intersection(
+    const PluckerBase<T, Derived>& line,
+    const PluckerBatch<T>& lines,
+    T tolerance,
+    std::vector<std::uint8_t>& res,
+    InstructionSet set = instruction_set())
+{
+    detail::intersection_flags(line, lines, tolerance, true, res, set);
+}
+
+}   // namespace dispatch
+
+}   // namespace plucker
@@ -0,0 +1,194 @@
+/**
+ * @file plucker/dispatch_kernels.h
+ * @brief This file provides the batch kernels of dispatch.h for one instruction set.
+ *
+ * It has no include guard: dispatch.h includes it once per instruction set,
+ * with `PLUCKER_DISPATCH_NAMESPACE` naming the namespace of its `Pack` types
+ * and `PLUCKER_DISPATCH_TARGET` the attribute of its functions.
+ *
+ * Lines and points are the column-major data of a batch,
+ * e.g. coordinate c of line i is `lines[c * count + i]`.
+ */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace plucker
+{
+
+namespace detail
+{
+
+namespace PLUCKER_DISPATCH_NAMESPACE
+{
+
+/**
+ * Computes `res[i]`, the reciprocal product of line i and the line of `coefs`,
+ * i.e. its moment followed by its direction.
+ */
+template<typename T>
+PLUCKER_DISPATCH_TARGET void
+product(const T* lines, std::size_t count, const T* coefs, T* res)
+{
+    using P = Pack<T>;
+
+    typename P::type c[6];
+    for(std::size_t j = 0; j < 6; j++)
+        c[j] = P::set1(coefs[j]);
+
+    std::size_t i = 0;
+    for(; i + P::width <= count; i += P::width)
+    {
+        auto sum = P::mul(c[0], P::load(lines + i));
+        for(std::size_t j = 1; j < 6; j++)
+            sum = P::fmadd(c[j], P::load(lines + j * count + i), sum);
+        P::store(res + i, sum);
+    }
+    for(; i < count; i++)
+    {
+        auto sum = coefs[0] * lines[i];
+        for(std::size_t j = 1; j < 6; j++)
+            sum += coefs[j] * lines[j * count + i];
+        res[i] = sum;
+    }
+}
+
+/**
+ * Scales lines in place to unit directions.
+ */
+template<typename T>
+PLUCKER_DISPATCH_TARGET void
+normalize(T* lines, std::size_t count)
+{
+    using P = Pack<T>;
+
+    const auto one = P::set1(static_cast<T>(1));
+
+    std::size_t i = 0;
+    for(; i + P::width <= count; i += P::width)
+    {
+        const auto lx = P::load(lines + i);
+        const auto ly = P::load(lines + count + i);
+        const auto lz = P::load(lines + 2 * count + i);
+        const auto scale = P::div(one, P::sqrt(P::fmadd(lz, lz, P::fmadd(ly, ly, P::mul(lx, lx)))));
+        for(std::size_t j = 0; j < 6; j++)
+            P::store(lines + j * count + i, P::mul(P::load(lines + j * count + i), scale));
+    }
+    for(; i < count; i++)
+    {
+        const auto lx = lines[i];
+        const auto ly = lines[count + i];
+        const auto lz = lines[2 * count + i];
+        const auto scale = static_cast<T>(1) / std::sqrt(lx * lx + ly * ly + lz * lz);
+        for(std::size_t j = 0; j < 6; j++)
+            lines[j * count + i] *= scale;
+    }
+}
+
+/**
+ * Computes `res[i]`, the squared distance from point i to the line of `coefs`,
+ * i.e. its direction followed by its moment.
+ */
+template<typename T>
+PLUCKER_DISPATCH_TARGET void
+squared_distance(const T* points, std::size_t count, const T* coefs, T* res)
+{
+    using P = Pack<T>;
+
+    const T scale = static_cast<T>(1) / (coefs[0] * coefs[0] + coefs[1] * coefs[1] + coefs[2] * coefs[2]);
+    const auto lx = P::set1(coefs[0]);
+    const auto ly = P::set1(coefs[1]);
+    const auto lz = P::set1(coefs[2]);
+    const auto mx = P::set1(coefs[3]);
+    const auto my = P::set1(coefs[4]);
+    const auto mz = P::set1(coefs[5]);
+    const auto s = P::set1(scale);
+
+    std::size_t i = 0;
+    for(; i + P::width <= count; i += P::width)
+    {
+        const auto x = P::load(points + i);
+        const auto y = P::load(points + count + i);
+        const auto z = P::load(points + 2 * count + i);
+
+        // The moment of the line about the point, i.e. m - p x l.
+        const auto a = P::fnmadd(y, lz, P::fmadd(z, ly, mx));
+        const auto b = P::fnmadd(z, lx, P::fmadd(x, lz, my));
+        const auto c = P::fnmadd(x, ly, P::fmadd(y, lx, mz));
+        P::store(res + i, P::mul(s, P::fmadd(c, c, P::fmadd(b, b, P::mul(a, a)))));
+    }
+    for(; i < count; i++)
+    {
+        const auto x = points[i];
+        const auto y = points[count + i];
+        const auto z = points[2 * count + i];
+        const auto a = coefs[3] - (y * coefs[2] - z * coefs[1]);
+        const auto b = coefs[4] - (z * coefs[0] - x * coefs[2]);
+        const auto c = coefs[5] - (x * coefs[1] - y * coefs[0]);
+        res[i] = scale * (a * a + b * b + c * c);
+    }
+}
+
+/**
+ * Tests lines against the line of `coefs`, i.e. its direction followed by its moment.
+ * e.g. `res[i]` is 1 if line i is coplanar with it, and when `crossing` is set, also not parallel to it.
+ */
+template<typename T>
+PLUCKER_DISPATCH_TARGET void
+intersection_flags(const T* lines, std::size_t count, const T* coefs, T tolerance, bool crossing, std::uint8_t* res)
+{
+    using P = Pack<T>;
+
+    const auto lx = P::set1(coefs[0]);
+    const auto ly = P::set1(coefs[1]);
+    const auto lz = P::set1(coefs[2]);
+    const auto mx = P::set1(coefs[3]);
+    const auto my = P::set1(coefs[4]);
+    const auto mz = P::set1(coefs[5]);
+
+    const auto test = [&](T product, T norm)
+    {
+        return (almost_zero(product, tolerance) && !(crossing && almost_zero(norm, tolerance))) ? 1 : 0;
+    };
+
+    T products[P::width];
+    T norms[P::width];
+    std::size_t i = 0;
+    for(; i + P::width <= count; i += P::width)
+    {
+        const auto x = P::load(lines + i);
+        const auto y = P::load(lines + count + i);
+        const auto z = P::load(lines + 2 * count + i);
+        const auto product = P::fmadd(lz, P::load(lines + 5 * count + i),
+                             P::fmadd(ly, P::load(lines + 4 * count + i),
+                             P::fmadd(lx, P::load(lines + 3 * count + i),
+                             P::fmadd(mz, z, P::fmadd(my, y, P::mul(mx, x))))));
+
+        // The cross product of the directions, zero for parallel lines.
+        const auto a = P::fnmadd(z, ly, P::mul(y, lz));
+        const auto b = P::fnmadd(x, lz, P::mul(z, lx));
+        const auto c = P::fnmadd(y, lx, P::mul(x, ly));
+        P::store(products, product);
+        P::store(norms, P::sqrt(P::fmadd(c, c, P::fmadd(b, b, P::mul(a, a)))));
+        for(std::size_t j = 0; j < P::width; j++)
+            res[i + j] = static_cast<std::uint8_t>(test(products[j], norms[j]));
+    }
+    for(; i < count; i++)
+    {
+        const auto x = lines[i];
+        const auto y = lines[count + i];
+        const auto z = lines[2 * count + i];
+        const auto product = coefs[0] * lines[3 * count + i] + coefs[1] * lines[4 * count + i] + coefs[2] * lines[5 * count + i]
+                           + coefs[3] * x + coefs[4] * y + coefs[5] * z;
+        const auto a = y * coefs[2] - z * coefs[1];
+        const auto b = z * coefs[0] - x * coefs[2];
+        const auto c = x * coefs[1] - y * coefs[0];
+        res[i] = static_cast<std::uint8_t>(test(product, std::sqrt(a * a + b * b + c * c)));
+    }
+}
+
+}   // namespace PLUCKER_DISPATCH_NAMESPACE
+
+}   // namespace detail
+
+}   // namespace plucker
@@ -0,0 +1,337 @@
+/**
+ * @file plucker/edge_collision.h
+ * @brief This file provides continuous collision detection of moving edges.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "parallel.h"
+#include "segment.h"
+
+namespace plucker
+{
+
+/**
+ * Edge whose endpoints move linearly from `start` at time 0 to `end` at time 1.
+ */
+template<typename T>
+class MovingEdge
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+
+/* Constructors */
+    MovingEdge()
+    {}
+
+    MovingEdge(const Segment<T>& start, const Segment<T>& end)
+        : start_(start), end_(end)
+    {}
+
+/* Accessors */
+    const Segment<T>& start() const noexcept { return start_; }
+    const Segment<T>& end() const noexcept { return end_; }
+    Segment<T>& start() noexcept { return start_; }
+    Segment<T>& end() noexcept { return end_; }
+
+/* Queries */
+    /**
+     * Returns the edge at time t.
+     */
+    Segment<T> at(T t) const
+    {
+        return Segment<T>(start_.p0() + t * (end_.p0() - start_.p0()), start_.p1() + t * (end_.p1() - start_.p1()));
+    }
+
+private:
+    Segment<T> start_;
+    Segment<T> end_;
+};
+
+namespace detail
+{
+
+/**
+ * Returns the coefficients c of `f(t) = c0 + c1 t + c2 t^2 + c3 t^3`,
+ * the reciprocal product of the lines through two moving edges at time t.
+ * The edges are coplanar where f vanishes.
+ */
+template<typename T>
+Vector4<T> coplanarity_polynomial(const MovingEdge<T>& edge1, const MovingEdge<T>& edge2)
+{
+    // f(t) = l1(t) * m2(t) + l2(t) * m1(t) = -(b0 - a0) . ((a1 - a0) x (b1 - b0)), each term linear in t.
+    const Vector3<T> w0 = edge2.start().p0() - edge1.start().p0();
+    const Vector3<T> dw = (edge2.end().p0() - edge1.end().p0()) - w0;
+    const Vector3<T> e10 = edge1.start().direction();
+    const Vector3<T> de1 = edge1.end().direction() - e10;
+    const Vector3<T> e20 = edge2.start().direction();
+    const Vector3<T> de2 = edge2.end().direction() - e20;
+
+    const Vector3<T> a = e10.cross(e20);
+    const Vector3<T> b = e10.cross(de2) + de1.cross(e20);
+    const Vector3<T> c = de1.cross(de2);
+
+    Vector4<T> res;
+    res << -a.dot(w0), -(a.dot(dw) + b.dot(w0)), -(b.dot(dw) + c.dot(w0)), -c.dot(dw);
+    return res;
+}
+
+template<typename T>
+T evaluate_cubic(const Vector4<T>& c, T t)
+{
+    return ((c(3) * t + c(2)) * t + c(1)) * t + c(0);
+}
+
+/**
+ * Returns a root of a cubic in [t0, t1] by bisection, given a sign change there.
+ */
+template<typename T>
+T bisect_cubic(const Vector4<T>& c, T t0, T t1)
+{
+    auto f0 = evaluate_cubic(c, t0);
+    for(auto i = 0; i < 64; i++)
+    {
+        const auto t = static_cast<T>(0.5) * (t0 + t1);
+        if(t <= t0 || t >= t1)
+            break;
+        const auto f = evaluate_cubic(c, t);
+        if((f <= static_cast<T>(0)) == (f0 <= static_cast<T>(0)))
+        {
+            t0 = t;
+            f0 = f;
+        }
+        else
+        {
+            t1 = t;
+        }
+    }
+    return static_cast<T>(0.5) * (t0 + t1);
+}
+
+/**
+ * Returns true if two moving edges are within `distance_tolerance` at time t.
+ */
+template<typename T>
+bool are_touching(const MovingEdge<T>& edge1, const MovingEdge<T>& edge2, T t, T distance_tolerance)
+{
+    return squared_distance(edge1.at(t), edge2.at(t)) <= distance_tolerance * distance_tolerance;
+}
+
+/**
+ * Returns the first time in [t0, t1] when two moving edges are within `distance_tolerance`,
+ * by conservative advancement.
+ * Every point of an edge moves at a velocity interpolated from its endpoints,
+ * so the distance of the edges changes no faster than the largest relative speed of the endpoints,
+ * and no contact is skipped by advancing while the distance cannot reach the tolerance.
+ * Steps are at least `time_tolerance`.
+ */
+template<typename T>
+std::tuple<bool, T>
+advance_to_contact(const MovingEdge<T>& edge1, const MovingEdge<T>& edge2, T t0, T t1, T distance_tolerance, T time_tolerance)
+{
+    const Vector3<T> v1[2] = { edge1.end().p0() - edge1.start().p0(), edge1.end().p1() - edge1.start().p1() };
+    const Vector3<T> v2[2] = { edge2.end().p0() - edge2.start().p0(), edge2.end().p1() - edge2.start().p1() };
+
+    auto speed = static_cast<T>(0);
+    for(auto i = 0; i < 2; i++)
+        for(auto j = 0; j < 2; j++)
+            speed = std::max(speed, (v1[i] - v2[j]).norm());
+
+    auto t = t0;
+    for(;;)
+    {
+        const auto d = distance(edge1.at(t), edge2.at(t));
+        if(d <= distance_tolerance)
+            return std::make_tuple(true, t);
+        if(!(speed > static_cast<T>(0)) || t >= t1)
+            return std::make_tuple(false, T());
+        t = std::min(t + std::max((d - distance_tolerance) / speed, time_tolerance), t1);
+    }
+}
+
+}   // namespace detail
+
+/**
+ * Returns the first time in [0, 1] when two moving edges touch.
+ *
+ * The cubic of coplanarity is written in Bernstein form over [0, 1].
+ * Since a Bernstein polynomial lies within the hull of its coefficients,
+ * intervals whose coefficients share one sign beyond rounding noise have no root and are dropped,
+ * and the others are halved until narrower than `time_tolerance`.
+ * Each candidate, earliest first, is then checked by the distance of the edges.
+ * Intervals where the cubic is no more than rounding noise, e.g. edges staying coplanar
+ * like a flat cloth, are searched by the distance of the edges over time instead.
+ */
+template<typename T>
+std::tuple<bool, T>
+find_collision(const MovingEdge<T>& edge1, const MovingEdge<T>& edge2, T distance_tolerance, T time_tolerance)
+{
+    using Bernstein = std::array<T, 4>;
+
+    struct Interval
+    {
+        T t0;
+        T t1;
+        Bernstein b;
+    };
+
+    // Bounds the depth of halving, so that the pending intervals fit in a fixed stack.
+    time_tolerance = std::max(time_tolerance, std::numeric_limits<T>::epsilon());
+
+    const auto c = detail::coplanarity_polynomial(edge1, edge2);
+
+    // The cubic is a triple product of the offset and the directions of the edges,
+    // so the rounding noise of its coefficients scales with their lengths.
+    const auto scale =
+        std::max((edge2.start().p0() - edge1.start().p0()).norm(), (edge2.end().p0() - edge1.end().p0()).norm())
+        * std::max(edge1.start().direction().norm(), edge1.end().direction().norm())
+        * std::max(edge2.start().direction().norm(), edge2.end().direction().norm());
+    const auto noise = static_cast<T>(64) * std::numeric_limits<T>::epsilon() * scale;
+
+    Interval root;
+    root.t0 = static_cast<T>(0);
+    root.t1 = static_cast<T>(1);
+    root.b = {{
+        c(0),
+        c(0) + c(1) / static_cast<T>(3),
+        c(0) + static_cast<T>(2) * c(1) / static_cast<T>(3) + c(2) / static_cast<T>(3),
+        c(0) + c(1) + c(2) + c(3)
+    }};
+
+    // Depth first, so one pending right half per level at most.
+    std::array<Interval, std::numeric_limits<T>::digits + 1> stack;
+    std::size_t size = 0;
+    stack[size++] = root;
+    while(size > 0)
+    {
+        const auto interval = stack[--size];
+
+        const auto& b = interval.b;
+        const auto lo = std::min(std::min(b[0], b[1]), std::min(b[2], b[3]));
+        const auto hi = std::max(std::max(b[0], b[1]), std::max(b[2], b[3]));
+        if(std::max(-lo, hi) <= noise)
+        {
+            const auto res = detail::advance_to_contact(edge1, edge2, interval.t0, interval.t1, distance_tolerance, time_tolerance);
+            if(std::get<0>(res))
+                return res;
+            continue;
+        }
+        // The sign of noise tells nothing.
+        if(lo > noise || hi < -noise)
+            continue;
+
+        if(interval.t1 - interval.t0 <= time_tolerance)
+        {
+            // A root at an end of the interval may only show as noise there.
+            const auto sign_change = (b[0] <= static_cast<T>(0)) != (b[3] <= static_cast<T>(0));
+            const auto t = sign_change ? detail::bisect_cubic(c, interval.t0, interval.t1)
+                         : std::abs(b[0]) <= noise ? interval.t0
+                         : std::abs(b[3]) <= noise ? interval.t1
+                         : static_cast<T>(0.5) * (interval.t0 + interval.t1);
+            if(detail::are_touching(edge1, edge2, t, distance_tolerance))
+                return std::make_tuple(true, t);
+            if(!sign_change)
+            {
+                if(detail::are_touching(edge1, edge2, interval.t0, distance_tolerance))
+                    return std::make_tuple(true, interval.t0);
+                if(detail::are_touching(edge1, edge2, interval.t1, distance_tolerance))
+                    return std::make_tuple(true, interval.t1);
+            }
+            continue;
+        }
+
+        // Splits at the middle by de Casteljau, and visits the left half first.
+        const auto half = static_cast<T>(0.5);
+        const auto b01 = half * (b[0] + b[1]);
+        const auto b12 = half * (b[1] + b[2]);
+        const auto b23 = half * (b[2] + b[3]);
+        const auto b012 = half * (b01 + b12);
+        const auto b123 = half * (b12 + b23);
+        const auto b0123 = half * (b012 + b123);
+        const auto tm = half * (interval.t0 + interval.t1);
+
+        Interval right;
+        right.t0 = tm;
+        right.t1 = interval.t1;
+        right.b = {{ b0123, b123, b23, b[3] }};
+
+        Interval left;
+        left.t0 = interval.t0;
+        left.t1 = tm;
+        left.b = {{ b[0], b01, b012, b0123 }};
+
+        stack[size++] = right;
+        stack[size++] = left;
+    }
+    return std::make_tuple(false, T());
+}
+
+/**
+ * Batch of moving edges, one per row: the edge at time 0, then at time 1,
+ * i.e. (p0.x, p0.y, p0.z, p1.x, p1.y, p1.z) each.
+ */
+template<typename T>
+using MovingEdgeBatch = Eigen::Matrix<T, Eigen::Dynamic, 12>;
+
+/**
+ * Stores a moving edge into a row of a batch.
+ */
+template<typename T>
+void store(const MovingEdge<T>& edge, MovingEdgeBatch<T>& edges, Eigen::Index row)
+{
+    edges.row(row) << edge.start().p0().transpose(), edge.start().p1().transpose(),
+                      edge.end().p0().transpose(), edge.end().p1().transpose();
+}
+
+/**
+ * Returns a moving edge from a row of a batch.
+ */
+template<typename T>
+MovingEdge<T> load(const MovingEdgeBatch<T>& edges, Eigen::Index row)
+{
+    const auto r = edges.row(row);
+    return MovingEdge<T>(
+        Segment<T>(r.template segment<3>(0).transpose(), r.template segment<3>(3).transpose()),
+        Segment<T>(r.template segment<3>(6).transpose(), r.template segment<3>(9).transpose()));
+}
+
+/**
+ * Finds the first time of contact for each candidate pair of edges.
+ * e.g. `times(k)` is infinity if the pair k does not touch within [0, 1].
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ */
+template<typename T>
+void find_collisions(
+    const MovingEdgeBatch<T>& edges,
+    const std::vector<IndexPair>& pairs,
+    T distance_tolerance,
+    T time_tolerance,
+    VectorX<T>& times,
+    unsigned num_threads = 0)
+{
+    times.resize(static_cast<Eigen::Index>(pairs.size()));
+
+    detail::parallel_for(pairs.size(), num_threads,
+        [&](std::size_t first, std::size_t last, unsigned)
+        {
+            for(auto k = first; k < last; k++)
+            {
+                const auto edge1 = load(edges, static_cast<Eigen::Index>(pairs[k].first));
+                const auto edge2 = load(edges, static_cast<Eigen::Index>(pairs[k].second));
+                const auto res = find_collision(edge1, edge2, distance_tolerance, time_tolerance);
+                times(static_cast<Eigen::Index>(k)) = std::get<0>(res) ? std::get<1>(res) : std::numeric_limits<T>::infinity();
+            }
+        });
+}
+
+}   // namespace plucker
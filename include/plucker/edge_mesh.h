@@ -0,0 +1,242 @@
+/**
+ * @file plucker/edge_mesh.h
+ * @brief This file provides a triangle mesh with shared edge lines.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+
+namespace plucker
+{
+
+/**
+ * Triangle mesh storing the line of each edge once.
+ *
+ * An edge is stored directed from its lower vertex index to its higher one.
+ * Each triangle refers to its three edges `v0 -> v1`, `v1 -> v2`, `v2 -> v0`,
+ * and a bit per edge tells whether the triangle runs against the stored direction.
+ *
+ * Both triangles of a shared edge see exactly the same product with a ray,
+ * one of them negated, so a ray through the edge is never lost between them.
+ * Here, the front facing of a triangle is counterclockwise,
+ * and a ray hits a triangle if no product with its edges is positive.
+ * Note: Meshes of std::int64_t coordinates are queried by the exact functions of exact.h.
+ */
+template<typename T>
+class EdgeMesh
+{
+    static_assert(std::is_floating_point<T>::value || std::is_same<T, std::int64_t>::value,
+        "Template parameter T must be floating_point type or std::int64_t.");
+public:
+    using value_type = T;
+    using index_type = std::uint32_t;
+    using size_type = std::size_t;
+    using Triangles = Eigen::Matrix<index_type, Eigen::Dynamic, 3>;
+    using Edges = Eigen::Matrix<index_type, Eigen::Dynamic, 2>;
+
+/* Constructors */
+    EdgeMesh()
+    {}
+
+    EdgeMesh(const Vector3Batch<T>& vertices, const Triangles& triangles);
+
+/* Accessors */
+    size_type vertex_count() const noexcept { return static_cast<size_type>(vertices_.rows()); }
+    size_type triangle_count() const noexcept { return static_cast<size_type>(triangles_.rows()); }
+    size_type edge_count() const noexcept { return static_cast<size_type>(edges_.rows()); }
+
+    const Vector3Batch<T>& vertices() const noexcept { return vertices_; }
+    const Triangles& triangles() const noexcept { return triangles_; }
+    /**
+     * Returns the vertex indices of each edge, lower index first.
+     */
+    const Edges& edge_vertices() const noexcept { return edge_vertices_; }
+    /**
+     * Returns the lines of the edges, one per row.
+     */
+    const PluckerBatch<T>& edges() const noexcept { return edges_; }
+    /**
+     * Returns the edge indices of each triangle.
+     */
+    const Triangles& triangle_edges() const noexcept { return triangle_edges_; }
+    /**
+     * Returns the orientation bits of each triangle.
+     * e.g. Bit i is set if edge i of the triangle is reversed.
+     */
+    const std::vector<std::uint8_t>& orientations() const noexcept { return orientations_; }
+
+    Vector3<T> vertex(size_type v) const { return vertices_.row(static_cast<Eigen::Index>(v)).transpose(); }
+    Plucker<T> edge(size_type e) const { return Plucker<T>(edges_.row(static_cast<Eigen::Index>(e)).transpose()); }
+    /**
+     * Returns edge i of a triangle, directed along the triangle.
+     */
+    Plucker<T> triangle_edge(size_type t, int i) const;
+
+/* Queries */
+    /**
+     * Computes the reciprocal products of a ray with all edges.
+     */
+    template<typename Derived>
+    void edge_products(const PluckerBase<T, Derived>& ray, VectorX<T>& res) const;
+    /**
+     * Returns true if a ray hits a triangle, given its products with all edges.
+     */
+    bool has_intersection(const VectorX<T>& products, size_type t) const;
+    /**
+     * Returns true if a ray hits a triangle.
+     */
+    template<typename Derived>
+    bool has_intersection(const PluckerBase<T, Derived>& ray, size_type t) const;
+    /**
+     * Collects the triangles hit by a ray, evaluating each edge once.
+     */
+    template<typename Derived>
+    void find_intersections(const PluckerBase<T, Derived>& ray, std::vector<size_type>& res, VectorX<T>& products) const;
+
+private:
+    /**
+     * Returns the product of a ray with edge i of a triangle, from the product with the stored edge.
+     */
+    T oriented(T product, size_type t, int i) const
+    {
+        return ((orientations_[t] >> i) & 1u) ? -product : product;
+    }
+
+private:
+    Vector3Batch<T> vertices_;
+    Triangles triangles_;
+    Edges edge_vertices_;
+    PluckerBatch<T> edges_;
+    Triangles triangle_edges_;
+    std::vector<std::uint8_t> orientations_;
+};
+
+/* Constructors */
+
+template<typename T>
+EdgeMesh<T>::EdgeMesh(const Vector3Batch<T>& vertices, const Triangles& triangles)
+    : vertices_(vertices),
+      triangles_(triangles),
+      triangle_edges_(triangles.rows(), 3),
+      orientations_(static_cast<size_type>(triangles.rows()), 0)
+{
+    std::unordered_map<std::uint64_t, index_type> map;
+    map.reserve(static_cast<size_type>(triangles.rows()) * 3 / 2);
+
+    std::vector<index_type> pairs;
+    pairs.reserve(static_cast<size_type>(triangles.rows()) * 3);
+
+    for(Eigen::Index t = 0; t < triangles.rows(); t++)
+    {
+        for(Eigen::Index i = 0; i < 3; i++)
+        {
+            const auto a = triangles(t, i);
+            const auto b = triangles(t, (i + 1) % 3);
+            assert(a != b);
+
+            const auto lo = (a < b) ? a : b;
+            const auto hi = (a < b) ? b : a;
+            const auto key = (static_cast<std::uint64_t>(lo) << 32) | hi;
+
+            const auto res = map.insert(std::make_pair(key, static_cast<index_type>(pairs.size() / 2)));
+            if(res.second)
+            {
+                pairs.push_back(lo);
+                pairs.push_back(hi);
+            }
+
+            triangle_edges_(t, i) = res.first->second;
+            if(a > b)
+                orientations_[static_cast<size_type>(t)] |= static_cast<std::uint8_t>(1u << i);
+        }
+    }
+
+    const auto count = static_cast<Eigen::Index>(pairs.size() / 2);
+    edge_vertices_.resize(count, 2);
+    edges_.resize(count, 6);
+    for(Eigen::Index e = 0; e < count; e++)
+    {
+        const auto from = pairs[static_cast<size_type>(2 * e)];
+        const auto to = pairs[static_cast<size_type>(2 * e + 1)];
+        edge_vertices_(e, 0) = from;
+        edge_vertices_(e, 1) = to;
+
+        const Vector4<T> p1 = vertex(from).homogeneous();
+        const Vector4<T> p2 = vertex(to).homogeneous();
+        edges_.row(e) = Plucker<T>(p1, p2).coord().transpose();
+    }
+}
+
+/* Accessors */
+
+template<typename T>
+Plucker<T>
+EdgeMesh<T>::triangle_edge(size_type t, int i) const
+{
+    const auto e = edge(triangle_edges_(static_cast<Eigen::Index>(t), i));
+    return ((orientations_[t] >> i) & 1u) ? -e : e;
+}
+
+/* Queries */
+
+template<typename T>
+template<typename Derived>
+void
+EdgeMesh<T>::edge_products(const PluckerBase<T, Derived>& ray, VectorX<T>& res) const
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+    const Vector3<T> l = ray.l();
+    const Vector3<T> m = ray.m();
+    res.noalias() = edges_.template rightCols<3>() * l + edges_.template leftCols<3>() * m;
+}
+
+template<typename T>
+bool
+EdgeMesh<T>::has_intersection(const VectorX<T>& products, size_type t) const
+{
+    const auto row = static_cast<Eigen::Index>(t);
+    for(auto i = 0; i < 3; i++)
+    {
+        if(oriented(products(triangle_edges_(row, i)), t, i) > static_cast<T>(0))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+template<typename Derived>
+bool
+EdgeMesh<T>::has_intersection(const PluckerBase<T, Derived>& ray, size_type t) const
+{
+    const auto row = static_cast<Eigen::Index>(t);
+    for(auto i = 0; i < 3; i++)
+    {
+        if(oriented(ray * edge(triangle_edges_(row, i)), t, i) > static_cast<T>(0))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+template<typename Derived>
+void
+EdgeMesh<T>::find_intersections(const PluckerBase<T, Derived>& ray, std::vector<size_type>& res, VectorX<T>& products) const
+{
+    edge_products(ray, products);
+
+    res.clear();
+    for(size_type t = 0; t < triangle_count(); t++)
+    {
+        if(has_intersection(products, t))
+            res.push_back(t);
+    }
+}
+
+}   // namespace plucker
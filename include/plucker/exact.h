@@ -0,0 +1,212 @@
+/**
+ * @file plucker/exact.h
+ * @brief This file provides exact predicates for lines of integer coordinates.
+ *
+ * Lines through points of a grid, i.e. `Plucker<std::int64_t>` from integer points,
+ * have integer coordinates, and their signs can be computed exactly
+ * as long as the points lie within `detail::exact_coordinate_limit`.
+ * The predicates need no tolerance.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "plucker_query.h"
+#include "edge_mesh.h"
+
+namespace plucker
+{
+
+namespace detail
+{
+
+#if defined(__SIZEOF_INT128__)
+/**
+ * Integer wide enough for products of line coordinates.
+ */
+__extension__ typedef __int128 exact_int;
+
+/**
+ * Bound on the absolute point coordinates, for which
+ * direction coordinates fit 32 bits, moment coordinates 62 bits,
+ * and products of lines 96 bits.
+ */
+constexpr std::int64_t exact_coordinate_limit = std::int64_t(1) << 30;
+#else
+using exact_int = std::int64_t;
+
+/**
+ * Bound on the absolute point coordinates, for which products of lines fit 63 bits.
+ */
+constexpr std::int64_t exact_coordinate_limit = std::int64_t(1) << 19;
+#endif
+
+/**
+ * Returns -1, 0 or 1 as the sign of a value.
+ */
+template<typename T>
+int sign(T x)
+{
+    return (x > T(0)) - (x < T(0));
+}
+
+/**
+ * Returns the dot product of two vectors without overflow.
+ */
+inline exact_int
+exact_dot(const Eigen::Ref<const Vector3<std::int64_t>>& v1, const Eigen::Ref<const Vector3<std::int64_t>>& v2)
+{
+    return exact_int(v1.x()) * v2.x() + exact_int(v1.y()) * v2.y() + exact_int(v1.z()) * v2.z();
+}
+
+/**
+ * Returns true if a line is in the range of lines through points within `exact_coordinate_limit`,
+ * i.e. direction coordinates up to twice the limit, and moment coordinates up to twice its square.
+ */
+template<typename Derived>
+bool is_within_exact_range(const PluckerBase<std::int64_t, Derived>& line)
+{
+    return line.l().cwiseAbs().maxCoeff() <= 2 * exact_coordinate_limit
+        && line.m().cwiseAbs().maxCoeff() <= 2 * exact_coordinate_limit * exact_coordinate_limit;
+}
+
+}   // namespace detail
+
+/**
+ * Returns the reciprocal product of two lines without overflow.
+ */
+template<typename Derived1, typename Derived2>
+detail::exact_int
+exact_product(const PluckerBase<std::int64_t, Derived1>& p1, const PluckerBase<std::int64_t, Derived2>& p2)
+{
+    return detail::exact_dot(p1.l(), p2.m()) + detail::exact_dot(p2.l(), p1.m());
+}
+
+/**
+ * Returns the sign of the reciprocal product of two lines.
+ */
+template<typename Derived1, typename Derived2>
+int
+sign_of_product(const PluckerBase<std::int64_t, Derived1>& p1, const PluckerBase<std::int64_t, Derived2>& p2)
+{
+    return detail::sign(exact_product(p1, p2));
+}
+
+/**
+ * Returns true if two lines are coplanar.
+ */
+template<typename Derived1, typename Derived2>
+bool
+are_coplanar(const PluckerBase<std::int64_t, Derived1>& p1, const PluckerBase<std::int64_t, Derived2>& p2)
+{
+    return exact_product(p1, p2) == 0;
+}
+
+/**
+ * Returns true if two lines are parallel.
+ */
+template<typename Derived1, typename Derived2>
+bool
+are_parallel(const PluckerBase<std::int64_t, Derived1>& p1, const PluckerBase<std::int64_t, Derived2>& p2)
+{
+    const Vector3<std::int64_t> l1 = p1.l();
+    const Vector3<std::int64_t> l2 = p2.l();
+    return detail::exact_int(l1.y()) * l2.z() == detail::exact_int(l1.z()) * l2.y()
+        && detail::exact_int(l1.z()) * l2.x() == detail::exact_int(l1.x()) * l2.z()
+        && detail::exact_int(l1.x()) * l2.y() == detail::exact_int(l1.y()) * l2.x();
+}
+
+/**
+ * Returns true if two lines have intersection.
+ */
+template<typename Derived1, typename Derived2>
+bool
+has_intersection(const PluckerBase<std::int64_t, Derived1>& p1, const PluckerBase<std::int64_t, Derived2>& p2)
+{
+    return are_coplanar(p1, p2) && !are_parallel(p1, p2);
+}
+
+/**
+ * Returns -1, 0 or 1 as a point is below, on or above a plane.
+ */
+template<typename Derived>
+int
+orientation(const PlaneBase<std::int64_t, Derived>& plane, const Vector3<std::int64_t>& point)
+{
+    return detail::sign(detail::exact_dot(plane.normal(), point) + plane.d());
+}
+
+/**
+ * Returns true if a ray hits the front face of a triangle.
+ * Here, the front facing of a triangle is counterclockwise,
+ * and a ray in the plane of the triangle does not hit it.
+ * Note: Needs a ray and points within `detail::exact_coordinate_limit`.
+ */
+template<typename Derived>
+bool
+has_intersection(
+    const PluckerBase<std::int64_t, Derived>& ray,
+    const Vector3<std::int64_t>& p0,
+    const Vector3<std::int64_t>& p1,
+    const Vector3<std::int64_t>& p2)
+{
+    assert(detail::is_within_exact_range(ray));
+    assert(p0.cwiseAbs().maxCoeff() <= detail::exact_coordinate_limit
+        && p1.cwiseAbs().maxCoeff() <= detail::exact_coordinate_limit
+        && p2.cwiseAbs().maxCoeff() <= detail::exact_coordinate_limit);
+
+    const int signs[3] = {
+        sign_of_product(ray, Plucker<std::int64_t>(p0.homogeneous().eval(), p1.homogeneous().eval())),
+        sign_of_product(ray, Plucker<std::int64_t>(p1.homogeneous().eval(), p2.homogeneous().eval())),
+        sign_of_product(ray, Plucker<std::int64_t>(p2.homogeneous().eval(), p0.homogeneous().eval()))};
+    return signs[0] <= 0 && signs[1] <= 0 && signs[2] <= 0 && (signs[0] | signs[1] | signs[2]) != 0;
+}
+
+/**
+ * Collects the triangles of a mesh hit by a ray, evaluating the sign of each edge once.
+ * e.g. `signs[e]` receives the sign of the product of the ray with edge e.
+ *
+ * Both triangles of a shared edge see the same sign, so a ray through the edge
+ * hits both of them, or neither when they face away from one another.
+ * Note: Needs a ray and vertices within `detail::exact_coordinate_limit`.
+ */
+template<typename Derived>
+void
+find_intersections(
+    const EdgeMesh<std::int64_t>& mesh,
+    const PluckerBase<std::int64_t, Derived>& ray,
+    std::vector<std::size_t>& res,
+    std::vector<std::int8_t>& signs)
+{
+    assert(detail::is_within_exact_range(ray));
+    assert(mesh.vertices().size() == 0 || mesh.vertices().cwiseAbs().maxCoeff() <= detail::exact_coordinate_limit);
+
+    signs.resize(mesh.edge_count());
+    for(std::size_t e = 0; e < mesh.edge_count(); e++)
+        signs[e] = static_cast<std::int8_t>(sign_of_product(ray, mesh.edge(e)));
+
+    const auto& triangle_edges = mesh.triangle_edges();
+    const auto& orientations = mesh.orientations();
+
+    res.clear();
+    for(std::size_t t = 0; t < mesh.triangle_count(); t++)
+    {
+        auto positive = false;
+        auto negative = false;
+        for(auto i = 0; i < 3; i++)
+        {
+            const auto s = signs[triangle_edges(static_cast<Eigen::Index>(t), i)];
+            const auto oriented = ((orientations[t] >> i) & 1u) ? -s : s;
+            positive = positive || oriented > 0;
+            negative = negative || oriented < 0;
+        }
+        if(!positive && negative)
+            res.push_back(t);
+    }
+}
+
+}   // namespace plucker
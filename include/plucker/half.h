@@ -0,0 +1,338 @@
+/**
+ * @file plucker/half.h
+ * @brief This file provides batches of lines stored in half precision.
+ *
+ * Coordinates are stored as IEEE binary16 and computed on as float:
+ * kernels convert a block of rows at a time, which stays in cache,
+ * using F16C instructions where the compiler targets them.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "relational.h"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace plucker
+{
+
+/**
+ * Batch of lines in half precision, one line per row.
+ * e.g. Each coefficient holds the bits of an IEEE binary16.
+ */
+using PluckerHalfBatch = Eigen::Matrix<std::uint16_t, Eigen::Dynamic, 6>;
+
+namespace detail
+{
+
+/**
+ * Returns the half-precision bits of a float, rounded to nearest even.
+ */
+inline std::uint16_t
+float_to_half(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto sign = (bits >> 16) & 0x8000u;
+    const auto exponent = static_cast<int>((bits >> 23) & 0xffu);
+    auto mantissa = bits & 0x7fffffu;
+
+    // Infinity or NaN.
+    if(exponent == 0xff)
+        return static_cast<std::uint16_t>(sign | 0x7c00u | (mantissa != 0 ? 0x200u : 0u));
+
+    const auto e = exponent - 127 + 15;
+    if(e >= 0x1f)
+        return static_cast<std::uint16_t>(sign | 0x7c00u);
+    if(e < -10)
+        return static_cast<std::uint16_t>(sign);
+
+    // Subnormal, with the implicit bit shifted in.
+    auto shift = 13u;
+    auto half = static_cast<std::uint32_t>(e) << 10;
+    if(e <= 0)
+    {
+        mantissa |= 0x800000u;
+        shift = static_cast<unsigned>(14 - e);
+        half = 0;
+    }
+
+    half += mantissa >> shift;
+    const auto rest = mantissa & ((1u << shift) - 1u);
+    const auto halfway = 1u << (shift - 1u);
+    if(rest > halfway || (rest == halfway && (half & 1u) != 0))
+        half++;
+
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+/**
+ * Returns the float of half-precision bits.
+ */
+inline float
+half_to_float(std::uint16_t value)
+{
+    const auto sign = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+    const auto exponent = static_cast<std::uint32_t>((value >> 10) & 0x1fu);
+    auto mantissa = static_cast<std::uint32_t>(value & 0x3ffu);
+
+    std::uint32_t bits;
+    if(exponent == 0x1f)
+    {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else if(exponent != 0)
+    {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    else if(mantissa == 0)
+    {
+        bits = sign;
+    }
+    else
+    {
+        // Subnormal, normalized.
+        auto e = 113u;
+        while((mantissa & 0x400u) == 0)
+        {
+            mantissa <<= 1;
+            e--;
+        }
+        bits = sign | (e << 23) | ((mantissa & 0x3ffu) << 13);
+    }
+
+    float res;
+    std::memcpy(&res, &bits, sizeof(res));
+    return res;
+}
+
+/**
+ * Converts `count` half-precision values to floats.
+ */
+inline void
+half_to_float(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+#if defined(__F16C__)
+    for(; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+#endif
+    for(; i < count; i++)
+        dst[i] = half_to_float(src[i]);
+}
+
+/**
+ * Converts `count` floats to half-precision values, rounded to nearest even.
+ */
+inline void
+float_to_half(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+#if defined(__F16C__)
+    for(; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+    for(; i < count; i++)
+        dst[i] = float_to_half(src[i]);
+}
+
+/**
+ * Calls `func(first, block)` for consecutive blocks of lines converted to float,
+ * e.g. `block.row(i)` is line `first + i`.
+ */
+template<typename Function>
+void
+for_each_block(const PluckerHalfBatch& lines, Function func)
+{
+    constexpr Eigen::Index block_size = 256;
+
+    PluckerBatch<float> block(block_size, 6);
+    for(Eigen::Index first = 0; first < lines.rows(); first += block_size)
+    {
+        const auto n = std::min(block_size, lines.rows() - first);
+        if(n < block.rows())
+            block.resize(n, 6);
+        for(Eigen::Index j = 0; j < 6; j++)
+            half_to_float(lines.col(j).data() + first, block.col(j).data(), static_cast<std::size_t>(n));
+        func(first, block);
+    }
+}
+
+}   // namespace detail
+
+/**
+ * Stores lines in half precision.
+ */
+inline void
+store(const PluckerBatch<float>& lines, PluckerHalfBatch& res)
+{
+    res.resize(lines.rows(), 6);
+    for(Eigen::Index j = 0; j < 6; j++)
+        detail::float_to_half(lines.col(j).data(), res.col(j).data(), static_cast<std::size_t>(lines.rows()));
+}
+
+/**
+ * Loads lines stored in half precision.
+ */
+inline void
+load(const PluckerHalfBatch& lines, PluckerBatch<float>& res)
+{
+    res.resize(lines.rows(), 6);
+    for(Eigen::Index j = 0; j < 6; j++)
+        detail::half_to_float(lines.col(j).data(), res.col(j).data(), static_cast<std::size_t>(lines.rows()));
+}
+
+/**
+ * Stores a line in half precision at a row.
+ */
+template<typename Derived>
+void
+store(const PluckerBase<float, Derived>& line, PluckerHalfBatch& lines, Eigen::Index row)
+{
+    for(Eigen::Index j = 0; j < 6; j++)
+        lines(row, j) = detail::float_to_half(line.coord()(j));
+}
+
+/**
+ * Loads a line stored in half precision at a row.
+ */
+inline Plucker<float>
+load(const PluckerHalfBatch& lines, Eigen::Index row)
+{
+    Vector6<float> coord;
+    for(Eigen::Index j = 0; j < 6; j++)
+        coord(j) = detail::half_to_float(lines(row, j));
+    return Plucker<float>(coord);
+}
+
+/**
+ * Computes the reciprocal products of a line with lines in half precision.
+ */
+template<typename Derived>
+void
+product(const PluckerBase<float, Derived>& line, const PluckerHalfBatch& lines, VectorXRef<float> res)
+{
+    assert(lines.rows() == res.rows());
+
+    const Vector3<float> l = line.l();
+    const Vector3<float> m = line.m();
+    detail::for_each_block(lines,
+        [&](Eigen::Index first, const PluckerBatch<float>& block)
+        {
+            res.segment(first, block.rows()).noalias() = block.rightCols<3>() * l + block.leftCols<3>() * m;
+        });
+}
+
+/**
+ * Computes the shortest distances between a line and lines in half precision.
+ */
+template<typename Derived>
+void
+distance(const PluckerBase<float, Derived>& line, const PluckerHalfBatch& lines, float tolerance, VectorXRef<float> res)
+{
+    assert(lines.rows() == res.rows());
+
+    using Array = Eigen::Array<float, Eigen::Dynamic, 1>;
+
+    const Vector3<float> l = line.l();
+    const Vector3<float> m = line.m();
+    const auto l_norm = l.norm();
+
+    detail::for_each_block(lines,
+        [&](Eigen::Index first, const PluckerBatch<float>& block)
+        {
+            const auto l2 = block.leftCols<3>();
+            const auto m2 = block.rightCols<3>();
+
+            // Skew lines.
+            const Array n_norm = l2.rowwise().cross(l.transpose()).rowwise().norm().array();
+            const Array skew = ((l2 * m + m2 * l).array() / n_norm).abs();
+
+            // Parallel lines, with m2 scaled to the length and direction of l.
+            const Array dots = (l2 * l).array();
+            const Array s = (dots < 0.0f).select(-l2.rowwise().norm().array(), l2.rowwise().norm().array()) / l_norm;
+            const Vector3Batch<float> dm = (-(m2.array().colwise() / s)).matrix().rowwise() + m.transpose();
+            const Array parallel = dm.rowwise().cross(l.transpose()).rowwise().norm().array() / l.squaredNorm();
+
+            res.segment(first, block.rows()) = (n_norm <= tolerance).select(parallel, skew).matrix();
+        });
+}
+
+/**
+ * Tests a line against lines in half precision for being coplanar.
+ * e.g. `res[i]` is 1 if the line and line `i` are coplanar.
+ */
+template<typename Derived>
+void
+are_coplanar(const PluckerBase<float, Derived>& line, const PluckerHalfBatch& lines, float tolerance, std::vector<std::uint8_t>& res)
+{
+    res.resize(static_cast<std::size_t>(lines.rows()));
+
+    const Vector3<float> l = line.l();
+    const Vector3<float> m = line.m();
+    detail::for_each_block(lines,
+        [&](Eigen::Index first, const PluckerBatch<float>& block)
+        {
+            const VectorX<float> products = block.rightCols<3>() * l + block.leftCols<3>() * m;
+            for(Eigen::Index i = 0; i < block.rows(); i++)
+                res[static_cast<std::size_t>(first + i)] = detail::almost_zero(products(i), tolerance) ? 1 : 0;
+        });
+}
+
+/**
+ * Tests a line against lines in half precision for being parallel.
+ * e.g. `res[i]` is 1 if the line and line `i` are parallel.
+ */
+template<typename Derived>
+void
+are_parallel(const PluckerBase<float, Derived>& line, const PluckerHalfBatch& lines, float tolerance, std::vector<std::uint8_t>& res)
+{
+    res.resize(static_cast<std::size_t>(lines.rows()));
+
+    const Vector3<float> l = line.l();
+    detail::for_each_block(lines,
+        [&](Eigen::Index first, const PluckerBatch<float>& block)
+        {
+            const VectorX<float> norms = block.leftCols<3>().rowwise().cross(l.transpose()).rowwise().norm();
+            for(Eigen::Index i = 0; i < block.rows(); i++)
+                res[static_cast<std::size_t>(first + i)] = detail::almost_zero(norms(i), tolerance) ? 1 : 0;
+        });
+}
+
+/**
+ * Tests a line against lines in half precision for intersection.
+ * e.g. `res[i]` is 1 if the line and line `i` have intersection.
+ */
+template<typename Derived>
+void
+has_intersection(const PluckerBase<float, Derived>& line, const PluckerHalfBatch& lines, float tolerance, std::vector<std::uint8_t>& res)
+{
+    res.resize(static_cast<std::size_t>(lines.rows()));
+
+    const Vector3<float> l = line.l();
+    const Vector3<float> m = line.m();
+    detail::for_each_block(lines,
+        [&](Eigen::Index first, const PluckerBatch<float>& block)
+        {
+            const VectorX<float> products = block.rightCols<3>() * l + block.leftCols<3>() * m;
+            const VectorX<float> norms = block.leftCols<3>().rowwise().cross(l.transpose()).rowwise().norm();
+            for(Eigen::Index i = 0; i < block.rows(); i++)
+            {
+                res[static_cast<std::size_t>(first + i)] =
+                    (detail::almost_zero(products(i), tolerance) && !detail::almost_zero(norms(i), tolerance)) ? 1 : 0;
+            }
+        });
+}
+
+}   // namespace plucker
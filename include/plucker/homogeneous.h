@@ -0,0 +1,139 @@
+/**
+ * @file plucker/homogeneous.h
+ * @brief This file provides batch functions for homogeneous points.
+ *
+ * A batch of homogeneous points (x, y, z : w) is a `Vector4Batch`, one point per row,
+ * so each coordinate, and w in particular, is contiguous.
+ * Points at infinity, i.e. directions, have w = 0.
+ */
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "plucker_query.h"
+
+namespace plucker
+{
+
+/**
+ * Computes the points of homogeneous points, dividing by w.
+ * e.g. Row k of `res` is NaN if point k is at infinity within tolerance.
+ */
+template<typename T>
+void dehomogenize(const Vector4Batch<T>& points, T tolerance, Vector3Batch<T>& res)
+{
+    const auto w = points.col(3).array();
+    const auto at_infinity = w.abs() <= tolerance;
+    const auto nan = std::numeric_limits<T>::quiet_NaN();
+
+    res.resize(points.rows(), 3);
+    for(Eigen::Index i = 0; i < 3; i++)
+        res.col(i) = at_infinity.select(nan, points.col(i).array() / w).matrix();
+}
+
+/**
+ * Computes homogeneous points of points, with w = 1.
+ */
+template<typename T>
+void homogenize(const Vector3Batch<T>& points, Vector4Batch<T>& res)
+{
+    res.resize(points.rows(), 4);
+    res.template leftCols<3>() = points;
+    res.col(3).setOnes();
+}
+
+/**
+ * Scales homogeneous points to w = 1, and directions at infinity to unit length.
+ * e.g. `tolerance` decides which points are at infinity.
+ */
+template<typename T>
+void normalize(Vector4Batch<T>& points, T tolerance)
+{
+    using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+    const Array w = points.col(3).array();
+    const Array norms = points.template leftCols<3>().rowwise().norm().array();
+    const Array scale = (w.abs() <= tolerance).select(norms, w);
+    points.array().colwise() /= scale;
+}
+
+/**
+ * Tests whether homogeneous points are at infinity.
+ * e.g. `res[k]` is 1 if |w| of point k is within tolerance.
+ */
+template<typename T>
+void is_at_infinity(const Vector4Batch<T>& points, T tolerance, std::vector<std::uint8_t>& res)
+{
+    res.resize(static_cast<std::size_t>(points.rows()));
+    for(Eigen::Index k = 0; k < points.rows(); k++)
+        res[static_cast<std::size_t>(k)] = std::abs(points(k, 3)) <= tolerance ? 1 : 0;
+}
+
+/**
+ * Tests whether homogeneous points are finite points.
+ * e.g. `res[k]` is 1 if point k is not at infinity within tolerance
+ * and its coordinates are neither infinite nor NaN.
+ */
+template<typename T>
+void is_finite(const Vector4Batch<T>& points, T tolerance, std::vector<std::uint8_t>& res)
+{
+    const auto finite = points.array().isFinite().rowwise().all();
+    const auto away = points.col(3).array().abs() > tolerance;
+
+    res.resize(static_cast<std::size_t>(points.rows()));
+    for(Eigen::Index k = 0; k < points.rows(); k++)
+        res[static_cast<std::size_t>(k)] = finite(k) && away(k) ? 1 : 0;
+}
+
+/**
+ * Computes the closest points of lines to the origin, as `closest_point(p)` does.
+ */
+template<typename T>
+void closest_points(const PluckerBatch<T>& lines, Vector4Batch<T>& res)
+{
+    const auto l = lines.template leftCols<3>();
+    const auto m = lines.template rightCols<3>();
+
+    // l x m per line.
+    res.resize(lines.rows(), 4);
+    res.col(0) = l.col(1).cwiseProduct(m.col(2)) - l.col(2).cwiseProduct(m.col(1));
+    res.col(1) = l.col(2).cwiseProduct(m.col(0)) - l.col(0).cwiseProduct(m.col(2));
+    res.col(2) = l.col(0).cwiseProduct(m.col(1)) - l.col(1).cwiseProduct(m.col(0));
+    res.col(3) = l.rowwise().squaredNorm();
+}
+
+/**
+ * Computes a point on each line, as `point_on_line(p, t)` does.
+ * e.g. `t` may come from `find_closest_approaches` or `find_intersection_parameters`.
+ */
+template<typename T>
+void points_on_lines(const PluckerBatch<T>& lines, const VectorX<T>& t, Vector4Batch<T>& res)
+{
+    assert(lines.rows() == t.rows());
+
+    closest_points(lines, res);
+    res.template leftCols<3>() += lines.template leftCols<3>().cwiseProduct(t.replicate(1, 3));
+}
+
+/**
+ * Computes the intersections of lines and a plane, as `find_intersection(line, plane)` does.
+ * e.g. Lines parallel to the plane give points at infinity.
+ */
+template<typename T, typename Derived>
+void find_intersections(const PluckerBatch<T>& lines, const PlaneBase<T, Derived>& plane, Vector4Batch<T>& res)
+{
+    const Vector3<T> n = plane.normal();
+
+    // n x m = - m x n.
+    res.resize(lines.rows(), 4);
+    res.template leftCols<3>() = - lines.template rightCols<3>().rowwise().cross(n.transpose())
+                               - plane.d() * lines.template leftCols<3>();
+    res.col(3) = lines.template leftCols<3>() * n;
+}
+
+}   // namespace plucker
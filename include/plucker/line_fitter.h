@@ -0,0 +1,198 @@
+/**
+ * @file plucker/line_fitter.h
+ * @brief This file provides an incremental least-squares line fitter.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <Eigen/Eigenvalues>
+#include "plucker_base.h"
+
+namespace plucker
+{
+
+/**
+ * Incremental least-squares fitting of a line to a stream of points.
+ *
+ * Only a constant-size summary of the points is kept: the count,
+ * the centroid and the scatter matrix about the centroid.
+ * Summaries of disjoint point sets can be merged, so fitting can be
+ * split across threads and combined afterwards.
+ */
+template<typename T>
+class LineFitter
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using Matrix3 = Eigen::Matrix<T, 3, 3>;
+
+/* Constructors */
+    LineFitter()
+        : count_(0),
+          centroid_(Vector3<T>::Zero()),
+          scatter_(Matrix3::Zero())
+    {}
+
+/* Accessors */
+    size_type count() const noexcept { return count_; }
+    const Vector3<T>& centroid() const noexcept { return centroid_; }
+    /**
+     * Returns the scatter matrix about the centroid.
+     */
+    const Matrix3& scatter() const noexcept { return scatter_; }
+
+/* Modifiers */
+    void add(const Vector3<T>& point);
+    /**
+     * Adds points stored one per row, or a point given by a column expression.
+     */
+    template<typename Derived>
+    void add(const Eigen::MatrixBase<Derived>& points)
+    {
+        add(points, std::integral_constant<bool, Derived::ColsAtCompileTime == 1>());
+    }
+    void merge(const LineFitter& other);
+    void clear() noexcept;
+
+/* Assignment operators */
+    LineFitter& operator += (const Vector3<T>& point) { add(point); return *this; }
+    LineFitter& operator += (const LineFitter& other) { merge(other); return *this; }
+
+/* Queries */
+    /**
+     * Returns the best-fit line through the points.
+     * The direction of the line is normalized.
+     */
+    std::tuple<bool, Plucker<T>> fit() const;
+    /**
+     * Returns the sum of squared distances from the points to the best-fit line.
+     */
+    T residual() const;
+
+private:
+    using Solver = Eigen::SelfAdjointEigenSolver<Matrix3>;
+
+    template<typename Derived>
+    void add(const Eigen::MatrixBase<Derived>& point, std::true_type) { add(Vector3<T>(point)); }
+    template<typename Derived>
+    void add(const Eigen::MatrixBase<Derived>& points, std::false_type);
+    void merge(size_type count, const Vector3<T>& centroid, const Matrix3& scatter);
+
+    static constexpr bool needs_to_align = (sizeof(Matrix3) % 16) == 0;
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(needs_to_align)
+
+private:
+    size_type count_;
+    Vector3<T> centroid_;
+    Matrix3 scatter_;
+};
+
+/* Modifiers */
+
+template<typename T>
+void
+LineFitter<T>::add(const Vector3<T>& point)
+{
+    // Welford's update.
+    count_++;
+    const Vector3<T> delta = point - centroid_;
+    centroid_ += delta / static_cast<T>(count_);
+    scatter_.noalias() += delta * (point - centroid_).transpose();
+}
+
+template<typename T>
+template<typename Derived>
+void
+LineFitter<T>::add(const Eigen::MatrixBase<Derived>& points, std::false_type)
+{
+    static_assert(Derived::ColsAtCompileTime == 3 || Derived::ColsAtCompileTime == Eigen::Dynamic,
+        "Points must be stored one per row.");
+    assert(points.cols() == 3);
+
+    if(points.rows() == 0)
+        return;
+
+    const Vector3<T> centroid = points.colwise().mean().transpose();
+    const auto centered = (points.rowwise() - centroid.transpose()).eval();
+    const Matrix3 scatter = centered.transpose() * centered;
+
+    merge(static_cast<size_type>(points.rows()), centroid, scatter);
+}
+
+template<typename T>
+void
+LineFitter<T>::merge(const LineFitter& other)
+{
+    merge(other.count_, other.centroid_, other.scatter_);
+}
+
+template<typename T>
+void
+LineFitter<T>::merge(size_type count, const Vector3<T>& centroid, const Matrix3& scatter)
+{
+    if(count == 0)
+        return;
+
+    // Chan's parallel update.
+    const auto n1 = static_cast<T>(count_);
+    const auto n2 = static_cast<T>(count);
+    const auto n = n1 + n2;
+    const Vector3<T> delta = centroid - centroid_;
+
+    centroid_ += delta * (n2 / n);
+    scatter_ += scatter + (n1 * n2 / n) * (delta * delta.transpose());
+    count_ += count;
+}
+
+template<typename T>
+void
+LineFitter<T>::clear() noexcept
+{
+    count_ = 0;
+    centroid_.setZero();
+    scatter_.setZero();
+}
+
+/* Queries */
+
+template<typename T>
+std::tuple<bool, Plucker<T>>
+LineFitter<T>::fit() const
+{
+    if(count_ < 2)
+        return std::make_tuple(false, Plucker<T>());
+
+    const Solver solver(scatter_);
+    if(solver.info() != Eigen::Success)
+        return std::make_tuple(false, Plucker<T>());
+
+    // Eigenvalues are sorted in increasing order.
+    const Vector3<T> l = solver.eigenvectors().col(2);
+    if(solver.eigenvalues()(2) <= static_cast<T>(0))
+        return std::make_tuple(false, Plucker<T>());
+
+    return std::make_tuple(true, Plucker<T>(l, centroid_.cross(l)));
+}
+
+template<typename T>
+T
+LineFitter<T>::residual() const
+{
+    if(count_ < 2)
+        return static_cast<T>(0);
+
+    const Solver solver(scatter_, Eigen::EigenvaluesOnly);
+    const auto& ev = solver.eigenvalues();
+    return std::max(ev(0) + ev(1), static_cast<T>(0));
+}
+
+}   // namespace plucker
@@ -0,0 +1,260 @@
+/**
+ * @file plucker/line_intersector.h
+ * @brief This file provides the least-squares intersection point of lines.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "relational.h"
+
+namespace plucker
+{
+
+/**
+ * Accumulates the point minimizing the sum of squared distances to lines.
+ *
+ * Each line contributes `w (I - l l^T)` to a 3x3 matrix and `w l x m`
+ * to a vector, with `l` and `m` divided by the length of `l`,
+ * so that the lines need not be normalized.
+ */
+template<typename T>
+class LineIntersector
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using Matrix3 = Eigen::Matrix<T, 3, 3>;
+
+/* Constructors */
+    LineIntersector()
+        : weight_(0),
+          matrix_(Matrix3::Zero()),
+          vector_(Vector3<T>::Zero())
+    {}
+
+/* Accessors */
+    /**
+     * Returns the sum of weights.
+     */
+    T weight() const noexcept { return weight_; }
+    /**
+     * Returns the matrix of the normal equations.
+     */
+    const Matrix3& matrix() const noexcept { return matrix_; }
+    /**
+     * Returns the right-hand side of the normal equations.
+     */
+    const Vector3<T>& vector() const noexcept { return vector_; }
+
+/* Modifiers */
+    template<typename Derived>
+    void add(const PluckerBase<T, Derived>& line, T weight = static_cast<T>(1));
+    void merge(const LineIntersector& other);
+    void clear() noexcept;
+
+/* Queries */
+    /**
+     * Returns the homogeneous point closest to all lines.
+     * Fails if the lines are parallel within tolerance.
+     */
+    std::tuple<bool, Vector4<T>> find_point(T tolerance) const;
+
+private:
+    static constexpr bool needs_to_align = (sizeof(Matrix3) % 16) == 0;
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(needs_to_align)
+
+private:
+    T weight_;
+    Matrix3 matrix_;
+    Vector3<T> vector_;
+};
+
+namespace detail
+{
+
+/**
+ * Returns the homogeneous solution of `A x = b` for a symmetric `A`,
+ * i.e. (adj(A) b, det(A)).
+ */
+template<typename T>
+Vector4<T> solve_symmetric3(T axx, T ayy, T azz, T axy, T axz, T ayz, T bx, T by, T bz)
+{
+    const auto cxx = ayy * azz - ayz * ayz;
+    const auto cxy = axz * ayz - axy * azz;
+    const auto cxz = axy * ayz - axz * ayy;
+    const auto cyy = axx * azz - axz * axz;
+    const auto cyz = axy * axz - axx * ayz;
+    const auto czz = axx * ayy - axy * axy;
+
+    Vector4<T> res;
+    res << cxx * bx + cxy * by + cxz * bz,
+           cxy * bx + cyy * by + cyz * bz,
+           cxz * bx + cyz * by + czz * bz,
+           axx * cxx + axy * cxy + axz * cxz;
+    return res;
+}
+
+}   // namespace detail
+
+/* Modifiers */
+
+template<typename T>
+template<typename Derived>
+void
+LineIntersector<T>::add(const PluckerBase<T, Derived>& line, T weight)
+{
+    const Vector3<T> l = line.l();
+    const auto s = weight / l.squaredNorm();
+
+    weight_ += weight;
+    matrix_.diagonal().array() += weight;
+    matrix_.noalias() -= (s * l) * l.transpose();
+    vector_ += s * l.cross(Vector3<T>(line.m()));
+}
+
+template<typename T>
+void
+LineIntersector<T>::merge(const LineIntersector& other)
+{
+    weight_ += other.weight_;
+    matrix_ += other.matrix_;
+    vector_ += other.vector_;
+}
+
+template<typename T>
+void
+LineIntersector<T>::clear() noexcept
+{
+    weight_ = static_cast<T>(0);
+    matrix_.setZero();
+    vector_.setZero();
+}
+
+/* Queries */
+
+template<typename T>
+std::tuple<bool, Vector4<T>>
+LineIntersector<T>::find_point(T tolerance) const
+{
+    if(!(weight_ > static_cast<T>(0)))
+        return std::make_tuple(false, Vector4<T>());
+
+    // Scales the eigenvalues into [0, 1], so that the tolerance does not depend on weights.
+    const Matrix3 a = matrix_ / weight_;
+    const Vector3<T> b = vector_ / weight_;
+    const auto point = detail::solve_symmetric3(
+        a(0, 0), a(1, 1), a(2, 2), a(0, 1), a(0, 2), a(1, 2), b.x(), b.y(), b.z());
+
+    if(detail::almost_zero(point.w(), tolerance))
+        return std::make_tuple(false, Vector4<T>());
+
+    return std::make_tuple(true, point);
+}
+
+/**
+ * Returns the homogeneous point closest to all lines in the least-squares sense.
+ */
+template<typename InputIt, typename T>
+std::tuple<bool, Vector4<T>>
+find_nearest_point(InputIt first, InputIt last, T tolerance)
+{
+    LineIntersector<T> intersector;
+    for(; first != last; ++first)
+        intersector.add(*first);
+
+    return intersector.find_point(tolerance);
+}
+
+/**
+ * Solves independent least-squares intersection problems at once.
+ * e.g. Problem `k` consists of the lines in rows [offsets[k], offsets[k + 1]).
+ *
+ * Row `k` of `points` receives the homogeneous solution of problem `k`,
+ * or zero when its lines are parallel within tolerance.
+ */
+template<typename T>
+void find_nearest_points(
+    const PluckerBatch<T>& lines,
+    const VectorX<T>& weights,
+    const std::vector<std::size_t>& offsets,
+    T tolerance,
+    Vector4Batch<T>& points)
+{
+    assert(weights.rows() == lines.rows());
+    assert(!offsets.empty() && offsets.back() == static_cast<std::size_t>(lines.rows()));
+
+    const auto lx = lines.col(0).array();
+    const auto ly = lines.col(1).array();
+    const auto lz = lines.col(2).array();
+    const auto mx = lines.col(3).array();
+    const auto my = lines.col(4).array();
+    const auto mz = lines.col(5).array();
+    const auto w = weights.array();
+
+    // Contributions of each line to the normal equations.
+    Eigen::Matrix<T, Eigen::Dynamic, 10> terms(lines.rows(), 10);
+    {
+        const VectorX<T> s = w / (lx.square() + ly.square() + lz.square());
+        const auto sa = s.array();
+        terms.col(0) = w - sa * lx * lx;
+        terms.col(1) = w - sa * ly * ly;
+        terms.col(2) = w - sa * lz * lz;
+        terms.col(3) = -sa * lx * ly;
+        terms.col(4) = -sa * lx * lz;
+        terms.col(5) = -sa * ly * lz;
+        terms.col(6) = sa * (ly * mz - lz * my);
+        terms.col(7) = sa * (lz * mx - lx * mz);
+        terms.col(8) = sa * (lx * my - ly * mx);
+        terms.col(9) = w;
+    }
+
+    const auto count = static_cast<Eigen::Index>(offsets.size() - 1);
+    Eigen::Matrix<T, Eigen::Dynamic, 10> sums(count, 10);
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        const auto first = static_cast<Eigen::Index>(offsets[static_cast<std::size_t>(k)]);
+        const auto last = static_cast<Eigen::Index>(offsets[static_cast<std::size_t>(k + 1)]);
+        sums.row(k) = terms.middleRows(first, last - first).colwise().sum();
+    }
+
+    points.resize(count, 4);
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        const auto total = sums(k, 9);
+        if(!(total > static_cast<T>(0)))
+        {
+            points.row(k).setZero();
+            continue;
+        }
+
+        const Eigen::Matrix<T, 1, 9> a = sums.row(k).template head<9>() / total;
+        const auto point = detail::solve_symmetric3(a(0), a(1), a(2), a(3), a(4), a(5), a(6), a(7), a(8));
+        if(detail::almost_zero(point.w(), tolerance))
+            points.row(k).setZero();
+        else
+            points.row(k) = point.transpose();
+    }
+}
+
+/**
+ * Solves independent unweighted least-squares intersection problems at once.
+ */
+template<typename T>
+void find_nearest_points(
+    const PluckerBatch<T>& lines,
+    const std::vector<std::size_t>& offsets,
+    T tolerance,
+    Vector4Batch<T>& points)
+{
+    find_nearest_points(lines, VectorX<T>::Ones(lines.rows()).eval(), offsets, tolerance, points);
+}
+
+}   // namespace plucker
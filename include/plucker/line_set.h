@@ -0,0 +1,252 @@
+/**
+ * @file plucker/line_set.h
+ * @brief This file provides hashing and deduplication of lines.
+ */
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_geometric.h"
+
+namespace plucker
+{
+
+/**
+ * Grid cell of a canonical line in the 6D coordinate space.
+ */
+struct LineKey
+{
+    std::array<std::int64_t, 6> cell;
+
+    bool operator == (const LineKey& rhs) const { return cell == rhs.cell; }
+    bool operator != (const LineKey& rhs) const { return cell != rhs.cell; }
+};
+
+/**
+ * Returns the grid cell of a canonical line.
+ */
+template<typename T, typename Derived>
+LineKey quantize(const PluckerBase<T, Derived>& canonical, T cell_size)
+{
+    LineKey key;
+    for(auto i = 0; i < 6; i++)
+        key.cell[static_cast<std::size_t>(i)] = static_cast<std::int64_t>(std::floor(canonical.coord()(i) / cell_size));
+    return key;
+}
+
+}   // namespace plucker
+
+namespace std
+{
+
+template<>
+struct hash<plucker::LineKey>
+{
+    std::size_t operator () (const plucker::LineKey& key) const noexcept
+    {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for(const auto c : key.cell)
+        {
+            h ^= static_cast<std::uint64_t>(c) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            h *= 0x100000001b3ull;
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+
+}   // namespace std
+
+namespace plucker
+{
+
+/**
+ * Set of distinct lines.
+ *
+ * Two lines are the same if their canonical coordinates are element-wise
+ * equal within tolerance. Lines are bucketed by their grid cell, and a
+ * lookup visits only the neighboring cells the tolerance can reach.
+ */
+template<typename T>
+class LineSet
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using container_type = std::vector<Plucker<T>, Eigen::aligned_allocator<Plucker<T>>>;
+
+/* Constructors */
+    explicit LineSet(T tolerance)
+        : tolerance_(tolerance),
+          cell_size_(static_cast<T>(4) * tolerance)
+    {
+        assert(tolerance > static_cast<T>(0));
+    }
+
+/* Accessors */
+    T tolerance() const noexcept { return tolerance_; }
+    size_type size() const noexcept { return lines_.size(); }
+    bool empty() const noexcept { return lines_.empty(); }
+    /**
+     * Returns the canonical lines in insertion order.
+     */
+    const container_type& lines() const noexcept { return lines_; }
+    const Plucker<T>& operator [] (size_type i) const { return lines_[i]; }
+
+/* Modifiers */
+    /**
+     * Inserts a line unless the same line is already in the set.
+     * Returns the index of the line in the set, and whether it was inserted.
+     */
+    template<typename Derived>
+    std::pair<size_type, bool> insert(const PluckerBase<T, Derived>& p);
+    void reserve(size_type n);
+    void clear() noexcept;
+
+/* Queries */
+    /**
+     * Returns the index of the same line in the set.
+     */
+    template<typename Derived>
+    std::tuple<bool, size_type> find(const PluckerBase<T, Derived>& p) const;
+
+private:
+    std::tuple<bool, size_type> find_canonical(const Plucker<T>& canonical) const;
+    std::tuple<bool, size_type> find_in_neighbors(const Plucker<T>& canonical) const;
+    bool is_sign_ambiguous(const Plucker<T>& canonical) const;
+
+private:
+    T tolerance_;
+    T cell_size_;
+    container_type lines_;
+    std::unordered_map<LineKey, std::vector<size_type>> buckets_;
+};
+
+/* Modifiers */
+
+template<typename T>
+template<typename Derived>
+std::pair<typename LineSet<T>::size_type, bool>
+LineSet<T>::insert(const PluckerBase<T, Derived>& p)
+{
+    const auto canonical = canonicalize(p);
+
+    const auto res = find_canonical(canonical);
+    if(std::get<0>(res))
+        return std::make_pair(std::get<1>(res), false);
+
+    const auto index = lines_.size();
+    lines_.push_back(canonical);
+    buckets_[quantize(canonical, cell_size_)].push_back(index);
+    return std::make_pair(index, true);
+}
+
+template<typename T>
+void
+LineSet<T>::reserve(size_type n)
+{
+    lines_.reserve(n);
+    buckets_.reserve(n);
+}
+
+template<typename T>
+void
+LineSet<T>::clear() noexcept
+{
+    lines_.clear();
+    buckets_.clear();
+}
+
+/* Queries */
+
+template<typename T>
+template<typename Derived>
+std::tuple<bool, typename LineSet<T>::size_type>
+LineSet<T>::find(const PluckerBase<T, Derived>& p) const
+{
+    return find_canonical(canonicalize(p));
+}
+
+template<typename T>
+std::tuple<bool, typename LineSet<T>::size_type>
+LineSet<T>::find_canonical(const Plucker<T>& canonical) const
+{
+    const auto res = find_in_neighbors(canonical);
+    if(std::get<0>(res) || !is_sign_ambiguous(canonical))
+        return res;
+
+    // The sign convention may have flipped for a nearby line.
+    return find_in_neighbors(-canonical);
+}
+
+template<typename T>
+std::tuple<bool, typename LineSet<T>::size_type>
+LineSet<T>::find_in_neighbors(const Plucker<T>& canonical) const
+{
+    const auto key = quantize(canonical, cell_size_);
+
+    // Offsets to visit along each axis: the own cell, and at most one neighbor.
+    std::array<std::array<std::int64_t, 2>, 6> offsets;
+    std::array<std::size_t, 6> counts;
+    for(std::size_t i = 0; i < 6; i++)
+    {
+        const auto c = canonical.coord()(static_cast<Eigen::Index>(i));
+        const auto f = c - static_cast<T>(key.cell[i]) * cell_size_;
+        offsets[i][0] = 0;
+        offsets[i][1] = (f < tolerance_) ? -1 : 1;
+        counts[i] = (f < tolerance_ || f > cell_size_ - tolerance_) ? 2 : 1;
+    }
+
+    std::array<std::size_t, 6> digits = {{0, 0, 0, 0, 0, 0}};
+    for(;;)
+    {
+        LineKey neighbor;
+        for(std::size_t i = 0; i < 6; i++)
+            neighbor.cell[i] = key.cell[i] + offsets[i][digits[i]];
+
+        const auto it = buckets_.find(neighbor);
+        if(it != buckets_.end())
+        {
+            for(const auto index : it->second)
+            {
+                const auto diff = (lines_[index].coord() - canonical.coord()).cwiseAbs().maxCoeff();
+                if(diff <= tolerance_)
+                    return std::make_tuple(true, index);
+            }
+        }
+
+        // Advances the mixed-radix counter over the neighbor offsets.
+        std::size_t i = 0;
+        for(; i < 6; i++)
+        {
+            if(++digits[i] < counts[i])
+                break;
+            digits[i] = 0;
+        }
+        if(i == 6)
+            break;
+    }
+
+    return std::make_tuple(false, size_type(0));
+}
+
+template<typename T>
+bool
+LineSet<T>::is_sign_ambiguous(const Plucker<T>& canonical) const
+{
+    const auto l = canonical.l().cwiseAbs().eval();
+    const auto max = l.maxCoeff();
+    return ((l.array() >= max - static_cast<T>(2) * tolerance_).count() > 1);
+}
+
+}   // namespace plucker
@@ -0,0 +1,176 @@
+/**
+ * @file plucker/occlusion.h
+ * @brief This file provides line of sight queries against triangle meshes.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "edge_mesh.h"
+#include "parallel.h"
+#include "segment.h"
+
+namespace plucker
+{
+
+/**
+ * Any-hit queries of segments against a mesh, which must outlive the query.
+ *
+ * Triangles block a segment from either side. A triangle is tested only if
+ * the endpoints lie strictly on opposite sides of its plane, which clips the
+ * line to the open segment and rejects most triangles with one dot product each.
+ * Only the remaining ones take the products of the line with their three edges,
+ * and a query stops at the first hit.
+ */
+template<typename T>
+class OcclusionQuery
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using size_type = typename EdgeMesh<T>::size_type;
+
+/* Constructors */
+    explicit OcclusionQuery(const EdgeMesh<T>& mesh);
+
+/* Accessors */
+    const EdgeMesh<T>& mesh() const noexcept { return *mesh_; }
+    /**
+     * Returns the plane of each triangle, one per row: (n.x, n.y, n.z, d) with `n.dot(x) + d = 0` on the plane.
+     */
+    const Vector4Batch<T>& planes() const noexcept { return planes_; }
+
+/* Queries */
+    /**
+     * Returns true if any triangle blocks the segment `from -> to`.
+     */
+    bool is_occluded(const Vector3<T>& from, const Vector3<T>& to) const;
+    /**
+     * Returns true if any triangle blocks a segment.
+     */
+    bool is_occluded(const Segment<T>& segment) const { return is_occluded(segment.p0(), segment.p1()); }
+    /**
+     * Tests all segments of a batch.
+     * e.g. Bit `k % 64` of `res[k / 64]` is set if segment k is blocked.
+     * e.g. `num_threads == 0` means the number of hardware threads.
+     */
+    void is_occluded(const SegmentBatch<T>& segments, std::vector<std::uint64_t>& res, unsigned num_threads = 0) const;
+
+private:
+    /**
+     * Returns true if a line hits a triangle from either side.
+     */
+    template<typename Derived>
+    bool crosses(const PluckerBase<T, Derived>& line, size_type t) const;
+
+private:
+    const EdgeMesh<T>* mesh_;
+    Vector4Batch<T> planes_;
+};
+
+/* Constructors */
+
+template<typename T>
+OcclusionQuery<T>::OcclusionQuery(const EdgeMesh<T>& mesh)
+    : mesh_(&mesh),
+      planes_(static_cast<Eigen::Index>(mesh.triangle_count()), 4)
+{
+    const auto& triangles = mesh.triangles();
+    for(Eigen::Index t = 0; t < triangles.rows(); t++)
+    {
+        const Vector3<T> p1 = mesh.vertex(triangles(t, 0));
+        const Vector3<T> p2 = mesh.vertex(triangles(t, 1));
+        const Vector3<T> p3 = mesh.vertex(triangles(t, 2));
+        const Vector3<T> n = (p2 - p1).cross(p3 - p1);
+        planes_.row(t) << n.transpose(), -n.dot(p1);
+    }
+}
+
+/* Queries */
+
+template<typename T>
+template<typename Derived>
+bool
+OcclusionQuery<T>::crosses(const PluckerBase<T, Derived>& line, size_type t) const
+{
+    auto negative = false;
+    auto positive = false;
+    for(auto i = 0; i < 3; i++)
+    {
+        const auto product = line * mesh_->triangle_edge(t, i);
+        negative = negative || (product < static_cast<T>(0));
+        positive = positive || (product > static_cast<T>(0));
+        if(negative && positive)
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+bool
+OcclusionQuery<T>::is_occluded(const Vector3<T>& from, const Vector3<T>& to) const
+{
+    constexpr Eigen::Index block = 256;
+
+    const Vector4<T> a = from.homogeneous();
+    const Vector4<T> b = to.homogeneous();
+    const Plucker<T> line(a, b);
+
+    // The sides of a block stay on the stack.
+    Eigen::Matrix<T, block, 1> side_a;
+    Eigen::Matrix<T, block, 1> side_b;
+
+    const auto rows = planes_.rows();
+    for(Eigen::Index first = 0; first < rows; first += block)
+    {
+        const auto n = std::min(block, rows - first);
+        const auto planes = planes_.middleRows(first, n);
+        side_a.head(n).noalias() = planes * a;
+        side_b.head(n).noalias() = planes * b;
+        for(Eigen::Index i = 0; i < n; i++)
+        {
+            if(side_a(i) * side_b(i) >= static_cast<T>(0))
+                continue;
+
+            if(crosses(line, static_cast<size_type>(first + i)))
+                return true;
+        }
+    }
+    return false;
+}
+
+template<typename T>
+void
+OcclusionQuery<T>::is_occluded(const SegmentBatch<T>& segments, std::vector<std::uint64_t>& res, unsigned num_threads) const
+{
+    const auto count = static_cast<std::size_t>(segments.rows());
+    const auto words = (count + 63) / 64;
+    res.assign(words, 0);
+
+    // Each thread owns whole words of the mask.
+    detail::parallel_for(words, num_threads,
+        [&](std::size_t first, std::size_t last, unsigned)
+        {
+            for(auto w = first; w < last; w++)
+            {
+                std::uint64_t mask = 0;
+                const auto end = std::min(count, 64 * (w + 1));
+                for(auto k = 64 * w; k < end; k++)
+                {
+                    const auto row = static_cast<Eigen::Index>(k);
+                    const Vector3<T> from = segments.row(row).template head<3>().transpose();
+                    const Vector3<T> to = segments.row(row).template tail<3>().transpose();
+                    if(is_occluded(from, to))
+                        mask |= std::uint64_t(1) << (k % 64);
+                }
+                res[w] = mask;
+            }
+        });
+}
+
+}   // namespace plucker
@@ -0,0 +1,67 @@
+/**
+ * @file plucker/parallel.h
+ * @brief This file provides helpers for running batch work on threads.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace plucker
+{
+
+namespace detail
+{
+
+/**
+ * Returns the number of threads to use for `count` work items.
+ * e.g. `requested == 0` means the number of hardware threads.
+ */
+inline unsigned
+thread_count(unsigned requested, std::size_t count)
+{
+    if(requested == 0)
+        requested = std::max(std::thread::hardware_concurrency(), 1u);
+
+    return static_cast<unsigned>(std::min<std::size_t>(requested, std::max<std::size_t>(count, 1)));
+}
+
+/**
+ * Splits [0, count) into contiguous ranges and calls
+ * `func(first, last, thread_index)` once per range.
+ * The calling thread processes the first range.
+ */
+template<typename Function>
+void
+parallel_for(std::size_t count, unsigned num_threads, Function func)
+{
+    const auto threads = thread_count(num_threads, count);
+    if(threads <= 1)
+    {
+        func(std::size_t(0), count, 0u);
+        return;
+    }
+
+    const auto chunk = count / threads;
+    const auto remainder = count % threads;
+    const auto first_of = [chunk, remainder](std::size_t i)
+    {
+        return i * chunk + std::min(i, remainder);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for(auto i = 1u; i < threads; i++)
+        workers.emplace_back(func, first_of(i), first_of(i + 1), i);
+
+    func(first_of(0), first_of(1), 0u);
+
+    for(auto& worker : workers)
+        worker.join();
+}
+
+}   // namespace detail
+
+}   // namespace plucker
@@ -1,16 +1,42 @@
 /**
  * @file plucker/plane.h
  */
+#include <cstdint>
+#include <type_traits>
 #include <Eigen/Core>
 
 namespace plucker
 {
 
+/**
+ * Common interface of planes, owning their coordinates or not.
+ * e.g. Functions taking `const PlaneBase<T, Derived>&` accept a Plane and a PlaneView.
+ */
+template<typename T, typename Derived>
+class PlaneBase
+{
+public:
+    using value_type = T;
+
+/* Accessors */
+    T a() const noexcept { return derived().coord()(0); }
+    T b() const noexcept { return derived().coord()(1); }
+    T c() const noexcept { return derived().coord()(2); }
+    T d() const noexcept { return derived().coord()(3); }
+
+    Eigen::Ref<const Eigen::Matrix<T, 3, 1>> normal() const noexcept { return derived().coord().template head<3>(); }
+
+    Eigen::Ref<const Eigen::Matrix<T, 4, 1>> coord() const noexcept { return derived().coord(); }
+
+    const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
+};
+
 template<typename T>
 class Plane
+    : public PlaneBase<T, Plane<T>>
 {
-    static_assert(std::is_floating_point<T>::value,
-        "Template parameter T must be floating_point type.");
+    static_assert(std::is_floating_point<T>::value || std::is_same<T, std::int64_t>::value,
+        "Template parameter T must be floating_point type or std::int64_t.");
 public:
     using value_type = T;
     using Vector3 = Eigen::Matrix<T, 3, 1>;
@@ -59,4 +85,35 @@ private:
     Vector4 coord_;
 };
 
+/**
+ * Coordinates of a plane in external memory, i.e. four consecutive values (a, b, c, d).
+ * e.g. `PlaneView<const T>` is read-only.
+ */
+template<typename T>
+class PlaneView
+    : public PlaneBase<typename std::remove_const<T>::type, PlaneView<T>>
+{
+public:
+    using value_type = typename std::remove_const<T>::type;
+    using Vector4 = Eigen::Matrix<value_type, 4, 1>;
+    using Map = Eigen::Map<typename std::conditional<std::is_const<T>::value, const Vector4, Vector4>::type>;
+
+/* Constructors */
+    explicit PlaneView(T* data)
+        : coord_(data)
+    {}
+
+    explicit PlaneView(typename std::conditional<std::is_const<T>::value,
+        const Plane<value_type>, Plane<value_type>>::type& plane)
+        : coord_(plane.coord().data())
+    {}
+
+/* Accessors */
+    const Map& coord() const noexcept { return coord_; }
+    Map& coord() noexcept { return coord_; }
+
+private:
+    Map coord_;
+};
+
 }   // namespace plucker
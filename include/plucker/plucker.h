@@ -8,3 +8,27 @@
 #include "plucker_query.h"
 #include "plucker_geometric.h"
 #include "plucker_find.h"
+#include "line_fitter.h"
+#include "plucker_batch.h"
+#include "ransac.h"
+#include "line_set.h"
+#include "line_intersector.h"
+#include "triangulation.h"
+#include "edge_mesh.h"
+#include "aligned_box.h"
+#include "convex_polygon.h"
+#include "primitives.h"
+#include "segment.h"
+#include "edge_collision.h"
+#include "occlusion.h"
+#include "ray_hit.h"
+#include "uniform_grid.h"
+#include "clipping.h"
+#include "polytope.h"
+#include "half.h"
+#include "exact.h"
+#include "camera.h"
+#include "rasterizer.h"
+#include "closest_approach.h"
+#include "homogeneous.h"
+#include "dispatch.h"
@@ -3,6 +3,8 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <type_traits>
 #include <Eigen/Geometry>
 
 namespace plucker
@@ -17,14 +19,34 @@ using Vector4 = Eigen::Matrix<T, 4, 1>;
 template<typename T>
 using Vector6 = Eigen::Matrix<T, 6, 1>;
 
+/**
+ * Common interface of lines, owning their coordinates or not.
+ * e.g. Functions taking `const PluckerBase<T, Derived>&` accept a Plucker and a PluckerView.
+ */
+template<typename T, typename Derived>
+class PluckerBase
+{
+public:
+    using value_type = T;
+
+/* Accessors */
+    Eigen::Ref<const Vector3<T>> l() const noexcept { return derived().coord().template head<3>(); }
+    Eigen::Ref<const Vector3<T>> m() const noexcept { return derived().coord().template tail<3>(); }
+
+    Eigen::Ref<const Vector6<T>> coord() const noexcept { return derived().coord(); }
+
+    const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
+};
+
 /**
  * Plucker coordinates of a line.
  */
 template<typename T>
 class Plucker
+    : public PluckerBase<T, Plucker<T>>
 {
-    static_assert(std::is_floating_point<T>::value,
-        "Template parameter T must be floating_point type.");
+    static_assert(std::is_floating_point<T>::value || std::is_same<T, std::int64_t>::value,
+        "Template parameter T must be floating_point type or std::int64_t.");
 public:
     using value_type = T;
 
@@ -82,47 +104,85 @@ Plucker<T>::operator *= (T rhs)
     return *this;
 }
 
+/**
+ * Plucker coordinates of a line in external memory, i.e. six consecutive values (l:m).
+ * e.g. `PluckerView<const T>` is read-only.
+ */
+template<typename T>
+class PluckerView
+    : public PluckerBase<typename std::remove_const<T>::type, PluckerView<T>>
+{
+public:
+    using value_type = typename std::remove_const<T>::type;
+    using Map = Eigen::Map<typename std::conditional<std::is_const<T>::value,
+        const Vector6<value_type>, Vector6<value_type>>::type>;
+
+/* Constructors */
+    explicit PluckerView(T* data)
+        : coord_(data)
+    {}
+
+    explicit PluckerView(typename std::conditional<std::is_const<T>::value,
+        const Plucker<value_type>, Plucker<value_type>>::type& p)
+        : coord_(p.coord().data())
+    {}
+
+/* Accessors */
+    const Map& coord() const noexcept { return coord_; }
+    Map& coord() noexcept { return coord_; }
+
+private:
+    Map coord_;
+};
+
 /* Unary operators */
 
-template<typename T>
+template<typename T, typename Derived>
 Plucker<T>
-operator + (const Plucker<T>& p)
+operator + (const PluckerBase<T, Derived>& p)
 {
-    return p;
+    return Plucker<T>(p.coord());
 }
 
-template<typename T>
+template<typename T, typename Derived>
 Plucker<T>
-operator - (const Plucker<T>& p)
+operator - (const PluckerBase<T, Derived>& p)
 {
     return Plucker<T>(-p.coord());
 }
 
 /* Binary operators */
 
-template<typename T>
+template<typename T, typename Derived>
 Plucker<T>
-operator * (const Plucker<T>& lhs, T rhs)
+operator * (const PluckerBase<T, Derived>& lhs, T rhs)
 {
-    Plucker<T> temp(lhs);
+    Plucker<T> temp(lhs.coord());
     return temp *= rhs;
 }
 
-template<typename T>
+template<typename T, typename Derived>
 Plucker<T>
-operator * (T lhs, const Plucker<T>& rhs)
+operator * (T lhs, const PluckerBase<T, Derived>& rhs)
 {
-    Plucker<T> temp(rhs);
+    Plucker<T> temp(rhs.coord());
     return temp *= lhs;
 }
 
 /**
  * Computes the reciprocal product of two lines.
  */
-template<typename T>
-T operator * (const Plucker<T>& lhs, const Plucker<T>& rhs)
+template<typename T, typename Derived1, typename Derived2>
+T operator * (const PluckerBase<T, Derived1>& lhs, const PluckerBase<T, Derived2>& rhs)
 {
     return lhs.l().dot(rhs.m()) + rhs.l().dot(lhs.m());
 }
 
+/**
+ * The reciprocal product of lines of std::int64_t coordinates overflows 64 bits,
+ * so they are multiplied by `exact_product` of exact.h.
+ */
+template<typename Derived1, typename Derived2>
+std::int64_t operator * (const PluckerBase<std::int64_t, Derived1>& lhs, const PluckerBase<std::int64_t, Derived2>& rhs) = delete;
+
 }   // namespace plucker
@@ -0,0 +1,129 @@
+/**
+ * @file plucker/plucker_batch.h
+ * @brief This file provides batch functions for plucker types.
+ *
+ * Batches are stored as structure of arrays: one element per row,
+ * one coordinate per column, so each coordinate is contiguous.
+ */
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "plucker_base.h"
+
+namespace plucker
+{
+
+template<typename T>
+using VectorX = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+template<typename T>
+using Vector3Batch = Eigen::Matrix<T, Eigen::Dynamic, 3>;
+
+template<typename T>
+using Vector4Batch = Eigen::Matrix<T, Eigen::Dynamic, 4>;
+
+template<typename T>
+using PluckerBatch = Eigen::Matrix<T, Eigen::Dynamic, 6>;
+
+namespace detail
+{
+
+template<typename T>
+struct identity
+{
+    using type = T;
+};
+
+/**
+ * Joins per-thread coordinates of 3D points, three per point,
+ * into one batch with offsets, e.g. group `k` of `sizes` in thread order
+ * becomes rows [res_offsets[k], res_offsets[k + 1]).
+ */
+template<typename T>
+void join_rows(
+    const std::vector<std::vector<T>>& partial_coords,
+    const std::vector<std::vector<std::size_t>>& partial_sizes,
+    Eigen::Matrix<T, Eigen::Dynamic, 3>& res,
+    std::vector<std::size_t>& res_offsets)
+{
+    using RowMajor = Eigen::Matrix<T, Eigen::Dynamic, 3, Eigen::RowMajor>;
+
+    Eigen::Index total = 0;
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < partial_coords.size(); i++)
+    {
+        total += static_cast<Eigen::Index>(partial_coords[i].size() / 3);
+        count += partial_sizes[i].size();
+    }
+
+    res.resize(total, 3);
+    res_offsets.resize(count + 1);
+    res_offsets[0] = 0;
+
+    Eigen::Index row = 0;
+    std::size_t k = 0;
+    for(std::size_t i = 0; i < partial_coords.size(); i++)
+    {
+        const auto n = static_cast<Eigen::Index>(partial_coords[i].size() / 3);
+        res.middleRows(row, n) = Eigen::Map<const RowMajor>(partial_coords[i].data(), n, 3);
+        row += n;
+        for(const auto size : partial_sizes[i])
+        {
+            res_offsets[k + 1] = res_offsets[k] + size;
+            k++;
+        }
+    }
+}
+
+}   // namespace detail
+
+/**
+ * Writable reference to a column of results.
+ * Note: Does not take part in template argument deduction.
+ */
+template<typename T>
+using VectorXRef = Eigen::Ref<typename detail::identity<VectorX<T>>::type>;
+
+/**
+ * Computes the squared distances from points to a line.
+ * e.g. Each row of `points` is a point.
+ */
+template<typename T, typename Derived1, typename Derived2>
+void squared_distance(
+    const PluckerBase<T, Derived1>& line,
+    const Eigen::MatrixBase<Derived2>& points,
+    VectorXRef<T> res)
+{
+    assert(points.cols() == 3);
+    assert(points.rows() == res.rows());
+
+    const Vector3<T> l = line.l();
+    const Vector3<T> m = line.m();
+    const auto x = points.col(0).array();
+    const auto y = points.col(1).array();
+    const auto z = points.col(2).array();
+
+    // The moment of the line about each point, i.e. m - p x l.
+    res.array() = ((m.x() - (y * l.z() - z * l.y())).square()
+                 + (m.y() - (z * l.x() - x * l.z())).square()
+                 + (m.z() - (x * l.y() - y * l.x())).square()) / l.squaredNorm();
+}
+
+/**
+ * Computes the shortest distances from points to a line.
+ * e.g. Each row of `points` is a point.
+ */
+template<typename T, typename Derived1, typename Derived2>
+void distance(
+    const PluckerBase<T, Derived1>& line,
+    const Eigen::MatrixBase<Derived2>& points,
+    VectorXRef<T> res)
+{
+    squared_distance(line, points, res);
+    res = res.array().sqrt();
+}
+
+}   // namespace plucker
@@ -11,8 +11,8 @@ namespace plucker
  * Returns the moment of a line about a line.
  * Note: Needs normalized lines.
  */
-template<typename T>
-T moment(const Plucker<T>& p1, const Plucker<T>& p2)
+template<typename T, typename Derived1, typename Derived2>
+T moment(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2)
 {
     return p1 * p2;
 }
@@ -21,8 +21,8 @@ T moment(const Plucker<T>& p1, const Plucker<T>& p2)
  * Returns the moment of a line about a point.
  * Note: Needs a normalized line.
  */
-template<typename T>
-Vector3<T> moment(const Plucker<T>& line, const Vector3<T>& point)
+template<typename T, typename Derived>
+Vector3<T> moment(const PluckerBase<T, Derived>& line, const Vector3<T>& point)
 {
     return line.m() - point.cross(line.l());
 }
@@ -31,8 +31,8 @@ Vector3<T> moment(const Plucker<T>& line, const Vector3<T>& point)
  * Returns the closest point on a line to a point.
  * Note: Needs a normalized line.
  */
-template<typename T>
-Vector3<T> closest_point(const Plucker<T>& line, const Vector3<T>& point)
+template<typename T, typename Derived>
+Vector3<T> closest_point(const PluckerBase<T, Derived>& line, const Vector3<T>& point)
 {
     const auto m = moment(line, point);
     return point + line.l().cross(m);
@@ -41,8 +41,8 @@ Vector3<T> closest_point(const Plucker<T>& line, const Vector3<T>& point)
 /**
  * Returns the closest point on a line to the origin.
  */
-template<typename T>
-Vector4<T> closest_point(const Plucker<T>& p)
+template<typename T, typename Derived>
+Vector4<T> closest_point(const PluckerBase<T, Derived>& p)
 {
     Vector4<T> res;
     res << p.l().cross(p.m()), p.l().squaredNorm();
@@ -52,8 +52,8 @@ Vector4<T> closest_point(const Plucker<T>& p)
 /**
  * Returns a point on a line.
  */
-template<typename T>
-Vector4<T> point_on_line(const Plucker<T>& p, T t)
+template<typename T, typename Derived>
+Vector4<T> point_on_line(const PluckerBase<T, Derived>& p, T t)
 {
     Vector4<T> res;
     res << p.l().cross(p.m()) + t * p.l(), p.l().squaredNorm();
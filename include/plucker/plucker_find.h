@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tuple>
+#include <type_traits>
 #include "plucker_query.h"
 
 namespace plucker
@@ -13,10 +14,12 @@ namespace plucker
 /**
  * Returns the intersection of two lines.
  */
-template<typename T>
+template<typename T, typename Derived1, typename Derived2>
 std::tuple<bool, Vector4<T>>
-find_intersection(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+find_intersection(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(!are_coplanar(p1, p2, tolerance) || are_parallel(p1, p2, tolerance))
         return std::make_tuple(false, Vector4<T>());
 
@@ -31,10 +34,12 @@ find_intersection(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
 /**
  * Returns the intersection of a line and a plane.
  */
-template<typename T>
+template<typename T, typename Derived1, typename Derived2>
 std::tuple<bool, Vector4<T>>
-find_intersection(const Plucker<T>& line, const Plane<T>& plane, T tolerance)
+find_intersection(const PluckerBase<T, Derived1>& line, const PlaneBase<T, Derived2>& plane, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     const Vector3<T> n = plane.normal();
     if(detail::are_perpendicular(line.l().eval(), n, tolerance))
         return std::make_tuple(false, Vector4<T>());
@@ -48,10 +53,12 @@ find_intersection(const Plucker<T>& line, const Plane<T>& plane, T tolerance)
 /**
  * Returns the intersection of two planes.
  */
-template<typename T>
+template<typename T, typename Derived1, typename Derived2>
 std::tuple<bool, Plucker<T>>
-find_intersection(const Plane<T>& plane1, const Plane<T>& plane2, T tolerance)
+find_intersection(const PlaneBase<T, Derived1>& plane1, const PlaneBase<T, Derived2>& plane2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     const Vector3<T> n1 = plane1.normal();
     const Vector3<T> n2 = plane2.normal();
     if(detail::are_parallel(n1, n2, tolerance))
@@ -60,13 +67,38 @@ find_intersection(const Plane<T>& plane1, const Plane<T>& plane2, T tolerance)
     return std::make_tuple(true, Plucker<T>(n1.cross(n2), plane2.d() * n1 - plane1.d() * n2));
 }
 
+/**
+ * Returns the intersection of three planes.
+ */
+template<typename T, typename Derived1, typename Derived2, typename Derived3>
+std::tuple<bool, Vector4<T>>
+find_intersection(const PlaneBase<T, Derived1>& plane1, const PlaneBase<T, Derived2>& plane2, const PlaneBase<T, Derived3>& plane3, T tolerance)
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+    const Vector3<T> n1 = plane1.normal();
+    const Vector3<T> n2 = plane2.normal();
+    const Vector3<T> n3 = plane3.normal();
+    const Vector3<T> n23 = n2.cross(n3);
+    const auto w = n1.dot(n23);
+    if(detail::almost_zero(w, tolerance))
+        return std::make_tuple(false, Vector4<T>());
+
+    Vector4<T> point;
+    point << - (plane1.d() * n23 + plane2.d() * n3.cross(n1) + plane3.d() * n1.cross(n2)), w;
+
+    return std::make_tuple(true, point);
+}
+
 /**
  * Returns points on two skew lines closest to one another.
  */
-template<typename T>
+template<typename T, typename Derived1, typename Derived2>
 std::tuple<bool, Vector4<T>, Vector4<T>>
-find_closest_points(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+find_closest_points(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(are_parallel(p1, p2, tolerance))
         return std::make_tuple(false, Vector4<T>(), Vector4<T>());
 
@@ -85,10 +117,12 @@ find_closest_points(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
 /**
  * Returns an origin plane through a line.
  */
-template<typename T>
+template<typename T, typename Derived>
 std::tuple<bool, Plane<T>>
-find_origin_plane_through_line(const Plucker<T>& p, T tolerance)
+find_origin_plane_through_line(const PluckerBase<T, Derived>& p, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(passes_through_origin(p, tolerance))
         return std::make_tuple(false, Plane<T>());
 
@@ -98,10 +132,12 @@ find_origin_plane_through_line(const Plucker<T>& p, T tolerance)
 /**
  * Returns a plane through a line.
  */
-template<typename T>
+template<typename T, typename Derived>
 std::tuple<bool, Plane<T>>
-find_plane_through_line(const Plucker<T>& p, T tolerance)
+find_plane_through_line(const PluckerBase<T, Derived>& p, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(passes_through_origin(p, tolerance))
         return std::make_tuple(false, Plane<T>());
 
@@ -112,10 +148,12 @@ find_plane_through_line(const Plucker<T>& p, T tolerance)
  * Returns the common plane of a line and a point.
  * e.g. (P:w) is a point.
  */
-template<typename T>
+template<typename T, typename Derived>
 std::tuple<bool, Plane<T>>
-find_common_plane(const Plucker<T>& line, const Vector4<T>& point, T tolerance)
+find_common_plane(const PluckerBase<T, Derived>& line, const Vector4<T>& point, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(contains(line, point, tolerance))
         return std::make_tuple(false, Plane<T>());
 
@@ -130,10 +168,12 @@ find_common_plane(const Plucker<T>& line, const Vector4<T>& point, T tolerance)
 /**
  * Returns the common plane of a line and a vector.
  */
-template<typename T>
+template<typename T, typename Derived>
 std::tuple<bool, Plane<T>>
-find_common_plane(const Plucker<T>& line, const Vector3<T>& vector, T tolerance)
+find_common_plane(const PluckerBase<T, Derived>& line, const Vector3<T>& vector, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(detail::are_parallel(line.l().eval(), vector, tolerance))
         return std::make_tuple(false, Plane<T>());
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cmath>
+#include <type_traits>
 #include "plucker_query.h"
 
 namespace plucker
@@ -13,45 +14,71 @@ namespace plucker
 /**
  * Returns a normalized line.
  */
-template<typename T>
-Plucker<T> normalize(const Plucker<T>& p)
+template<typename T, typename Derived>
+Plucker<T> normalize(const PluckerBase<T, Derived>& p)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return Plucker<T>(p.coord() / p.l().norm());
 }
 
+/**
+ * Returns the canonical form of a line.
+ * The direction is normalized, and its largest component in magnitude is positive.
+ * Note: Needs a line not at infinity.
+ */
+template<typename T, typename Derived>
+Plucker<T> canonicalize(const PluckerBase<T, Derived>& p)
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+    Eigen::Index i;
+    p.l().cwiseAbs().maxCoeff(&i);
+    const auto norm = p.l().norm();
+    return Plucker<T>(p.coord() / ((p.l()(i) < static_cast<T>(0)) ? -norm : norm));
+}
+
 /**
  * Returns the squared distance from the origin to a line.
  */
-template<typename T>
-T squared_distance(const Plucker<T>& p)
+template<typename T, typename Derived>
+T squared_distance(const PluckerBase<T, Derived>& p)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return p.m().squaredNorm() / p.l().squaredNorm();
 }
 
 /**
  * Returns the distance from the origin to a line.
  */
-template<typename T>
-T distance(const Plucker<T>& p)
+template<typename T, typename Derived>
+T distance(const PluckerBase<T, Derived>& p)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return std::sqrt(squared_distance(p));
 }
 
 /**
  * Returns the distance of between skew lines.
  */
-template<typename T>
-T distance_of_between_skew_lines(const Plucker<T>& p1, const Plucker<T>& p2)
+template<typename T, typename Derived1, typename Derived2>
+T distance_of_between_skew_lines(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return std::abs(p1 * p2) / p1.l().cross(p2.l()).norm();
 }
 
 /**
  * Returns the distance of between two parallel lines.
  */
-template<typename T>
-T distance_of_between_two_parallel_lines(const Plucker<T>& p1, const Plucker<T>& p2)
+template<typename T, typename Derived1, typename Derived2>
+T distance_of_between_two_parallel_lines(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     const auto s = (p1.l().dot(p2.l()) < static_cast<T>(0)) ?
          - p2.l().norm() / p1.l().norm() : p2.l().norm() / p1.l().norm();
     return p1.l().cross(p1.m() - p2.m() / s).norm() / p1.l().squaredNorm();
@@ -60,9 +87,11 @@ T distance_of_between_two_parallel_lines(const Plucker<T>& p1, const Plucker<T>&
 /**
  * Returns the shortest distance between two lines.
  */
-template<typename T>
-T distance(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+T distance(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return are_parallel(p1, p2, tolerance) ?
         distance_of_between_two_parallel_lines(p1, p2) : distance_of_between_skew_lines(p1, p2);
 }
@@ -70,9 +99,11 @@ T distance(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
 /**
  * Returns the shortest distance from a point to a line.
  */
-template<typename T>
-T distance(const Plucker<T>& line, const Vector4<T>& point, T tolerance)
+template<typename T, typename Derived>
+T distance(const PluckerBase<T, Derived>& line, const Vector4<T>& point, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(contains(line, point, tolerance))
         return static_cast<T>(0);
 
@@ -87,9 +118,11 @@ T distance(const Plucker<T>& line, const Vector4<T>& point, T tolerance)
  * Returns the shortest distance from a point to a line.
  * Note: Needs a normalized line.
  */
-template<typename T>
-T distance(const Plucker<T>& line, const Vector3<T>& point)
+template<typename T, typename Derived>
+T distance(const PluckerBase<T, Derived>& line, const Vector3<T>& point)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     const Vector3<T> moment = line.m() - point.cross(line.l());
     const Vector3<T> p_perp = point + line.l().cross(moment);
     return (p_perp - point).norm();
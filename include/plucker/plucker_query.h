@@ -6,6 +6,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <type_traits>
 #include "relational.h"
 #include "mat_relational.h"
 #include "plane.h"
@@ -39,27 +40,33 @@ bool are_parallel(const Vector3<T>& v1, const Vector3<T>& v2, T tolerance)
 /**
  * Returns true if a line is at infinity.
  */
-template<typename T>
-bool is_at_infinity(const Plucker<T>& p, T tolerance)
+template<typename T, typename Derived>
+bool is_at_infinity(const PluckerBase<T, Derived>& p, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return detail::almost_zero(p.l(), tolerance);
 }
 
 /**
  * Returns true if a line passes through the origin.
  */
-template<typename T>
-bool passes_through_origin(const Plucker<T>& p, T tolerance)
+template<typename T, typename Derived>
+bool passes_through_origin(const PluckerBase<T, Derived>& p, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return detail::almost_zero(p.m(), tolerance);
 }
 
 /**
  * Returns true if two lines are same.
  */
-template<typename T>
-bool are_same(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+bool are_same(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(!detail::are_parallel(p1.l().eval(), p2.l().eval(), tolerance)
     || !detail::are_parallel(p1.m().eval(), p2.m().eval(), tolerance))
         return false;
@@ -77,9 +84,11 @@ bool are_same(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
 /**
  * Returns true if two lines are perpendicular.
  */
-template<typename T>
-bool are_perpendicular(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+bool are_perpendicular(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     const auto cosine = p1.l().dot(p2.l());
     return detail::almost_zero(cosine, tolerance);
 }
@@ -87,45 +96,55 @@ bool are_perpendicular(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
 /**
  * Returns true if two lines are parallel.
  */
-template<typename T>
-bool are_parallel(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+bool are_parallel(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return detail::are_parallel(p1.l().eval(), p2.l().eval(), tolerance);
 }
 
 /**
  * Returns true if two lines are coplanar.
  */
-template<typename T>
-bool are_coplanar(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+bool are_coplanar(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return detail::almost_zero(p1 * p2, tolerance);
 }
 
 /**
  * Returns true if two lines are skew.
  */
-template<typename T>
-bool are_skew(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+bool are_skew(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return !are_coplanar(p1, p2, tolerance);
 }
 
 /**
  * Returns true if two lines have intersection.
  */
-template<typename T>
-bool has_intersection(const Plucker<T>& p1, const Plucker<T>& p2, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+bool has_intersection(const PluckerBase<T, Derived1>& p1, const PluckerBase<T, Derived2>& p2, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return are_coplanar(p1, p2, tolerance) && !are_parallel(p1, p2, tolerance);
 }
 
 /**
  * Returns true if a line contains a point.
  */
-template<typename T>
-bool contains(const Plucker<T> line, const Vector4<T>& point, T tolerance)
+template<typename T, typename Derived>
+bool contains(const PluckerBase<T, Derived>& line, const Vector4<T>& point, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     const auto v = Vector3<T>(point.head(3)).cross(line.l());
     return detail::almost_equal(v, line.m().eval(), tolerance);
 }
@@ -133,18 +152,22 @@ bool contains(const Plucker<T> line, const Vector4<T>& point, T tolerance)
 /**
  * Returns true if a plane contains a point.
  */
-template<typename T>
-bool contains(const Plane<T> plane, const Vector4<T>& point, T tolerance)
+template<typename T, typename Derived>
+bool contains(const PlaneBase<T, Derived>& plane, const Vector4<T>& point, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     return detail::almost_zero(plane.coord().dot(point), tolerance);
 }
 
 /**
  * Returns true if a plane contains a line.
  */
-template<typename T>
-bool contains(const Plane<T>& plane, const Plucker<T> line, T tolerance)
+template<typename T, typename Derived1, typename Derived2>
+bool contains(const PlaneBase<T, Derived1>& plane, const PluckerBase<T, Derived2>& line, T tolerance)
 {
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
     if(!detail::are_perpendicular(plane.normal().eval(), line.l().eval(), tolerance))
         return false;
 
@@ -0,0 +1,165 @@
+/**
+ * @file plucker/polytope.h
+ * @brief This file provides vertex extraction of convex polytopes given by planes.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "plucker_find.h"
+#include "parallel.h"
+
+namespace plucker
+{
+
+/*
+ * Here, a polytope is the intersection of the half-spaces `plane.coord().dot(x) <= 0`,
+ * the same convention as clipping, with points within the tolerance kept.
+ */
+
+namespace detail
+{
+
+/**
+ * Appends the vertices of a polytope to `coords`, three coordinates per vertex,
+ * and returns the number of vertices.
+ *
+ * Every triple of planes meeting at a point gives a candidate, which is rejected
+ * at the first plane it is outside of. The plane that rejected the last candidate
+ * is tried first, as neighbouring candidates tend to be cut off by the same plane.
+ */
+template<typename T, typename Derived>
+std::size_t find_vertices(
+    const Eigen::MatrixBase<Derived>& planes,
+    T tolerance,
+    std::vector<T>& coords)
+{
+    const auto n = static_cast<std::size_t>(planes.rows());
+    const auto first = coords.size();
+
+    const auto is_outside = [&planes, tolerance](const Vector4<T>& point, std::size_t p)
+    {
+        return planes.row(static_cast<Eigen::Index>(p)).dot(point.transpose()) > tolerance;
+    };
+
+    const auto is_known = [&coords, first, tolerance](const Vector3<T>& point)
+    {
+        for(auto i = first; i < coords.size(); i += 3)
+        {
+            if(detail::almost_zero(coords[i] - point.x(), tolerance)
+                && detail::almost_zero(coords[i + 1] - point.y(), tolerance)
+                && detail::almost_zero(coords[i + 2] - point.z(), tolerance))
+                return true;
+        }
+        return false;
+    };
+
+    std::size_t last_rejecting = 0;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        const Plane<T> plane1(Vector4<T>(planes.row(static_cast<Eigen::Index>(i)).transpose()));
+        for(auto j = i + 1; j < n; j++)
+        {
+            const Plane<T> plane2(Vector4<T>(planes.row(static_cast<Eigen::Index>(j)).transpose()));
+            if(detail::are_parallel(plane1.normal().eval(), plane2.normal().eval(), tolerance))
+                continue;
+
+            for(auto k = j + 1; k < n; k++)
+            {
+                bool found;
+                Vector4<T> point;
+                std::tie(found, point) = find_intersection(plane1, plane2, Plane<T>(Vector4<T>(planes.row(static_cast<Eigen::Index>(k)).transpose())), tolerance);
+                if(!found)
+                    continue;
+
+                // The point lies on its own planes within rounding only, which grows
+                // with the plane coefficients, so they are not tested against it.
+                point /= point.w();
+                if(last_rejecting != i && last_rejecting != j && last_rejecting != k && is_outside(point, last_rejecting))
+                    continue;
+
+                auto inside = true;
+                for(std::size_t p = 0; p < n && inside; p++)
+                {
+                    if(p != i && p != j && p != k && is_outside(point, p))
+                    {
+                        last_rejecting = p;
+                        inside = false;
+                    }
+                }
+
+                const Vector3<T> vertex = point.template head<3>();
+                if(inside && !is_known(vertex))
+                {
+                    coords.push_back(vertex.x());
+                    coords.push_back(vertex.y());
+                    coords.push_back(vertex.z());
+                }
+            }
+        }
+    }
+    return (coords.size() - first) / 3;
+}
+
+}   // namespace detail
+
+/**
+ * Returns the vertices of a convex polytope, one per row,
+ * given its planes, one per row of `planes`.
+ * e.g. Vertices shared by more than three planes are reported once.
+ */
+template<typename T>
+Vector3Batch<T> find_vertices(const Vector4Batch<T>& planes, T tolerance)
+{
+    std::vector<T> coords;
+    const auto n = detail::find_vertices(planes, tolerance, coords);
+
+    using RowMajor = Eigen::Matrix<T, Eigen::Dynamic, 3, Eigen::RowMajor>;
+    return Eigen::Map<const RowMajor>(coords.data(), static_cast<Eigen::Index>(n), 3);
+}
+
+/**
+ * Finds the vertices of convex polytopes.
+ * e.g. Polytope `k` consists of the planes in rows [offsets[k], offsets[k + 1]),
+ * and its vertices are the rows [res_offsets[k], res_offsets[k + 1]) of `res_vertices`.
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ */
+template<typename T>
+void find_vertices(
+    const Vector4Batch<T>& planes,
+    const std::vector<std::size_t>& offsets,
+    T tolerance,
+    Vector3Batch<T>& res_vertices,
+    std::vector<std::size_t>& res_offsets,
+    unsigned num_threads = 0)
+{
+    assert(!offsets.empty() && offsets.back() == static_cast<std::size_t>(planes.rows()));
+
+    const auto count = offsets.size() - 1;
+    const auto threads = detail::thread_count(num_threads, count);
+    std::vector<std::vector<T>> partial_coords(threads);
+    std::vector<std::vector<std::size_t>> partial_sizes(threads);
+
+    detail::parallel_for(count, threads,
+        [&](std::size_t first, std::size_t last, unsigned thread_index)
+        {
+            auto& coords = partial_coords[thread_index];
+            auto& sizes = partial_sizes[thread_index];
+            sizes.reserve(last - first);
+
+            for(auto k = first; k < last; k++)
+            {
+                const auto row = static_cast<Eigen::Index>(offsets[k]);
+                const auto n = static_cast<Eigen::Index>(offsets[k + 1] - offsets[k]);
+                sizes.push_back(detail::find_vertices(planes.middleRows(row, n), tolerance, coords));
+            }
+        });
+
+    detail::join_rows(partial_coords, partial_sizes, res_vertices, res_offsets);
+}
+
+}   // namespace plucker
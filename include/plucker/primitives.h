@@ -0,0 +1,429 @@
+/**
+ * @file plucker/primitives.h
+ * @brief This file provides tests of lines against spheres, capsules and cylinders.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "plucker_geometric.h"
+#include "relational.h"
+
+namespace plucker
+{
+
+template<typename T>
+class Sphere
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+
+/* Constructors */
+    Sphere()
+    {}
+
+    Sphere(const Vector3<T>& center, T radius)
+        : center_(center), radius_(radius)
+    {}
+
+/* Accessors */
+    const Vector3<T>& center() const noexcept { return center_; }
+    Vector3<T>& center() noexcept { return center_; }
+    T radius() const noexcept { return radius_; }
+    T& radius() noexcept { return radius_; }
+
+private:
+    Vector3<T> center_;
+    T radius_;
+};
+
+/**
+ * Segment `p0 -> p1` swept by a sphere.
+ */
+template<typename T>
+class Capsule
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+
+/* Constructors */
+    Capsule()
+    {}
+
+    Capsule(const Vector3<T>& p0, const Vector3<T>& p1, T radius)
+        : p0_(p0), p1_(p1), radius_(radius)
+    {}
+
+/* Accessors */
+    const Vector3<T>& p0() const noexcept { return p0_; }
+    const Vector3<T>& p1() const noexcept { return p1_; }
+    Vector3<T>& p0() noexcept { return p0_; }
+    Vector3<T>& p1() noexcept { return p1_; }
+    T radius() const noexcept { return radius_; }
+    T& radius() noexcept { return radius_; }
+
+private:
+    Vector3<T> p0_;
+    Vector3<T> p1_;
+    T radius_;
+};
+
+/**
+ * Solid cylinder around the axis `p0 -> p1`, capped at both ends.
+ */
+template<typename T>
+class Cylinder
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+
+/* Constructors */
+    Cylinder()
+    {}
+
+    Cylinder(const Vector3<T>& p0, const Vector3<T>& p1, T radius)
+        : p0_(p0), p1_(p1), radius_(radius)
+    {}
+
+/* Accessors */
+    const Vector3<T>& p0() const noexcept { return p0_; }
+    const Vector3<T>& p1() const noexcept { return p1_; }
+    Vector3<T>& p0() noexcept { return p0_; }
+    Vector3<T>& p1() noexcept { return p1_; }
+    T radius() const noexcept { return radius_; }
+    T& radius() noexcept { return radius_; }
+
+private:
+    Vector3<T> p0_;
+    Vector3<T> p1_;
+    T radius_;
+};
+
+/**
+ * Returns the squared distance from a line to a segment.
+ *
+ * The moment of the line about a point of the segment `p0 + s (p1 - p0)`
+ * is linear in s, so the closest point is found without normalizing the line.
+ */
+template<typename T, typename Derived>
+T squared_distance(const PluckerBase<T, Derived>& line, const Vector3<T>& p0, const Vector3<T>& p1)
+{
+    const Vector3<T> l = line.l();
+    const Vector3<T> m0 = line.m() - p0.cross(l);
+    const Vector3<T> m1 = (p1 - p0).cross(l);
+
+    const auto den = m1.squaredNorm();
+    const auto s = (den > static_cast<T>(0)) ?
+        std::min(std::max(m0.dot(m1) / den, static_cast<T>(0)), static_cast<T>(1)) : static_cast<T>(0);
+
+    return (m0 - s * m1).squaredNorm() / l.squaredNorm();
+}
+
+/**
+ * Returns true if a line intersects a sphere.
+ */
+template<typename T, typename Derived>
+bool has_intersection(const PluckerBase<T, Derived>& line, const Sphere<T>& sphere)
+{
+    const Vector3<T> l = line.l();
+    const auto d2 = (line.m() - sphere.center().cross(l)).squaredNorm() / l.squaredNorm();
+    return d2 <= sphere.radius() * sphere.radius();
+}
+
+/**
+ * Returns the parameters where a line enters and leaves a sphere.
+ * Note: Needs a normalized line, then a point is `point_on_line(line, t)`.
+ */
+template<typename T, typename Derived>
+std::tuple<bool, T, T>
+find_intersection(const PluckerBase<T, Derived>& line, const Sphere<T>& sphere)
+{
+    const Vector3<T> l = line.l();
+    const auto d2 = (line.m() - sphere.center().cross(l)).squaredNorm();
+    const auto h2 = sphere.radius() * sphere.radius() - d2;
+    if(h2 < static_cast<T>(0))
+        return std::make_tuple(false, T(), T());
+
+    const auto tc = l.dot(sphere.center());
+    const auto h = std::sqrt(h2);
+    return std::make_tuple(true, tc - h, tc + h);
+}
+
+/**
+ * Returns true if a line intersects a capsule.
+ */
+template<typename T, typename Derived>
+bool has_intersection(const PluckerBase<T, Derived>& line, const Capsule<T>& capsule)
+{
+    return squared_distance(line, capsule.p0(), capsule.p1()) <= capsule.radius() * capsule.radius();
+}
+
+/**
+ * Returns true if a line intersects an infinite cylinder around an axis.
+ */
+template<typename T, typename Derived1, typename Derived2>
+bool has_intersection(const PluckerBase<T, Derived1>& line, const PluckerBase<T, Derived2>& axis, T radius, T tolerance)
+{
+    return distance(line, axis, tolerance) <= radius;
+}
+
+/**
+ * Returns the parameters where a line enters and leaves a cylinder.
+ * A cylinder of zero height has no intersection.
+ * Note: Needs a normalized line, then a point is `point_on_line(line, t)`.
+ */
+template<typename T, typename Derived>
+std::tuple<bool, T, T>
+find_intersection(const PluckerBase<T, Derived>& line, const Cylinder<T>& cylinder, T tolerance)
+{
+    const Vector3<T> d = line.l();
+    const Vector3<T> axis = cylinder.p1() - cylinder.p0();
+    const auto height = axis.norm();
+    if(detail::almost_zero(height, tolerance))
+        return std::make_tuple(false, T(), T());
+
+    const Vector3<T> w = axis / height;
+
+    // Relative to p0, the line is e + t d.
+    const Vector3<T> e = d.cross(Vector3<T>(line.m())) - cylinder.p0();
+    const auto ew = e.dot(w);
+    const auto dw = d.dot(w);
+
+    auto t0 = -std::numeric_limits<T>::infinity();
+    auto t1 = std::numeric_limits<T>::infinity();
+
+    // Between the caps.
+    if(detail::almost_zero(dw, tolerance))
+    {
+        if(ew < static_cast<T>(0) || ew > height)
+            return std::make_tuple(false, T(), T());
+    }
+    else
+    {
+        const auto ta = -ew / dw;
+        const auto tb = (height - ew) / dw;
+        t0 = std::min(ta, tb);
+        t1 = std::max(ta, tb);
+    }
+
+    // Within the radius.
+    const Vector3<T> e_perp = e - ew * w;
+    const Vector3<T> d_perp = d - dw * w;
+    const auto a = d_perp.squaredNorm();
+    const auto b = e_perp.dot(d_perp);
+    const auto c = e_perp.squaredNorm() - cylinder.radius() * cylinder.radius();
+    if(detail::almost_zero(a, tolerance))
+    {
+        if(c > static_cast<T>(0))
+            return std::make_tuple(false, T(), T());
+    }
+    else
+    {
+        const auto disc = b * b - a * c;
+        if(disc < static_cast<T>(0))
+            return std::make_tuple(false, T(), T());
+
+        const auto h = std::sqrt(disc);
+        t0 = std::max(t0, (-b - h) / a);
+        t1 = std::min(t1, (-b + h) / a);
+    }
+
+    if(t0 > t1)
+        return std::make_tuple(false, T(), T());
+
+    return std::make_tuple(true, t0, t1);
+}
+
+/**
+ * Returns true if a line intersects a cylinder.
+ */
+template<typename T, typename Derived>
+bool has_intersection(const PluckerBase<T, Derived>& line, const Cylinder<T>& cylinder, T tolerance)
+{
+    return std::get<0>(find_intersection(normalize(line), cylinder, tolerance));
+}
+
+/**
+ * Batch of spheres, one per row: (center.x, center.y, center.z, radius).
+ */
+template<typename T>
+using SphereBatch = Eigen::Matrix<T, Eigen::Dynamic, 4>;
+
+/**
+ * Batch of capsules, one per row: (p0.x, p0.y, p0.z, p1.x, p1.y, p1.z, radius).
+ */
+template<typename T>
+using CapsuleBatch = Eigen::Matrix<T, Eigen::Dynamic, 7>;
+
+namespace detail
+{
+
+/**
+ * Computes whether a line hits the spheres in rows [first, first + n).
+ */
+template<typename T, typename Derived>
+void has_intersection(
+    const PluckerBase<T, Derived>& line,
+    const SphereBatch<T>& spheres,
+    Eigen::Index first,
+    Eigen::Index n,
+    Eigen::Array<bool, Eigen::Dynamic, 1>& res)
+{
+    const Vector3<T> l = line.l();
+    const Vector3<T> m = line.m();
+    const auto s = spheres.middleRows(first, n).array();
+    const auto x = s.col(0);
+    const auto y = s.col(1);
+    const auto z = s.col(2);
+    const auto r = s.col(3);
+
+    // The moment of the line about each center, i.e. m - c x l.
+    res.head(n) = ((m.x() - (y * l.z() - z * l.y())).square()
+                 + (m.y() - (z * l.x() - x * l.z())).square()
+                 + (m.z() - (x * l.y() - y * l.x())).square()) <= r.square() * l.squaredNorm();
+}
+
+/**
+ * Computes whether a line hits the capsules in rows [first, first + n).
+ */
+template<typename T, typename Derived>
+void has_intersection(
+    const PluckerBase<T, Derived>& line,
+    const CapsuleBatch<T>& capsules,
+    Eigen::Index first,
+    Eigen::Index n,
+    Eigen::Array<bool, Eigen::Dynamic, 1>& res)
+{
+    using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+    const Vector3<T> l = line.l();
+    const Vector3<T> m = line.m();
+    const auto c = capsules.middleRows(first, n).array();
+    const auto ax = c.col(0);
+    const auto ay = c.col(1);
+    const auto az = c.col(2);
+    const Array ux = c.col(3) - ax;
+    const Array uy = c.col(4) - ay;
+    const Array uz = c.col(5) - az;
+    const auto r = c.col(6);
+
+    // Moments of the line about p0, and their rate along the segment.
+    const Array m0x = m.x() - (ay * l.z() - az * l.y());
+    const Array m0y = m.y() - (az * l.x() - ax * l.z());
+    const Array m0z = m.z() - (ax * l.y() - ay * l.x());
+    const Array m1x = uy * l.z() - uz * l.y();
+    const Array m1y = uz * l.x() - ux * l.z();
+    const Array m1z = ux * l.y() - uy * l.x();
+
+    const Array den = m1x.square() + m1y.square() + m1z.square();
+    const Array s = (den > static_cast<T>(0)).select(
+        ((m0x * m1x + m0y * m1y + m0z * m1z) / den).max(static_cast<T>(0)).min(static_cast<T>(1)),
+        static_cast<T>(0));
+
+    res.head(n) = ((m0x - s * m1x).square() + (m0y - s * m1y).square() + (m0z - s * m1z).square())
+        <= r.square() * l.squaredNorm();
+}
+
+/**
+ * Tests a line against a batch block by block.
+ */
+template<typename T, typename Derived, typename Batch>
+void has_intersection(const PluckerBase<T, Derived>& line, const Batch& batch, std::vector<std::uint8_t>& res)
+{
+    constexpr Eigen::Index block = 256;
+
+    const auto rows = batch.rows();
+    res.resize(static_cast<std::size_t>(rows));
+
+    Eigen::Array<bool, Eigen::Dynamic, 1> hits(std::min(block, rows));
+    for(Eigen::Index first = 0; first < rows; first += block)
+    {
+        const auto n = std::min(block, rows - first);
+        has_intersection(line, batch, first, n, hits);
+        for(Eigen::Index i = 0; i < n; i++)
+            res[static_cast<std::size_t>(first + i)] = hits(i) ? 1 : 0;
+    }
+}
+
+/**
+ * Returns the first row of a batch hit by a line, testing block by block.
+ */
+template<typename T, typename Derived, typename Batch>
+std::tuple<bool, Eigen::Index> find_first_intersection(const PluckerBase<T, Derived>& line, const Batch& batch)
+{
+    constexpr Eigen::Index block = 64;
+
+    const auto rows = batch.rows();
+
+    Eigen::Array<bool, Eigen::Dynamic, 1> hits(std::min(block, rows));
+    for(Eigen::Index first = 0; first < rows; first += block)
+    {
+        const auto n = std::min(block, rows - first);
+        has_intersection(line, batch, first, n, hits);
+        if(!hits.head(n).any())
+            continue;
+
+        for(Eigen::Index i = 0; i < n; i++)
+        {
+            if(hits(i))
+                return std::make_tuple(true, first + i);
+        }
+    }
+    return std::make_tuple(false, Eigen::Index(0));
+}
+
+}   // namespace detail
+
+/**
+ * Tests a line against all spheres.
+ * e.g. `res[i]` is 1 if sphere i is hit.
+ */
+template<typename T, typename Derived>
+void has_intersection(const PluckerBase<T, Derived>& line, const SphereBatch<T>& spheres, std::vector<std::uint8_t>& res)
+{
+    detail::has_intersection(line, spheres, res);
+}
+
+/**
+ * Tests a line against all capsules.
+ * e.g. `res[i]` is 1 if capsule i is hit.
+ */
+template<typename T, typename Derived>
+void has_intersection(const PluckerBase<T, Derived>& line, const CapsuleBatch<T>& capsules, std::vector<std::uint8_t>& res)
+{
+    detail::has_intersection(line, capsules, res);
+}
+
+/**
+ * Returns the first sphere hit by a line.
+ */
+template<typename T, typename Derived>
+std::tuple<bool, Eigen::Index> find_first_intersection(const PluckerBase<T, Derived>& line, const SphereBatch<T>& spheres)
+{
+    return detail::find_first_intersection(line, spheres);
+}
+
+/**
+ * Returns the first capsule hit by a line.
+ */
+template<typename T, typename Derived>
+std::tuple<bool, Eigen::Index> find_first_intersection(const PluckerBase<T, Derived>& line, const CapsuleBatch<T>& capsules)
+{
+    return detail::find_first_intersection(line, capsules);
+}
+
+}   // namespace plucker
@@ -0,0 +1,249 @@
+/**
+ * @file plucker/ransac.h
+ * @brief This file provides RANSAC line detection in point clouds.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_geometric.h"
+#include "plucker_batch.h"
+#include "line_fitter.h"
+#include "parallel.h"
+
+namespace plucker
+{
+
+/**
+ * Parameters of RANSAC line detection.
+ */
+template<typename T>
+struct RansacOptions
+{
+    /** Maximum distance from an inlier to a line. */
+    T threshold = static_cast<T>(0);
+    /** Probability of drawing at least one all-inlier sample. */
+    T confidence = static_cast<T>(0.99);
+    std::size_t max_iterations = 1000;
+    /** Hypotheses evaluated between termination checks. */
+    std::size_t hypotheses_per_round = 64;
+    std::uint64_t seed = 0;
+    /** 0 means the number of hardware threads. */
+    unsigned num_threads = 0;
+    /** Refits the best line to its inliers by least squares. */
+    bool refine = true;
+};
+
+/**
+ * Result of RANSAC line detection.
+ */
+template<typename T>
+struct RansacResult
+{
+    bool found = false;
+    Plucker<T> line;
+    std::size_t inlier_count = 0;
+    std::size_t iterations = 0;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+namespace detail
+{
+
+/**
+ * Returns the SplitMix64 hash of `x`.
+ */
+inline std::uint64_t
+splitmix64(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Returns the number of points within `threshold` of a line.
+ * Gives up and returns 0 once `target` can no longer be reached.
+ */
+template<typename T, typename Derived1, typename Derived2>
+std::size_t
+count_inliers(
+    const PluckerBase<T, Derived1>& line,
+    const Eigen::MatrixBase<Derived2>& points,
+    T squared_threshold,
+    std::size_t target,
+    VectorX<T>& buffer)
+{
+    const auto rows = points.rows();
+    const auto block = buffer.rows();
+
+    std::size_t count = 0;
+    for(Eigen::Index first = 0; first < rows; first += block)
+    {
+        const auto n = std::min(block, rows - first);
+        squared_distance(line, points.middleRows(first, n), buffer.head(n));
+        count += static_cast<std::size_t>((buffer.head(n).array() <= squared_threshold).count());
+
+        if(count + static_cast<std::size_t>(rows - first - n) < target)
+            return 0;
+    }
+    return count;
+}
+
+/**
+ * Returns the number of hypotheses needed to reach `confidence`.
+ */
+template<typename T>
+std::size_t
+required_iterations(std::size_t inliers, std::size_t points, T confidence, std::size_t max_iterations)
+{
+    const auto w = static_cast<T>(inliers) / static_cast<T>(points);
+    const auto p = w * w;
+    if(p >= static_cast<T>(1))
+        return 1;
+    if(p <= static_cast<T>(0))
+        return max_iterations;
+
+    const auto n = std::log(static_cast<T>(1) - confidence) / std::log(static_cast<T>(1) - p);
+    if(!(n < static_cast<T>(max_iterations)))
+        return max_iterations;
+
+    return std::max<std::size_t>(static_cast<std::size_t>(std::ceil(n)), 1);
+}
+
+}   // namespace detail
+
+/**
+ * Returns the indices of the points within `threshold` of a line.
+ */
+template<typename T, typename Derived1, typename Derived2>
+std::vector<std::size_t>
+find_inliers(const PluckerBase<T, Derived1>& line, const Eigen::MatrixBase<Derived2>& points, T threshold)
+{
+    VectorX<T> d2(points.rows());
+    squared_distance(line, points, d2);
+
+    std::vector<std::size_t> res;
+    for(Eigen::Index i = 0; i < d2.rows(); i++)
+        if(d2(i) <= threshold * threshold)
+            res.push_back(static_cast<std::size_t>(i));
+
+    return res;
+}
+
+/**
+ * Detects the line supported by the most points.
+ * e.g. Each row of `points` is a point.
+ *
+ * Each hypothesis is drawn from its own seed, so the result depends
+ * only on `options.seed`, not on the number of threads.
+ */
+template<typename T, typename Derived>
+RansacResult<T>
+find_line_ransac(const Eigen::MatrixBase<Derived>& points, const RansacOptions<T>& options)
+{
+    static_assert(std::is_same<T, typename Derived::Scalar>::value,
+        "Points must have the same scalar type as the options.");
+    assert(points.cols() == 3);
+
+    RansacResult<T> res;
+
+    const auto rows = points.rows();
+    if(rows < 2)
+        return res;
+
+    const auto n = static_cast<std::uint64_t>(rows);
+    const auto squared_threshold = options.threshold * options.threshold;
+    const auto per_round = std::max<std::size_t>(options.hypotheses_per_round, 1);
+    const auto threads = detail::thread_count(options.num_threads, per_round);
+    constexpr Eigen::Index block = 4096;
+
+    std::vector<VectorX<T>> buffers(threads, VectorX<T>(std::min<Eigen::Index>(block, rows)));
+    std::vector<std::size_t> scores(per_round);
+
+    std::size_t best_index = 0;
+    std::size_t best_count = 0;
+    std::size_t required = options.max_iterations;
+
+    const auto hypothesis = [&](std::size_t index)
+    {
+        const auto h = detail::splitmix64(options.seed ^ detail::splitmix64(index));
+        const auto i = static_cast<Eigen::Index>(h % n);
+        auto j = static_cast<Eigen::Index>(detail::splitmix64(h) % (n - 1));
+        if(j >= i)
+            j++;
+
+        const Vector4<T> from = points.row(i).transpose().homogeneous();
+        const Vector4<T> to = points.row(j).transpose().homogeneous();
+        return Plucker<T>(from, to);
+    };
+
+    std::size_t iterations = 0;
+    while(iterations < required)
+    {
+        const auto count = std::min(per_round, required - iterations);
+        const auto target = best_count + 1;
+
+        detail::parallel_for(count, threads,
+            [&](std::size_t first, std::size_t last, unsigned thread_index)
+            {
+                for(auto k = first; k < last; k++)
+                {
+                    const auto line = hypothesis(iterations + k);
+                    scores[k] = (line.l().squaredNorm() > static_cast<T>(0)) ?
+                        detail::count_inliers(line, points, squared_threshold, target, buffers[thread_index]) : 0;
+                }
+            });
+
+        // Reduces in hypothesis order, so that ties go to the earliest one.
+        for(std::size_t k = 0; k < count; k++)
+        {
+            if(scores[k] > best_count)
+            {
+                best_count = scores[k];
+                best_index = iterations + k;
+            }
+        }
+
+        iterations += count;
+        if(best_count >= 2)
+            required = detail::required_iterations(best_count, static_cast<std::size_t>(rows), options.confidence, options.max_iterations);
+    }
+
+    res.iterations = iterations;
+    if(best_count < 2)
+        return res;
+
+    res.found = true;
+    res.line = normalize(hypothesis(best_index));
+    res.inlier_count = best_count;
+
+    if(options.refine)
+    {
+        LineFitter<T> fitter;
+        for(const auto i : find_inliers(res.line, points, options.threshold))
+            fitter.add(Vector3<T>(points.row(static_cast<Eigen::Index>(i)).transpose()));
+
+        const auto fit = fitter.fit();
+        if(std::get<0>(fit))
+        {
+            const auto count = detail::count_inliers(std::get<1>(fit), points, squared_threshold, best_count, buffers[0]);
+            if(count >= best_count)
+            {
+                res.line = std::get<1>(fit);
+                res.inlier_count = count;
+            }
+        }
+    }
+
+    return res;
+}
+
+}   // namespace plucker
@@ -0,0 +1,174 @@
+/**
+ * @file plucker/rasterizer.h
+ * @brief This file provides a tiled rasterizer of depth and triangle ID images.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "edge_mesh.h"
+#include "camera.h"
+#include "parallel.h"
+
+namespace plucker
+{
+
+namespace detail
+{
+
+/**
+ * Size of the square image tiles, matching the width of the rows evaluated at once.
+ */
+constexpr int raster_tile_size = 8;
+
+}   // namespace detail
+
+/**
+ * Renders the depth and the front facing triangle seen through each pixel, for depth in [t_min, t_max].
+ * e.g. `depths[x + width y]` is infinity and `ids[x + width y]` is the maximum index
+ * if no triangle covers pixel (x, y).
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ *
+ * The product of the ray through pixel (x, y) with an edge is an affine function of x and y,
+ * so each edge is set up once, and a pixel is covered if no product with the edges of a triangle is positive.
+ * The products are exact in 3D, and the depth is interpolated from them as unnormalized
+ * barycentric coordinates, so triangles crossing the camera plane need no clipping.
+ * Both triangles of a shared edge see exactly the same function, negated, leaving no cracks.
+ * Triangles are binned into 8x8 tiles, and the rows of a tile are evaluated at once.
+ * The depth is along the optical axis, the same as t of the camera rays.
+ */
+template<typename T>
+void rasterize(
+    const EdgeMesh<T>& mesh,
+    const PinholeCamera<T>& camera,
+    T t_min,
+    T t_max,
+    std::vector<T>& depths,
+    std::vector<typename EdgeMesh<T>::index_type>& ids,
+    unsigned num_threads = 0)
+{
+    using index_type = typename EdgeMesh<T>::index_type;
+    using Row = Eigen::Array<T, detail::raster_tile_size, 1>;
+    using IndexRow = Eigen::Array<index_type, detail::raster_tile_size, 1>;
+    using TileDepths = Eigen::Array<T, detail::raster_tile_size, detail::raster_tile_size>;
+    using TileIds = Eigen::Array<index_type, detail::raster_tile_size, detail::raster_tile_size>;
+
+    constexpr auto tile_size = detail::raster_tile_size;
+    constexpr auto no_triangle = std::numeric_limits<index_type>::max();
+
+    depths.resize(camera.pixel_count());
+    ids.resize(camera.pixel_count());
+
+    const auto columns = (camera.width() + tile_size - 1) / tile_size;
+
+    // Each edge as the coefficients (1, x, y) of its product with the pixel rays.
+    const Eigen::Matrix<T, Eigen::Dynamic, 3> edge_functions = mesh.edges() * camera.product_coefficients();
+
+    // The three edge functions of each triangle, followed by the numerator of its depth.
+    const auto triangle_count = mesh.triangle_count();
+    Eigen::Matrix<T, Eigen::Dynamic, 12, Eigen::RowMajor> functions(static_cast<Eigen::Index>(triangle_count), 12);
+
+    // Tiles overlapped by each triangle, binned in triangle order.
+    const auto setup_threads = detail::thread_count(num_threads, triangle_count);
+    detail::TileBins<index_type> bins;
+    Eigen::Matrix<int, Eigen::Dynamic, 4, Eigen::RowMajor> bounds;
+    detail::bin_triangles(mesh, camera, tile_size, t_min, t_max, setup_threads, bounds, bins);
+
+    const Vector3<T> axis = camera.rotation().col(2);
+    const auto& triangles = mesh.triangles();
+
+    detail::parallel_for(triangle_count, setup_threads,
+        [&](std::size_t first, std::size_t last, unsigned)
+        {
+            for(auto t = first; t < last; t++)
+            {
+                const auto row = static_cast<Eigen::Index>(t);
+                if(bounds(row, 0) >= bounds(row, 2) || bounds(row, 1) >= bounds(row, 3))
+                    continue;
+
+                const Vector3<T> z(
+                    (mesh.vertex(triangles(row, 0)) - camera.position()).dot(axis),
+                    (mesh.vertex(triangles(row, 1)) - camera.position()).dot(axis),
+                    (mesh.vertex(triangles(row, 2)) - camera.position()).dot(axis));
+                for(auto i = 0; i < 3; i++)
+                {
+                    const auto e = static_cast<Eigen::Index>(mesh.triangle_edges()(row, i));
+                    functions.row(row).template segment<3>(3 * i) = ((mesh.orientations()[t] >> i) & 1u)
+                        ? (- edge_functions.row(e)).eval() : edge_functions.row(e).eval();
+                }
+                // Vertex 0 is weighted by the product with edge 1, opposite to it, and so on.
+                functions.row(row).template segment<3>(9) =
+                      z(0) * functions.row(row).template segment<3>(3)
+                    + z(1) * functions.row(row).template segment<3>(6)
+                    + z(2) * functions.row(row).template segment<3>(0);
+            }
+        });
+
+    const Row offsets = Row::LinSpaced(tile_size, static_cast<T>(0), static_cast<T>(tile_size - 1));
+
+    detail::for_each_tile(camera, tile_size, num_threads,
+        [&](int x0, int y0, int w, int h, unsigned)
+        {
+            TileDepths tile_depths = TileDepths::Constant(t_max);
+            TileIds tile_ids = TileIds::Constant(no_triangle);
+
+            const Row xs = offsets + static_cast<T>(x0);
+            const auto tile = static_cast<std::size_t>((y0 / tile_size) * columns + x0 / tile_size);
+
+            for(auto k = bins.offsets[tile]; k < bins.offsets[tile + 1]; k++)
+            {
+                const auto t = bins.triangles[k];
+                const auto row = static_cast<Eigen::Index>(t);
+                const Eigen::Map<const Eigen::Matrix<T, 3, 4>> f(functions.row(row).data());
+
+                // Skip the tile if an edge function is positive on all of it.
+                auto outside = false;
+                for(auto i = 0; i < 3; i++)
+                {
+                    const auto min_x = std::min(f(1, i) * static_cast<T>(x0), f(1, i) * static_cast<T>(x0 + w - 1));
+                    const auto min_y = std::min(f(2, i) * static_cast<T>(y0), f(2, i) * static_cast<T>(y0 + h - 1));
+                    outside = outside || f(0, i) + min_x + min_y > static_cast<T>(0);
+                }
+                if(outside)
+                    continue;
+
+                const auto first_y = std::max(y0, bounds(row, 1));
+                const auto last_y = std::min(y0 + h, bounds(row, 3));
+                for(auto y = first_y; y < last_y; y++)
+                {
+                    const auto fy = static_cast<T>(y);
+                    const Row w0 = (f(0, 0) + f(2, 0) * fy) + f(1, 0) * xs;
+                    const Row w1 = (f(0, 1) + f(2, 1) * fy) + f(1, 1) * xs;
+                    const Row w2 = (f(0, 2) + f(2, 2) * fy) + f(1, 2) * xs;
+                    const Row sum = w0 + w1 + w2;
+                    const Row depth = ((f(0, 3) + f(2, 3) * fy) + f(1, 3) * xs) / sum;
+
+                    auto tile_depth = tile_depths.col(y - y0);
+                    auto tile_id = tile_ids.col(y - y0);
+                    const Eigen::Array<bool, tile_size, 1> covered = (w0 <= static_cast<T>(0)) && (w1 <= static_cast<T>(0)) && (w2 <= static_cast<T>(0))
+                        && (sum < static_cast<T>(0)) && (depth >= t_min) && (depth <= tile_depth);
+                    tile_depth = covered.select(depth, tile_depth);
+                    tile_id = covered.select(IndexRow::Constant(t), tile_id);
+                }
+            }
+
+            for(auto j = 0; j < h; j++)
+            {
+                const auto offset = static_cast<std::size_t>(x0) + static_cast<std::size_t>(camera.width()) * static_cast<std::size_t>(y0 + j);
+                for(auto i = 0; i < w; i++)
+                {
+                    const auto id = tile_ids(i, j);
+                    ids[offset + static_cast<std::size_t>(i)] = id;
+                    depths[offset + static_cast<std::size_t>(i)] = id == no_triangle ? std::numeric_limits<T>::infinity() : tile_depths(i, j);
+                }
+            }
+        });
+}
+
+}   // namespace plucker
@@ -0,0 +1,220 @@
+/**
+ * @file plucker/ray_hit.h
+ * @brief This file provides closest hit queries of rays against triangle meshes.
+ */
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "edge_mesh.h"
+#include "parallel.h"
+
+namespace plucker
+{
+
+/**
+ * Hit of a ray `origin + t direction` with a triangle (v0, v1, v2)
+ * at the point `(1 - u - v) v0 + u v1 + v v2`.
+ */
+template<typename T>
+struct RayHit
+{
+    T t;
+    T u;
+    T v;
+    std::size_t triangle;
+};
+
+namespace detail
+{
+
+/**
+ * Returns the product of a ray with edge i of a triangle, given its products with all edges.
+ */
+template<typename T, typename Derived>
+T triangle_product(const EdgeMesh<T>& mesh, const Eigen::MatrixBase<Derived>& products, std::size_t t, int i)
+{
+    const auto product = products(mesh.triangle_edges()(static_cast<Eigen::Index>(t), i));
+    return ((mesh.orientations()[t] >> i) & 1u) ? -product : product;
+}
+
+/**
+ * Computes the hit of a ray with a triangle from its products with the edges of the triangle.
+ *
+ * The product with the edge opposite a vertex is proportional to the signed volume
+ * spanned by the ray and that edge, i.e. the unnormalized barycentric coordinate of the vertex.
+ */
+template<typename T>
+bool
+hit_from_products(
+    const EdgeMesh<T>& mesh,
+    std::size_t t,
+    T w0, T w1, T w2,
+    const Vector3<T>& origin,
+    const Vector3<T>& direction,
+    RayHit<T>& hit)
+{
+    if(w0 > static_cast<T>(0) || w1 > static_cast<T>(0) || w2 > static_cast<T>(0))
+        return false;
+
+    // The ray runs within the plane of the triangle.
+    const auto sum = w0 + w1 + w2;
+    if(sum == static_cast<T>(0))
+        return false;
+
+    const auto row = static_cast<Eigen::Index>(t);
+    const auto& triangles = mesh.triangles();
+    hit.u = w2 / sum;
+    hit.v = w0 / sum;
+    hit.triangle = t;
+
+    const Vector3<T> point = (static_cast<T>(1) - hit.u - hit.v) * mesh.vertex(triangles(row, 0))
+                           + hit.u * mesh.vertex(triangles(row, 1))
+                           + hit.v * mesh.vertex(triangles(row, 2));
+    hit.t = (point - origin).dot(direction) / direction.squaredNorm();
+    return true;
+}
+
+/**
+ * Returns the closest hit of a ray with a mesh, for t in [t_min, t_max],
+ * given its products with all edges.
+ */
+template<typename T, typename Derived>
+std::tuple<bool, RayHit<T>>
+closest_hit_from_products(
+    const EdgeMesh<T>& mesh,
+    const Eigen::MatrixBase<Derived>& products,
+    const Vector3<T>& origin,
+    const Vector3<T>& direction,
+    T t_min,
+    T t_max)
+{
+    auto found = false;
+    RayHit<T> closest;
+    closest.t = t_max;
+
+    RayHit<T> hit;
+    for(std::size_t t = 0; t < mesh.triangle_count(); t++)
+    {
+        const auto w0 = triangle_product(mesh, products, t, 0);
+        const auto w1 = triangle_product(mesh, products, t, 1);
+        const auto w2 = triangle_product(mesh, products, t, 2);
+        if(!hit_from_products(mesh, t, w0, w1, w2, origin, direction, hit))
+            continue;
+
+        if(hit.t >= t_min && hit.t <= closest.t)
+        {
+            closest = hit;
+            found = true;
+        }
+    }
+
+    if(!found)
+        return std::make_tuple(false, RayHit<T>());
+
+    return std::make_tuple(true, closest);
+}
+
+}   // namespace detail
+
+/**
+ * Returns the hit of a ray `origin + t direction` with a triangle of a mesh,
+ * given the line of the ray.
+ * Here, the front facing of a triangle is counterclockwise.
+ */
+template<typename T, typename Derived>
+std::tuple<bool, RayHit<T>>
+find_hit(const EdgeMesh<T>& mesh, const PluckerBase<T, Derived>& ray, const Vector3<T>& origin, const Vector3<T>& direction, std::size_t t)
+{
+    T w[3];
+    for(auto i = 0; i < 3; i++)
+    {
+        const auto product = ray * mesh.edge(mesh.triangle_edges()(static_cast<Eigen::Index>(t), i));
+        w[i] = ((mesh.orientations()[t] >> i) & 1u) ? -product : product;
+    }
+
+    RayHit<T> hit;
+    if(!detail::hit_from_products(mesh, t, w[0], w[1], w[2], origin, direction, hit))
+        return std::make_tuple(false, RayHit<T>());
+
+    return std::make_tuple(true, hit);
+}
+
+/**
+ * Returns the hit of a ray `origin + t direction` with a triangle of a mesh.
+ * Here, the front facing of a triangle is counterclockwise.
+ */
+template<typename T>
+std::tuple<bool, RayHit<T>>
+find_hit(const EdgeMesh<T>& mesh, const Vector3<T>& origin, const Vector3<T>& direction, std::size_t t)
+{
+    const Plucker<T> ray(origin.homogeneous().eval(), (origin + direction).homogeneous().eval());
+    return find_hit(mesh, ray, origin, direction, t);
+}
+
+/**
+ * Returns the closest hit of a ray `origin + t direction` with a mesh, for t in [t_min, t_max].
+ * Each edge is evaluated once, and `products` is the workspace for it.
+ * Here, the front facing of a triangle is counterclockwise.
+ */
+template<typename T>
+std::tuple<bool, RayHit<T>>
+find_closest_hit(
+    const EdgeMesh<T>& mesh,
+    const Vector3<T>& origin,
+    const Vector3<T>& direction,
+    T t_min,
+    T t_max,
+    VectorX<T>& products)
+{
+    const Plucker<T> ray(origin.homogeneous().eval(), (origin + direction).homogeneous().eval());
+    mesh.edge_products(ray, products);
+    return detail::closest_hit_from_products(mesh, products, origin, direction, t_min, t_max);
+}
+
+/**
+ * Finds the closest hit of each ray `origins.row(k) + t directions.row(k)`, for t in [t_min, t_max].
+ * e.g. `res[k].t` is infinity if ray k misses.
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ */
+template<typename T>
+void find_closest_hits(
+    const EdgeMesh<T>& mesh,
+    const Vector3Batch<T>& origins,
+    const Vector3Batch<T>& directions,
+    T t_min,
+    T t_max,
+    std::vector<RayHit<T>>& res,
+    unsigned num_threads = 0)
+{
+    const auto count = static_cast<std::size_t>(origins.rows());
+    res.resize(count);
+
+    detail::parallel_for(count, num_threads,
+        [&](std::size_t first, std::size_t last, unsigned)
+        {
+            VectorX<T> products;
+            for(auto k = first; k < last; k++)
+            {
+                const auto row = static_cast<Eigen::Index>(k);
+                const auto hit = find_closest_hit(mesh,
+                    Vector3<T>(origins.row(row).transpose()), Vector3<T>(directions.row(row).transpose()),
+                    t_min, t_max, products);
+                if(std::get<0>(hit))
+                {
+                    res[k] = std::get<1>(hit);
+                }
+                else
+                {
+                    res[k] = RayHit<T>();
+                    res[k].t = std::numeric_limits<T>::infinity();
+                }
+            }
+        });
+}
+
+}   // namespace plucker
@@ -0,0 +1,351 @@
+/**
+ * @file plucker/segment.h
+ * @brief This file provides line segments and their distance queries.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "plucker_common.h"
+#include "parallel.h"
+
+namespace plucker
+{
+
+/**
+ * Line segment `p0 -> p1`.
+ */
+template<typename T>
+class Segment
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+
+/* Constructors */
+    Segment()
+    {}
+
+    Segment(const Vector3<T>& p0, const Vector3<T>& p1)
+        : p0_(p0), p1_(p1)
+    {}
+    /**
+     * Creates from the interval [t0, t1] of a line.
+     * Note: Needs a normalized line, then a point is `point_on_line(line, t)`.
+     */
+    template<typename Derived>
+    Segment(const PluckerBase<T, Derived>& line, T t0, T t1)
+        : p0_(point_on_line(line, t0).template head<3>()),
+          p1_(point_on_line(line, t1).template head<3>())
+    {}
+
+/* Accessors */
+    const Vector3<T>& p0() const noexcept { return p0_; }
+    const Vector3<T>& p1() const noexcept { return p1_; }
+    Vector3<T>& p0() noexcept { return p0_; }
+    Vector3<T>& p1() noexcept { return p1_; }
+
+/* Queries */
+    Vector3<T> direction() const { return p1_ - p0_; }
+    T length() const { return (p1_ - p0_).norm(); }
+    /**
+     * Returns the line through the segment, directed `p0 -> p1`.
+     */
+    Plucker<T> line() const { return Plucker<T>(p0_.homogeneous().eval(), p1_.homogeneous().eval()); }
+    /**
+     * Returns the point `p0 + s (p1 - p0)`.
+     */
+    Vector3<T> point(T s) const { return p0_ + s * (p1_ - p0_); }
+
+private:
+    Vector3<T> p0_;
+    Vector3<T> p1_;
+};
+
+namespace detail
+{
+
+template<typename T>
+T clamp01(T x)
+{
+    return std::min(std::max(x, static_cast<T>(0)), static_cast<T>(1));
+}
+
+/**
+ * Returns the parameters of the closest points of segments `p1 + s d1` and `p2 + t d2`,
+ * where s and t are in [0, 1].
+ */
+template<typename T>
+std::tuple<T, T>
+closest_parameters(const Vector3<T>& p1, const Vector3<T>& d1, const Vector3<T>& p2, const Vector3<T>& d2)
+{
+    const Vector3<T> r = p1 - p2;
+    const auto a = d1.squaredNorm();
+    const auto e = d2.squaredNorm();
+    const auto f = d2.dot(r);
+
+    if(a <= static_cast<T>(0))
+        return std::make_tuple(static_cast<T>(0), (e > static_cast<T>(0)) ? clamp01(f / e) : static_cast<T>(0));
+
+    const auto c = d1.dot(r);
+    if(e <= static_cast<T>(0))
+        return std::make_tuple(clamp01(-c / a), static_cast<T>(0));
+
+    const auto b = d1.dot(d2);
+    const auto denom = a * e - b * b;
+
+    // Parallel segments take any s, then t follows.
+    auto s = (denom > static_cast<T>(0)) ? clamp01((b * f - c * e) / denom) : static_cast<T>(0);
+    auto t = (b * s + f) / e;
+    if(t < static_cast<T>(0))
+    {
+        t = static_cast<T>(0);
+        s = clamp01(-c / a);
+    }
+    else if(t > static_cast<T>(1))
+    {
+        t = static_cast<T>(1);
+        s = clamp01((b - c) / a);
+    }
+    return std::make_tuple(s, t);
+}
+
+template<typename T>
+T squared_distance(const Vector3<T>& p1, const Vector3<T>& d1, const Vector3<T>& p2, const Vector3<T>& d2)
+{
+    T s, t;
+    std::tie(s, t) = closest_parameters(p1, d1, p2, d2);
+    return ((p1 + s * d1) - (p2 + t * d2)).squaredNorm();
+}
+
+}   // namespace detail
+
+/**
+ * Returns the point on a segment closest to a point.
+ */
+template<typename T>
+Vector3<T> closest_point(const Segment<T>& segment, const Vector3<T>& point)
+{
+    const Vector3<T> d = segment.direction();
+    const auto den = d.squaredNorm();
+    const auto s = (den > static_cast<T>(0)) ? detail::clamp01((point - segment.p0()).dot(d) / den) : static_cast<T>(0);
+    return segment.p0() + s * d;
+}
+
+/**
+ * Returns the squared distance from a point to a segment.
+ */
+template<typename T>
+T squared_distance(const Segment<T>& segment, const Vector3<T>& point)
+{
+    return (closest_point(segment, point) - point).squaredNorm();
+}
+
+/**
+ * Returns the distance from a point to a segment.
+ */
+template<typename T>
+T distance(const Segment<T>& segment, const Vector3<T>& point)
+{
+    return std::sqrt(squared_distance(segment, point));
+}
+
+/**
+ * Returns points on two segments closest to one another.
+ */
+template<typename T>
+std::tuple<Vector3<T>, Vector3<T>>
+find_closest_points(const Segment<T>& segment1, const Segment<T>& segment2)
+{
+    const Vector3<T> d1 = segment1.direction();
+    const Vector3<T> d2 = segment2.direction();
+
+    T s, t;
+    std::tie(s, t) = detail::closest_parameters(segment1.p0(), d1, segment2.p0(), d2);
+    return std::make_tuple(Vector3<T>(segment1.p0() + s * d1), Vector3<T>(segment2.p0() + t * d2));
+}
+
+/**
+ * Returns the squared distance between two segments.
+ */
+template<typename T>
+T squared_distance(const Segment<T>& segment1, const Segment<T>& segment2)
+{
+    return detail::squared_distance(segment1.p0(), segment1.direction(), segment2.p0(), segment2.direction());
+}
+
+/**
+ * Returns the distance between two segments.
+ */
+template<typename T>
+T distance(const Segment<T>& segment1, const Segment<T>& segment2)
+{
+    return std::sqrt(squared_distance(segment1, segment2));
+}
+
+/**
+ * Batch of segments, one per row: (p0.x, p0.y, p0.z, p1.x, p1.y, p1.z).
+ */
+template<typename T>
+using SegmentBatch = Eigen::Matrix<T, Eigen::Dynamic, 6>;
+
+using IndexPair = std::pair<std::size_t, std::size_t>;
+
+namespace detail
+{
+
+/**
+ * Bounding boxes of a batch of segments, one per row: (min.x, min.y, min.z, max.x, max.y, max.z).
+ */
+template<typename T>
+Eigen::Matrix<T, Eigen::Dynamic, 6>
+bounding_boxes(const SegmentBatch<T>& segments)
+{
+    Eigen::Matrix<T, Eigen::Dynamic, 6> res(segments.rows(), 6);
+    res.template leftCols<3>() = segments.template leftCols<3>().cwiseMin(segments.template rightCols<3>());
+    res.template rightCols<3>() = segments.template leftCols<3>().cwiseMax(segments.template rightCols<3>());
+    return res;
+}
+
+/**
+ * Finds the pairs of segments within `threshold` by sort and sweep.
+ * The bounding boxes of both batches are sorted by their minimum along the axis of the widest spread,
+ * so each box only meets the boxes starting before its maximum plus `threshold`.
+ * Boxes overlapping on all axes, once inflated by `threshold`, then go to the exact test.
+ * e.g. `self == true` means `segments1` and `segments2` are the same batch, and pairs have i < j.
+ */
+template<typename T>
+void sweep_pairs_within(
+    const SegmentBatch<T>& segments1,
+    const SegmentBatch<T>& segments2,
+    bool self,
+    T threshold,
+    std::vector<IndexPair>& pairs,
+    unsigned num_threads)
+{
+    using Boxes = Eigen::Matrix<T, Eigen::Dynamic, 6>;
+
+    const auto rows1 = segments1.rows();
+    const auto count = self ? rows1 : rows1 + segments2.rows();
+
+    Boxes boxes(count, 6);
+    boxes.topRows(rows1) = bounding_boxes(segments1);
+    if(!self)
+        boxes.bottomRows(count - rows1) = bounding_boxes(segments2);
+
+    pairs.clear();
+    if(count < 2)
+        return;
+
+    Eigen::Index axis;
+    const auto centers = (boxes.template leftCols<3>() + boxes.template rightCols<3>()).eval();
+    (centers.colwise().maxCoeff() - centers.colwise().minCoeff()).maxCoeff(&axis);
+
+    std::vector<Eigen::Index> order(static_cast<std::size_t>(count));
+    for(Eigen::Index k = 0; k < count; k++)
+        order[static_cast<std::size_t>(k)] = k;
+    std::sort(order.begin(), order.end(),
+        [&](Eigen::Index a, Eigen::Index b) { return boxes(a, axis) < boxes(b, axis); });
+
+    VectorX<T> lo(count);
+    VectorX<T> hi(count);
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        lo(k) = boxes(order[static_cast<std::size_t>(k)], axis);
+        hi(k) = boxes(order[static_cast<std::size_t>(k)], axis + 3) + threshold;
+    }
+
+    const auto segment_of = [&](Eigen::Index k) -> decltype(segments1.row(0))
+    {
+        return k < rows1 ? segments1.row(k) : segments2.row(k - rows1);
+    };
+
+    // Each box scans its own window, so the work is about even along the sorted order.
+    const auto threads = thread_count(num_threads, static_cast<std::size_t>(count));
+    std::vector<std::vector<IndexPair>> partial(threads);
+    const auto threshold2 = threshold * threshold;
+
+    parallel_for(static_cast<std::size_t>(count), threads,
+        [&](std::size_t first, std::size_t last, unsigned thread_index)
+        {
+            auto& res = partial[thread_index];
+            for(auto p = static_cast<Eigen::Index>(first); p < static_cast<Eigen::Index>(last); p++)
+            {
+                const auto a = order[static_cast<std::size_t>(p)];
+                const auto box_a = boxes.row(a);
+                const Vector3<T> p1 = segment_of(a).template head<3>().transpose();
+                const Vector3<T> d1 = segment_of(a).template tail<3>().transpose() - p1;
+
+                for(auto q = p + 1; q < count && lo(q) <= hi(p); q++)
+                {
+                    const auto b = order[static_cast<std::size_t>(q)];
+                    if(!self && ((a < rows1) == (b < rows1)))
+                        continue;
+
+                    const auto box_b = boxes.row(b);
+                    if(!((box_a.template leftCols<3>().array() - threshold <= box_b.template rightCols<3>().array()).all()
+                      && (box_b.template leftCols<3>().array() - threshold <= box_a.template rightCols<3>().array()).all()))
+                        continue;
+
+                    const Vector3<T> p2 = segment_of(b).template head<3>().transpose();
+                    const Vector3<T> d2 = segment_of(b).template tail<3>().transpose() - p2;
+                    if(squared_distance(p1, d1, p2, d2) > threshold2)
+                        continue;
+
+                    if(self)
+                        res.emplace_back(static_cast<std::size_t>(std::min(a, b)), static_cast<std::size_t>(std::max(a, b)));
+                    else if(a < rows1)
+                        res.emplace_back(static_cast<std::size_t>(a), static_cast<std::size_t>(b - rows1));
+                    else
+                        res.emplace_back(static_cast<std::size_t>(b), static_cast<std::size_t>(a - rows1));
+                }
+            }
+        });
+
+    for(const auto& part : partial)
+        pairs.insert(pairs.end(), part.begin(), part.end());
+    std::sort(pairs.begin(), pairs.end());
+}
+
+}   // namespace detail
+
+/**
+ * Finds all pairs (i, j) where segment i of `segments1` and segment j of `segments2`
+ * are within `threshold` of one another.
+ * Pairs are sorted, whatever the number of threads.
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ */
+template<typename T>
+void find_pairs_within(
+    const SegmentBatch<T>& segments1,
+    const SegmentBatch<T>& segments2,
+    T threshold,
+    std::vector<IndexPair>& pairs,
+    unsigned num_threads = 0)
+{
+    detail::sweep_pairs_within(segments1, segments2, false, threshold, pairs, num_threads);
+}
+
+/**
+ * Finds all pairs (i, j) with i < j where segments i and j are within `threshold` of one another.
+ * Pairs are sorted, whatever the number of threads.
+ * e.g. `num_threads == 0` means the number of hardware threads.
+ */
+template<typename T>
+void find_pairs_within(
+    const SegmentBatch<T>& segments,
+    T threshold,
+    std::vector<IndexPair>& pairs,
+    unsigned num_threads = 0)
+{
+    detail::sweep_pairs_within(segments, segments, true, threshold, pairs, num_threads);
+}
+
+}   // namespace plucker
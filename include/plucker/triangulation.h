@@ -0,0 +1,288 @@
+/**
+ * @file plucker/triangulation.h
+ * @brief This file provides multi-camera triangulation over back-projected rays.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "camera.h"
+#include "line_intersector.h"
+#include "parallel.h"
+
+namespace plucker
+{
+
+template<typename T>
+using Vector2Batch = Eigen::Matrix<T, Eigen::Dynamic, 2>;
+
+/**
+ * Pinhole camera given by its extrinsics, which map world coordinates to camera coordinates,
+ * i.e. x_c = R x_w + t, and the camera looks down its +z axis.
+ * A thin adapter over PinholeCamera, whose image coordinates observations are in,
+ * e.g. the center of pixel (x, y) is (x + 1/2, y + 1/2).
+ */
+template<typename T>
+class Camera
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using Matrix3 = Eigen::Matrix<T, 3, 3>;
+
+/* Constructors */
+    Camera()
+        : Camera(static_cast<T>(1), static_cast<T>(1), static_cast<T>(0), static_cast<T>(0),
+            Matrix3::Identity(), Vector3<T>::Zero())
+    {}
+
+    Camera(T fx, T fy, T cx, T cy, const Matrix3& rotation, const Vector3<T>& translation)
+        : pinhole_(-rotation.transpose() * translation, rotation.transpose(), fx, fy, cx, cy, 0, 0)
+    {}
+
+/* Accessors */
+    T fx() const noexcept { return pinhole_.fx(); }
+    T fy() const noexcept { return pinhole_.fy(); }
+    T cx() const noexcept { return pinhole_.cx(); }
+    T cy() const noexcept { return pinhole_.cy(); }
+    Matrix3 rotation() const { return pinhole_.rotation().transpose(); }
+    Vector3<T> translation() const { return -(pinhole_.rotation().transpose() * pinhole_.position()); }
+    /**
+     * Returns the camera center in world coordinates.
+     */
+    const Vector3<T>& center() const noexcept { return pinhole_.position(); }
+    const PinholeCamera<T>& pinhole() const noexcept { return pinhole_; }
+
+/* Queries */
+    /**
+     * Returns the world direction of the ray through a point in image coordinates.
+     */
+    Vector3<T> direction(T u, T v) const
+    {
+        return pinhole_.direction(Vector2<T>(u, v));
+    }
+    /**
+     * Returns the normalized ray through a point in image coordinates, directed away from the camera.
+     */
+    Plucker<T> back_project(const Vector2<T>& pixel) const
+    {
+        return pinhole_.back_project(pixel);
+    }
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+private:
+    PinholeCamera<T> pinhole_;
+};
+
+/**
+ * Parameters of track triangulation.
+ */
+template<typename T>
+struct TriangulationOptions
+{
+    /**
+     * Maximum distance from a point to the ray of an inlier observation.
+     * e.g. Infinity disables the rejection by distance, but not of observations behind their camera.
+     */
+    T threshold = std::numeric_limits<T>::infinity();
+    /** Tolerance on the conditioning of the least-squares system. */
+    T tolerance = static_cast<T>(1e-6);
+    std::size_t min_observations = 2;
+    /** 0 means the number of hardware threads. */
+    unsigned num_threads = 0;
+};
+
+/**
+ * Triangulates tracks of observations from multiple cameras.
+ *
+ * Observations are back-projected into a batch of normalized rays, and each
+ * track is solved by least squares over its rays. The observation farthest
+ * from the point is rejected while it lies beyond the threshold or behind
+ * its camera, and the track is solved again.
+ *
+ * The engine keeps its buffers between calls, so repeated calls
+ * with batches of similar size do not allocate.
+ */
+template<typename T>
+class Triangulator
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using camera_container = std::vector<Camera<T>, Eigen::aligned_allocator<Camera<T>>>;
+
+/* Accessors */
+    /**
+     * Returns the back-projected rays of the last call, one per row.
+     */
+    const PluckerBatch<T>& rays() const noexcept { return rays_; }
+    /**
+     * Returns the inlier flags of the observations of the last call.
+     */
+    const std::vector<std::uint8_t>& inliers() const noexcept { return inliers_; }
+
+/* Operations */
+    /**
+     * Triangulates tracks.
+     * e.g. Track `k` consists of the observations [offsets[k], offsets[k + 1]),
+     * and observation `i` is pixel `pixels.row(i)` in camera `camera_indices[i]`.
+     *
+     * Row `k` of `points` receives the homogeneous point of track `k`,
+     * or zero when the track could not be triangulated.
+     */
+    void triangulate(
+        const camera_container& cameras,
+        const std::vector<size_type>& camera_indices,
+        const Vector2Batch<T>& pixels,
+        const std::vector<size_type>& offsets,
+        const TriangulationOptions<T>& options,
+        Vector4Batch<T>& points);
+
+private:
+    void back_project(
+        const camera_container& cameras,
+        const std::vector<size_type>& camera_indices,
+        const Vector2Batch<T>& pixels,
+        unsigned num_threads);
+
+    Vector4<T> solve_track(
+        const camera_container& cameras,
+        const std::vector<size_type>& camera_indices,
+        size_type first,
+        size_type last,
+        const TriangulationOptions<T>& options);
+
+private:
+    PluckerBatch<T> rays_;
+    std::vector<std::uint8_t> inliers_;
+};
+
+/* Operations */
+
+template<typename T>
+void
+Triangulator<T>::triangulate(
+    const camera_container& cameras,
+    const std::vector<size_type>& camera_indices,
+    const Vector2Batch<T>& pixels,
+    const std::vector<size_type>& offsets,
+    const TriangulationOptions<T>& options,
+    Vector4Batch<T>& points)
+{
+    assert(camera_indices.size() == static_cast<size_type>(pixels.rows()));
+    assert(!offsets.empty() && offsets.back() == camera_indices.size());
+
+    back_project(cameras, camera_indices, pixels, options.num_threads);
+
+    inliers_.assign(camera_indices.size(), 1);
+
+    const auto count = offsets.size() - 1;
+    points.resize(static_cast<Eigen::Index>(count), 4);
+
+    detail::parallel_for(count, options.num_threads,
+        [&](size_type first, size_type last, unsigned)
+        {
+            for(auto k = first; k < last; k++)
+                points.row(static_cast<Eigen::Index>(k))
+                    = solve_track(cameras, camera_indices, offsets[k], offsets[k + 1], options).transpose();
+        });
+}
+
+template<typename T>
+void
+Triangulator<T>::back_project(
+    const camera_container& cameras,
+    const std::vector<size_type>& camera_indices,
+    const Vector2Batch<T>& pixels,
+    unsigned num_threads)
+{
+    rays_.resize(pixels.rows(), 6);
+
+    detail::parallel_for(camera_indices.size(), num_threads,
+        [&](size_type first, size_type last, unsigned)
+        {
+            for(auto i = first; i < last; i++)
+            {
+                const auto row = static_cast<Eigen::Index>(i);
+                const auto& camera = cameras[camera_indices[i]];
+                const Vector3<T> l = camera.direction(pixels(row, 0), pixels(row, 1)).normalized();
+                rays_.row(row) << l.transpose(), camera.center().cross(l).transpose();
+            }
+        });
+}
+
+template<typename T>
+Vector4<T>
+Triangulator<T>::solve_track(
+    const camera_container& cameras,
+    const std::vector<size_type>& camera_indices,
+    size_type first,
+    size_type last,
+    const TriangulationOptions<T>& options)
+{
+    const auto squared_threshold = options.threshold * options.threshold;
+    auto remaining = last - first;
+
+    while(remaining >= options.min_observations && remaining >= 2)
+    {
+        LineIntersector<T> intersector;
+        for(auto i = first; i < last; i++)
+        {
+            if(inliers_[i])
+                intersector.add(Plucker<T>(rays_.row(static_cast<Eigen::Index>(i)).transpose()));
+        }
+
+        const auto res = intersector.find_point(options.tolerance);
+        if(!std::get<0>(res))
+            break;
+
+        const Vector3<T> point = std::get<1>(res).hnormalized();
+
+        // Finds the worst observation, where being behind the camera is worse than any distance.
+        auto worst = last;
+        auto worst_error = squared_threshold;
+        for(auto i = first; i < last; i++)
+        {
+            if(!inliers_[i])
+                continue;
+
+            const auto row = static_cast<Eigen::Index>(i);
+            const Vector3<T> l = rays_.row(row).template head<3>().transpose();
+            const Vector3<T> m = rays_.row(row).template tail<3>().transpose();
+            const auto behind = l.dot(point - cameras[camera_indices[i]].center()) <= static_cast<T>(0);
+            const auto error = behind ? std::numeric_limits<T>::infinity() : (m - point.cross(l)).squaredNorm();
+            if(error > worst_error || (behind && worst == last))
+            {
+                worst = i;
+                worst_error = error;
+            }
+        }
+
+        if(worst == last)
+        {
+            Vector4<T> res4;
+            res4 << point, static_cast<T>(1);
+            return res4;
+        }
+
+        inliers_[worst] = 0;
+        remaining--;
+    }
+
+    for(auto i = first; i < last; i++)
+        inliers_[i] = 0;
+
+    return Vector4<T>::Zero();
+}
+
+}   // namespace plucker
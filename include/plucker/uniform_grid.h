@@ -0,0 +1,459 @@
+/**
+ * @file plucker/uniform_grid.h
+ * @brief This file provides a uniform grid over triangle meshes for ray traversal.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "plucker_base.h"
+#include "plucker_batch.h"
+#include "aligned_box.h"
+#include "edge_mesh.h"
+#include "parallel.h"
+#include "ray_hit.h"
+
+namespace plucker
+{
+
+/**
+ * Uniform grid of cells listing the triangles of a mesh, which must outlive the grid.
+ *
+ * A triangle is listed in every cell its bounding box overlaps, in one flat array
+ * indexed by per-cell offsets. A ray walks the cells it crosses in order (3D DDA),
+ * and a mailbox keeps a triangle listed in several cells from being tested twice.
+ */
+template<typename T>
+class UniformGrid
+{
+    static_assert(std::is_floating_point<T>::value,
+        "Template parameter T must be floating_point type.");
+public:
+    using value_type = T;
+    using index_type = std::uint32_t;
+    using size_type = std::size_t;
+    using Resolution = Eigen::Array<int, 3, 1>;
+
+    /**
+     * Per-query workspace remembering the triangles already tested.
+     * One is needed per thread.
+     */
+    class Mailbox
+    {
+    public:
+        /**
+         * Starts a query, and returns its stamp.
+         */
+        std::uint32_t next(size_type triangle_count)
+        {
+            if(stamps_.size() != triangle_count || current_ == std::numeric_limits<std::uint32_t>::max())
+            {
+                stamps_.assign(triangle_count, 0);
+                current_ = 0;
+            }
+            return ++current_;
+        }
+        /**
+         * Returns true if a triangle is yet to be tested by the query, and marks it.
+         */
+        bool visit(size_type triangle, std::uint32_t stamp)
+        {
+            if(stamps_[triangle] == stamp)
+                return false;
+            stamps_[triangle] = stamp;
+            return true;
+        }
+
+    private:
+        std::vector<std::uint32_t> stamps_;
+        std::uint32_t current_ = 0;
+    };
+
+/* Constructors */
+    /**
+     * Creates with about `density` cells per triangle.
+     */
+    explicit UniformGrid(const EdgeMesh<T>& mesh, T density = static_cast<T>(2));
+
+    UniformGrid(const EdgeMesh<T>& mesh, const Resolution& resolution);
+
+/* Accessors */
+    const EdgeMesh<T>& mesh() const noexcept { return *mesh_; }
+    const AlignedBox3<T>& bounds() const noexcept { return bounds_; }
+    const Resolution& resolution() const noexcept { return resolution_; }
+    const Vector3<T>& cell_size() const noexcept { return cell_size_; }
+    size_type cell_count() const noexcept { return offsets_.size() - 1; }
+    /**
+     * Returns the index of the cell (x, y, z).
+     */
+    size_type cell_index(int x, int y, int z) const
+    {
+        return static_cast<size_type>(x + resolution_(0) * (y + resolution_(1) * z));
+    }
+    /**
+     * Returns the triangles listed in a cell as [first, last).
+     */
+    std::tuple<const index_type*, const index_type*> cell(size_type c) const
+    {
+        return std::make_tuple(triangles_.data() + offsets_[c], triangles_.data() + offsets_[c + 1]);
+    }
+
+/* Queries */
+    /**
+     * Walks the cells crossed by a ray `origin + t direction` for t in [t_min, t_max], in order.
+     * e.g. `visitor(c, t0, t1)` is called with the range [t0, t1] of the ray in cell c,
+     * and stops the walk by returning false.
+     * e.g. A zero direction crosses no cell.
+     */
+    template<typename Visitor>
+    void traverse(const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Visitor visitor) const;
+    /**
+     * Returns the closest hit of a ray `origin + t direction` for t in [t_min, t_max].
+     * Here, the front facing of a triangle is counterclockwise.
+     */
+    std::tuple<bool, RayHit<T>>
+    find_closest_hit(const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Mailbox& mailbox) const;
+    /**
+     * Returns the closest hit of a ray `origin + t direction` for t in [t_min, t_max],
+     * given the line of the ray.
+     */
+    template<typename Derived>
+    std::tuple<bool, RayHit<T>>
+    find_closest_hit(const PluckerBase<T, Derived>& ray, const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Mailbox& mailbox) const;
+    /**
+     * Returns true if a ray `origin + t direction` hits any triangle for t in [t_min, t_max].
+     */
+    bool has_intersection(const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Mailbox& mailbox) const;
+    /**
+     * Finds the closest hit of each ray `origins.row(k) + t directions.row(k)`, for t in [t_min, t_max].
+     * e.g. `res[k].t` is infinity if ray k misses.
+     * e.g. `num_threads == 0` means the number of hardware threads.
+     */
+    void find_closest_hits(
+        const Vector3Batch<T>& origins,
+        const Vector3Batch<T>& directions,
+        T t_min,
+        T t_max,
+        std::vector<RayHit<T>>& res,
+        unsigned num_threads = 0) const;
+
+private:
+    void build();
+
+private:
+    const EdgeMesh<T>* mesh_;
+    AlignedBox3<T> bounds_;
+    Resolution resolution_;
+    Vector3<T> cell_size_;
+    std::vector<index_type> offsets_;
+    std::vector<index_type> triangles_;
+};
+
+namespace detail
+{
+
+template<typename T>
+AlignedBox3<T> bounds_of(const Vector3Batch<T>& vertices)
+{
+    if(vertices.rows() == 0)
+        return AlignedBox3<T>(Vector3<T>::Zero(), Vector3<T>::Zero());
+
+    return AlignedBox3<T>(vertices.colwise().minCoeff().transpose(), vertices.colwise().maxCoeff().transpose());
+}
+
+}   // namespace detail
+
+/* Constructors */
+
+template<typename T>
+UniformGrid<T>::UniformGrid(const EdgeMesh<T>& mesh, T density)
+    : mesh_(&mesh),
+      bounds_(detail::bounds_of(mesh.vertices()))
+{
+    constexpr int max_resolution = 256;
+
+    // Cubic cells, as many as `density` per triangle.
+    const Vector3<T> extent = bounds_.sizes();
+    const auto volume = std::max(extent.prod(), std::numeric_limits<T>::min());
+    const auto cells = density * static_cast<T>(std::max<size_type>(mesh.triangle_count(), 1));
+    const auto k = std::cbrt(cells / volume);
+    for(auto i = 0; i < 3; i++)
+    {
+        const auto n = std::ceil(extent(i) * k);
+        resolution_(i) = std::isfinite(n) ? std::max(1, std::min(max_resolution, static_cast<int>(n))) : 1;
+    }
+    build();
+}
+
+template<typename T>
+UniformGrid<T>::UniformGrid(const EdgeMesh<T>& mesh, const Resolution& resolution)
+    : mesh_(&mesh),
+      bounds_(detail::bounds_of(mesh.vertices())),
+      resolution_(resolution)
+{
+    assert((resolution > 0).all());
+    build();
+}
+
+template<typename T>
+void
+UniformGrid<T>::build()
+{
+    // Flat axes still get cells of some size.
+    for(auto i = 0; i < 3; i++)
+    {
+        const auto extent = bounds_.max()(i) - bounds_.min()(i);
+        cell_size_(i) = (extent > static_cast<T>(0)) ? extent / static_cast<T>(resolution_(i)) : static_cast<T>(1);
+    }
+
+    const auto& triangles = mesh_->triangles();
+    const auto count = static_cast<size_type>(resolution_.prod());
+
+    // Cell ranges overlapped by the bounding box of each triangle.
+    std::vector<Eigen::Array<int, 6, 1>> ranges(static_cast<size_type>(triangles.rows()));
+    for(Eigen::Index t = 0; t < triangles.rows(); t++)
+    {
+        AlignedBox3<T> box;
+        box.setEmpty();
+        for(auto i = 0; i < 3; i++)
+            box.extend(mesh_->vertex(triangles(t, i)));
+
+        auto& range = ranges[static_cast<size_type>(t)];
+        for(auto i = 0; i < 3; i++)
+        {
+            const auto lo = std::floor((box.min()(i) - bounds_.min()(i)) / cell_size_(i));
+            const auto hi = std::floor((box.max()(i) - bounds_.min()(i)) / cell_size_(i));
+            range(i) = std::max(0, std::min(resolution_(i) - 1, static_cast<int>(lo)));
+            range(3 + i) = std::max(0, std::min(resolution_(i) - 1, static_cast<int>(hi)));
+        }
+    }
+
+    // Counts, then offsets, then fills.
+    offsets_.assign(count + 1, 0);
+    for(const auto& range : ranges)
+        for(auto z = range(2); z <= range(5); z++)
+            for(auto y = range(1); y <= range(4); y++)
+                for(auto x = range(0); x <= range(3); x++)
+                    offsets_[cell_index(x, y, z) + 1]++;
+
+    for(size_type c = 0; c < count; c++)
+        offsets_[c + 1] += offsets_[c];
+
+    triangles_.resize(offsets_[count]);
+    std::vector<index_type> cursor(offsets_.begin(), offsets_.end() - 1);
+    for(size_type t = 0; t < ranges.size(); t++)
+    {
+        const auto& range = ranges[t];
+        for(auto z = range(2); z <= range(5); z++)
+            for(auto y = range(1); y <= range(4); y++)
+                for(auto x = range(0); x <= range(3); x++)
+                    triangles_[cursor[cell_index(x, y, z)]++] = static_cast<index_type>(t);
+    }
+}
+
+/* Queries */
+
+template<typename T>
+template<typename Visitor>
+void
+UniformGrid<T>::traverse(const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Visitor visitor) const
+{
+    const auto inf = std::numeric_limits<T>::infinity();
+
+    // Would stay in one cell forever.
+    if((direction.array() == static_cast<T>(0)).all())
+        return;
+
+    // Clips the ray to the grid.
+    auto t0 = t_min;
+    auto t1 = t_max;
+    for(auto i = 0; i < 3; i++)
+    {
+        const auto lo = bounds_.min()(i);
+        const auto hi = bounds_.min()(i) + cell_size_(i) * static_cast<T>(resolution_(i));
+        if(direction(i) == static_cast<T>(0))
+        {
+            if(origin(i) < lo || origin(i) > hi)
+                return;
+            continue;
+        }
+        auto ta = (lo - origin(i)) / direction(i);
+        auto tb = (hi - origin(i)) / direction(i);
+        if(ta > tb)
+            std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+    }
+    if(t0 > t1)
+        return;
+
+    int index[3];
+    int step[3];
+    T t_next[3];
+    T t_delta[3];
+    for(auto i = 0; i < 3; i++)
+    {
+        const auto p = origin(i) + t0 * direction(i);
+        const auto c = std::floor((p - bounds_.min()(i)) / cell_size_(i));
+        index[i] = std::max(0, std::min(resolution_(i) - 1, static_cast<int>(c)));
+
+        if(direction(i) > static_cast<T>(0))
+        {
+            step[i] = 1;
+            t_next[i] = (bounds_.min()(i) + static_cast<T>(index[i] + 1) * cell_size_(i) - origin(i)) / direction(i);
+            t_delta[i] = cell_size_(i) / direction(i);
+        }
+        else if(direction(i) < static_cast<T>(0))
+        {
+            step[i] = -1;
+            t_next[i] = (bounds_.min()(i) + static_cast<T>(index[i]) * cell_size_(i) - origin(i)) / direction(i);
+            t_delta[i] = -cell_size_(i) / direction(i);
+        }
+        else
+        {
+            step[i] = 0;
+            t_next[i] = inf;
+            t_delta[i] = inf;
+        }
+    }
+
+    auto t = t0;
+    while(true)
+    {
+        const auto axis = (t_next[0] < t_next[1]) ? ((t_next[0] < t_next[2]) ? 0 : 2) : ((t_next[1] < t_next[2]) ? 1 : 2);
+        const auto t_exit = std::min(t_next[axis], t1);
+
+        if(!visitor(cell_index(index[0], index[1], index[2]), t, t_exit))
+            return;
+        if(t_next[axis] > t1)
+            return;
+
+        index[axis] += step[axis];
+        if(index[axis] < 0 || index[axis] >= resolution_(axis))
+            return;
+        t = t_next[axis];
+        t_next[axis] += t_delta[axis];
+    }
+}
+
+template<typename T>
+std::tuple<bool, RayHit<T>>
+UniformGrid<T>::find_closest_hit(const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Mailbox& mailbox) const
+{
+    const Plucker<T> ray(origin.homogeneous().eval(), (origin + direction).homogeneous().eval());
+    return find_closest_hit(ray, origin, direction, t_min, t_max, mailbox);
+}
+
+template<typename T>
+template<typename Derived>
+std::tuple<bool, RayHit<T>>
+UniformGrid<T>::find_closest_hit(const PluckerBase<T, Derived>& ray, const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Mailbox& mailbox) const
+{
+    const auto stamp = mailbox.next(mesh_->triangle_count());
+
+    auto found = false;
+    RayHit<T> closest;
+    closest.t = t_max;
+
+    traverse(origin, direction, t_min, t_max,
+        [&](size_type c, T, T t_exit)
+        {
+            const index_type* first;
+            const index_type* last;
+            std::tie(first, last) = cell(c);
+            for(; first != last; ++first)
+            {
+                if(!mailbox.visit(*first, stamp))
+                    continue;
+
+                const auto hit = find_hit(*mesh_, ray, origin, direction, *first);
+                if(std::get<0>(hit) && std::get<1>(hit).t >= t_min && std::get<1>(hit).t <= closest.t)
+                {
+                    closest = std::get<1>(hit);
+                    found = true;
+                }
+            }
+            // A hit within this cell is closer than any in the cells beyond.
+            return !(found && closest.t <= t_exit);
+        });
+
+    if(!found)
+        return std::make_tuple(false, RayHit<T>());
+
+    return std::make_tuple(true, closest);
+}
+
+template<typename T>
+bool
+UniformGrid<T>::has_intersection(const Vector3<T>& origin, const Vector3<T>& direction, T t_min, T t_max, Mailbox& mailbox) const
+{
+    const auto stamp = mailbox.next(mesh_->triangle_count());
+    const Plucker<T> ray(origin.homogeneous().eval(), (origin + direction).homogeneous().eval());
+
+    auto found = false;
+    traverse(origin, direction, t_min, t_max,
+        [&](size_type c, T, T)
+        {
+            const index_type* first;
+            const index_type* last;
+            std::tie(first, last) = cell(c);
+            for(; first != last; ++first)
+            {
+                if(!mailbox.visit(*first, stamp))
+                    continue;
+
+                const auto hit = find_hit(*mesh_, ray, origin, direction, *first);
+                if(std::get<0>(hit) && std::get<1>(hit).t >= t_min && std::get<1>(hit).t <= t_max)
+                {
+                    found = true;
+                    return false;
+                }
+            }
+            return true;
+        });
+    return found;
+}
+
+template<typename T>
+void
+UniformGrid<T>::find_closest_hits(
+    const Vector3Batch<T>& origins,
+    const Vector3Batch<T>& directions,
+    T t_min,
+    T t_max,
+    std::vector<RayHit<T>>& res,
+    unsigned num_threads) const
+{
+    const auto count = static_cast<size_type>(origins.rows());
+    res.resize(count);
+
+    detail::parallel_for(count, num_threads,
+        [&](size_type first, size_type last, unsigned)
+        {
+            Mailbox mailbox;
+            for(auto k = first; k < last; k++)
+            {
+                const auto row = static_cast<Eigen::Index>(k);
+                const auto hit = find_closest_hit(
+                    Vector3<T>(origins.row(row).transpose()), Vector3<T>(directions.row(row).transpose()),
+                    t_min, t_max, mailbox);
+                if(std::get<0>(hit))
+                {
+                    res[k] = std::get<1>(hit);
+                }
+                else
+                {
+                    res[k] = RayHit<T>();
+                    res[k].t = std::numeric_limits<T>::infinity();
+                }
+            }
+        });
+}
+
+}   // namespace plucker
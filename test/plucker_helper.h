@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <plucker/plucker_base.h>
+#include <plucker/edge_mesh.h>
+
+namespace plucker_helper
+{
+
+// The line directed from a point to another.
+template<typename T>
+plucker::Plucker<T> make_line(const plucker::Vector3<T>& from, const plucker::Vector3<T>& to)
+{
+    return plucker::Plucker<T>(from.homogeneous().eval(), to.homogeneous().eval());
+}
+
+// The vertices of an octahedron, the unit points on the axes.
+template<typename T>
+plucker::Vector3Batch<T> octahedron_vertices()
+{
+    plucker::Vector3Batch<T> vertices(6, 3);
+    vertices <<
+         T(1),  T(0),  T(0),
+        -T(1),  T(0),  T(0),
+         T(0),  T(1),  T(0),
+         T(0), -T(1),  T(0),
+         T(0),  T(0),  T(1),
+         T(0),  T(0), -T(1);
+    return vertices;
+}
+
+// The faces of an octahedron, counterclockwise seen from outside.
+template<typename T>
+typename plucker::EdgeMesh<T>::Triangles octahedron_triangles()
+{
+    typename plucker::EdgeMesh<T>::Triangles triangles(8, 3);
+    Eigen::Index row = 0;
+    for(std::uint32_t x = 0; x < 2; x++)
+    {
+        for(std::uint32_t y = 2; y < 4; y++)
+        {
+            for(std::uint32_t z = 4; z < 6; z++)
+            {
+                const auto odd = (x + y + z) % 2 == 1;
+                triangles.row(row++) << x, odd ? z : y, odd ? y : z;
+            }
+        }
+    }
+    return triangles;
+}
+
+// A closed octahedron whose faces are counterclockwise seen from outside.
+template<typename T>
+plucker::EdgeMesh<T> make_octahedron()
+{
+    return plucker::EdgeMesh<T>(octahedron_vertices<T>(), octahedron_triangles<T>());
+}
+
+}   // namespace plucker_helper
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/aligned_box.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class AlignedBoxTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // Reference slab test of a ray against a box.
+    static bool slab_test(const plucker::Vector3<T>& origin, const plucker::Vector3<T>& direction, const plucker::AlignedBox3<T>& box)
+    {
+        auto t0 = T(0);
+        auto t1 = std::numeric_limits<T>::infinity();
+        for(auto i = 0; i < 3; i++)
+        {
+            if(direction(i) == T(0))
+            {
+                if(origin(i) < box.min()(i) || origin(i) > box.max()(i))
+                    return false;
+                continue;
+            }
+            auto ta = (box.min()(i) - origin(i)) / direction(i);
+            auto tb = (box.max()(i) - origin(i)) / direction(i);
+            if(ta > tb)
+                std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+        }
+        return t0 <= t1;
+    }
+
+    static plucker::AlignedBoxBatch<T> make_boxes(Eigen::Index count)
+    {
+        plucker::AlignedBoxBatch<T> boxes(count, 6);
+        boxes.template leftCols<3>() = T(4) * plucker::Vector3Batch<T>::Random(count, 3);
+        boxes.template rightCols<3>() = boxes.template leftCols<3>().array()
+            + T(1) + plucker::Vector3Batch<T>::Random(count, 3).array().abs();
+        return boxes;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(AlignedBoxTest, MyTypes);
+
+TYPED_TEST(AlignedBoxTest, has_intersection)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Vector4 = plucker::Vector4<TypeParam>;
+    using AlignedBox3 = plucker::AlignedBox3<TypeParam>;
+    using BoxRay = plucker::BoxRay<TypeParam>;
+
+    const AlignedBox3 box(Vector3(TypeParam(-1), TypeParam(-1), TypeParam(-1)), Vector3(TypeParam(1), TypeParam(1), TypeParam(1)));
+
+    // A ray toward the box.
+    EXPECT_TRUE(has_intersection(BoxRay(Vector4(TypeParam(0), TypeParam(0), TypeParam(6), TypeParam(1)), Vector4(TypeParam(0), TypeParam(0), TypeParam(4), TypeParam(1))), box));
+    // A ray away from the box.
+    EXPECT_FALSE(has_intersection(BoxRay(Vector4(TypeParam(0), TypeParam(0), TypeParam(4), TypeParam(1)), Vector4(TypeParam(0), TypeParam(0), TypeParam(6), TypeParam(1))), box));
+    // A ray from inside the box.
+    EXPECT_TRUE(has_intersection(BoxRay(Vector3::Zero().eval(), Vector3(TypeParam(1), TypeParam(-2), TypeParam(3))), box));
+    // A ray passing by the box.
+    EXPECT_FALSE(has_intersection(BoxRay(Vector3(TypeParam(2), TypeParam(0), TypeParam(6)), Vector3(TypeParam(0), TypeParam(0), TypeParam(-1))), box));
+    // A diagonal ray.
+    EXPECT_TRUE(has_intersection(BoxRay(Vector3(TypeParam(5), TypeParam(-5), TypeParam(5)), Vector3(TypeParam(-1), TypeParam(1), TypeParam(-1))), box));
+    EXPECT_FALSE(has_intersection(BoxRay(Vector3(TypeParam(5), TypeParam(-3), TypeParam(5)), Vector3(TypeParam(-1), TypeParam(-1), TypeParam(-1))), box));
+}
+
+TYPED_TEST(AlignedBoxTest, has_intersection_against_slab_test)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using AlignedBox3 = plucker::AlignedBox3<TypeParam>;
+    using BoxRay = plucker::BoxRay<TypeParam>;
+
+    const auto boxes = AlignedBoxTest<TypeParam>::make_boxes(37);
+
+    std::vector<std::uint8_t> res;
+    for(auto n = 0; n < 200; n++)
+    {
+        const Vector3 origin = TypeParam(8) * Vector3::Random();
+        Vector3 direction = Vector3::Random();
+        // Some rays run parallel to the axes.
+        if(n % 4 == 0)
+            direction(n % 3) = TypeParam(0);
+
+        const BoxRay ray(origin, direction);
+        plucker::has_intersection(ray, boxes, res);
+
+        // The same from the line of the ray in external memory.
+        const plucker::Plucker<TypeParam> line(origin.homogeneous().eval(), (origin + direction).homogeneous().eval());
+        const BoxRay viewed(plucker::PluckerView<const TypeParam>(line), origin);
+
+        for(Eigen::Index b = 0; b < boxes.rows(); b++)
+        {
+            const AlignedBox3 box(boxes.row(b).template head<3>().transpose(), boxes.row(b).template tail<3>().transpose());
+            const auto expected = AlignedBoxTest<TypeParam>::slab_test(origin, direction, box);
+            EXPECT_EQ(expected, has_intersection(ray, box));
+            EXPECT_EQ(expected, has_intersection(viewed, box));
+            EXPECT_EQ(expected ? 1 : 0, res[static_cast<std::size_t>(b)]);
+        }
+
+        const auto mask4 = plucker::has_intersection<4>(ray, boxes, 16);
+        const auto mask16 = plucker::has_intersection<16>(ray, boxes, 16);
+        EXPECT_EQ(mask4, mask16 & 0xfu);
+        for(auto i = 0; i < 16; i++)
+            EXPECT_EQ(res[static_cast<std::size_t>(16 + i)], (mask16 >> i) & 1u);
+    }
+}
+
+}   // namespace
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/camera.h>
+#include <plucker/plucker_geometric.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class CameraTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    // A camera at (0.2, -0.1, 4) looking down, whose size is not a multiple of the tile.
+    static plucker::PinholeCamera<T> make_camera()
+    {
+        Eigen::Matrix<T, 3, 3> rotation;
+        rotation <<
+            T(1),  T(0),  T(0),
+            T(0), -T(1),  T(0),
+            T(0),  T(0), -T(1);
+        return plucker::PinholeCamera<T>(
+            plucker::Vector3<T>(T(0.2), T(-0.1), T(4)), rotation,
+            T(20), T(22), T(13), T(10), 27, 21);
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(CameraTest, MyTypes);
+
+TYPED_TEST(CameraTest, ray)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = CameraTest<TypeParam>::absolute_tolerance();
+
+    const auto camera = CameraTest<TypeParam>::make_camera();
+    EXPECT_EQ(27u * 21u, camera.pixel_count());
+
+    // Through the principal point, straight along the optical axis.
+    const Vector3 axis = camera.direction(12, 10) - Vector3(TypeParam(-0.5) / 20, TypeParam(-0.5) / 22, TypeParam(0));
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(0), TypeParam(0), TypeParam(-1)), axis, atol);
+
+    // Pixel (x, y) is centered at (x + 1/2, y + 1/2) in image coordinates.
+    const plucker::Vector2<TypeParam> center(TypeParam(7.5), TypeParam(3.5));
+    EXPECT_MAT_ALMOST_EQUAL(camera.direction(7, 3), camera.direction(center), atol);
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(camera.direction(center).normalized()), Vector3(camera.back_project(center).l()), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(0), plucker::distance(camera.back_project(center), camera.position()), TypeParam(10) * atol);
+
+    // The rays of a tile, from the linear forms, agree with lines through two points.
+    plucker::PluckerBatch<TypeParam> tile;
+    camera.tile_rays(3, 5, 4, 3, tile);
+    ASSERT_EQ(12, tile.rows());
+    for(auto j = 0; j < 3; j++)
+    {
+        for(auto i = 0; i < 4; i++)
+        {
+            const Vector3 direction = camera.direction(3 + i, 5 + j);
+            const plucker::Plucker<TypeParam> expected(
+                camera.position().homogeneous().eval(), (camera.position() + direction).homogeneous().eval());
+            const auto row = static_cast<Eigen::Index>(i + 4 * j);
+            EXPECT_MAT_ALMOST_EQUAL(plucker::Vector6<TypeParam>(expected.coord()), plucker::Vector6<TypeParam>(tile.row(row).transpose()), TypeParam(10) * atol);
+            EXPECT_MAT_ALMOST_EQUAL(plucker::Vector6<TypeParam>(expected.coord()), plucker::Vector6<TypeParam>(camera.ray(3 + i, 5 + j).coord()), TypeParam(10) * atol);
+        }
+    }
+}
+
+TYPED_TEST(CameraTest, find_closest_hits)
+{
+    constexpr auto atol = CameraTest<TypeParam>::absolute_tolerance();
+    const auto inf = std::numeric_limits<TypeParam>::infinity();
+
+    const auto mesh = plucker_helper::make_octahedron<TypeParam>();
+    const auto camera = CameraTest<TypeParam>::make_camera();
+
+    // Reference with explicit origins and directions.
+    const auto count = static_cast<Eigen::Index>(camera.pixel_count());
+    plucker::Vector3Batch<TypeParam> origins(count, 3);
+    plucker::Vector3Batch<TypeParam> directions(count, 3);
+    for(auto y = 0; y < camera.height(); y++)
+    {
+        for(auto x = 0; x < camera.width(); x++)
+        {
+            const auto row = static_cast<Eigen::Index>(x + camera.width() * y);
+            origins.row(row) = camera.position().transpose();
+            directions.row(row) = camera.direction(x, y).transpose();
+        }
+    }
+    std::vector<plucker::RayHit<TypeParam>> expected;
+    plucker::find_closest_hits(mesh, origins, directions, TypeParam(0), inf, expected, 1);
+
+    std::vector<plucker::RayHit<TypeParam>> hits;
+    plucker::find_closest_hits(mesh, camera, TypeParam(0), inf, hits, 3);
+    ASSERT_EQ(expected.size(), hits.size());
+
+    const plucker::UniformGrid<TypeParam> grid(mesh);
+    std::vector<plucker::RayHit<TypeParam>> grid_hits;
+    plucker::find_closest_hits(grid, camera, TypeParam(0), inf, grid_hits, 3);
+    ASSERT_EQ(expected.size(), grid_hits.size());
+
+    auto misses = 0;
+    for(std::size_t k = 0; k < expected.size(); k++)
+    {
+        if(std::isinf(expected[k].t))
+        {
+            misses++;
+            EXPECT_TRUE(std::isinf(hits[k].t));
+            EXPECT_TRUE(std::isinf(grid_hits[k].t));
+        }
+        else
+        {
+            EXPECT_EQ(expected[k].triangle, hits[k].triangle);
+            EXPECT_ALMOST_EQUAL(expected[k].t, hits[k].t, TypeParam(10) * atol);
+            EXPECT_ALMOST_EQUAL(expected[k].t, grid_hits[k].t, TypeParam(10) * atol);
+        }
+    }
+    // Both the octahedron and the background are in view.
+    EXPECT_LT(0, misses);
+    EXPECT_LT(misses, static_cast<int>(expected.size()));
+
+    // The depth of the top vertex below the camera.
+    const auto& center = hits[static_cast<std::size_t>(13 + camera.width() * 10)];
+    EXPECT_GT(TypeParam(3.5), center.t);
+}
+
+}   // namespace
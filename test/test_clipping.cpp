@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/clipping.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class ClippingTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // Area of a planar polygon.
+    static T area(const plucker::Vector3Batch<T>& polygon)
+    {
+        plucker::Vector3<T> sum = plucker::Vector3<T>::Zero();
+        for(Eigen::Index i = 0; i < polygon.rows(); i++)
+            sum += polygon.row(i).transpose().cross(polygon.row((i + 1) % polygon.rows()).transpose());
+        return T(0.5) * sum.norm();
+    }
+
+    // The unit square on z = 0, counterclockwise.
+    static plucker::Vector3Batch<T> make_square()
+    {
+        plucker::Vector3Batch<T> square(4, 3);
+        square <<
+            T(0), T(0), T(0),
+            T(1), T(0), T(0),
+            T(1), T(1), T(0),
+            T(0), T(1), T(0);
+        return square;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(ClippingTest, MyTypes);
+
+TYPED_TEST(ClippingTest, clip_polygon)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plane = plucker::Plane<TypeParam>;
+    using Planes = std::vector<Plane, Eigen::aligned_allocator<Plane>>;
+
+    constexpr auto atol = ClippingTest<TypeParam>::absolute_tolerance();
+
+    const auto square = ClippingTest<TypeParam>::make_square();
+
+    // Keeps x <= 0.5.
+    {
+        const auto res = plucker::clip(square, Plane(Vector3::UnitX(), TypeParam(-0.5)), atol);
+        EXPECT_EQ(4, res.rows());
+        EXPECT_ALMOST_EQUAL(TypeParam(0.5), ClippingTest<TypeParam>::area(res), atol);
+    }
+    // Keeps x + y <= 1, through two vertices.
+    {
+        const auto res = plucker::clip(square, Plane(Vector3(TypeParam(1), TypeParam(1), TypeParam(0)), TypeParam(-1)), atol);
+        EXPECT_EQ(3, res.rows());
+        EXPECT_ALMOST_EQUAL(TypeParam(0.5), ClippingTest<TypeParam>::area(res), atol);
+    }
+    // Everything and nothing.
+    EXPECT_EQ(4, plucker::clip(square, Plane(Vector3::UnitZ(), TypeParam(-1)), atol).rows());
+    EXPECT_EQ(0, plucker::clip(square, Plane(Vector3::UnitX(), TypeParam(2)), atol).rows());
+
+    // A box around the middle leaves a square of a quarter.
+    Planes planes;
+    planes.push_back(Plane(Vector3::UnitX(), TypeParam(-0.75)));
+    planes.push_back(Plane(-Vector3::UnitX(), TypeParam(0.25)));
+    planes.push_back(Plane(Vector3::UnitY(), TypeParam(-0.75)));
+    planes.push_back(Plane(-Vector3::UnitY(), TypeParam(0.25)));
+    const auto res = plucker::clip(square, planes.begin(), planes.end(), atol);
+    EXPECT_EQ(4, res.rows());
+    EXPECT_ALMOST_EQUAL(TypeParam(0.25), ClippingTest<TypeParam>::area(res), atol);
+}
+
+TYPED_TEST(ClippingTest, clip_segment)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plane = plucker::Plane<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+    using Planes = std::vector<Plane, Eigen::aligned_allocator<Plane>>;
+
+    constexpr auto atol = ClippingTest<TypeParam>::absolute_tolerance();
+
+    const Segment segment(Vector3(TypeParam(-1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(3), TypeParam(0), TypeParam(0)));
+
+    {
+        const auto res = plucker::clip(segment, Plane(Vector3::UnitX(), TypeParam(-1)), atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_MAT_ALMOST_EQUAL(segment.p0(), std::get<1>(res).p0(), atol);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)), std::get<1>(res).p1(), atol);
+    }
+    EXPECT_FALSE(std::get<0>(plucker::clip(segment, Plane(Vector3::UnitY(), TypeParam(1)), atol)));
+
+    Planes planes;
+    planes.push_back(Plane(Vector3::UnitX(), TypeParam(-2)));
+    planes.push_back(Plane(-Vector3::UnitX(), TypeParam(0)));
+    const auto res = plucker::clip(segment, planes.begin(), planes.end(), atol);
+    EXPECT_TRUE(std::get<0>(res));
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), std::get<1>(res).p0(), atol);
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(2), TypeParam(0), TypeParam(0)), std::get<1>(res).p1(), atol);
+}
+
+TYPED_TEST(ClippingTest, clip_with_views)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+
+    constexpr auto atol = ClippingTest<TypeParam>::absolute_tolerance();
+
+    // Planes keeping x <= 0.5 and y <= 0.5, in an external buffer.
+    const TypeParam coords[8] = {TypeParam(1), TypeParam(0), TypeParam(0), TypeParam(-0.5),
+                                 TypeParam(0), TypeParam(1), TypeParam(0), TypeParam(-0.5)};
+    const plucker::PlaneView<const TypeParam> planes[2] = {
+        plucker::PlaneView<const TypeParam>(coords), plucker::PlaneView<const TypeParam>(coords + 4)};
+
+    const auto square = ClippingTest<TypeParam>::make_square();
+    EXPECT_ALMOST_EQUAL(TypeParam(0.5), ClippingTest<TypeParam>::area(plucker::clip(square, planes[0], atol)), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(0.25), ClippingTest<TypeParam>::area(plucker::clip(square, planes, planes + 2, atol)), atol);
+
+    const Segment segment(Vector3(TypeParam(-1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(3), TypeParam(0), TypeParam(0)));
+    const auto res = plucker::clip(segment, planes[0], atol);
+    EXPECT_TRUE(std::get<0>(res));
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(0.5), TypeParam(0), TypeParam(0)), std::get<1>(res).p1(), atol);
+}
+
+TYPED_TEST(ClippingTest, clip_batch)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plane = plucker::Plane<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+    using Planes = std::vector<Plane, Eigen::aligned_allocator<Plane>>;
+
+    constexpr auto atol = ClippingTest<TypeParam>::absolute_tolerance();
+
+    // A frustum-like set of planes.
+    plucker::Vector4Batch<TypeParam> plane_batch(5, 4);
+    plane_batch <<
+        TypeParam(1), TypeParam(0), TypeParam(0.3), TypeParam(-1),
+        TypeParam(-1), TypeParam(0), TypeParam(0.3), TypeParam(-1),
+        TypeParam(0), TypeParam(1), TypeParam(0.3), TypeParam(-1),
+        TypeParam(0), TypeParam(-1), TypeParam(0.3), TypeParam(-1),
+        TypeParam(0), TypeParam(0), TypeParam(-1), TypeParam(-2);
+    Planes planes;
+    for(Eigen::Index p = 0; p < plane_batch.rows(); p++)
+        planes.push_back(Plane(plucker::Vector4<TypeParam>(plane_batch.row(p).transpose())));
+
+    // Triangles and quads anywhere around.
+    const std::size_t count = 200;
+    std::vector<std::size_t> offsets(1, 0);
+    for(std::size_t k = 0; k < count; k++)
+        offsets.push_back(offsets.back() + 3 + k % 2);
+
+    plucker::Vector3Batch<TypeParam> vertices(static_cast<Eigen::Index>(offsets.back()), 3);
+    for(std::size_t k = 0; k < count; k++)
+    {
+        const Vector3 center = TypeParam(3) * Vector3::Random();
+        const Vector3 u = Vector3::Random();
+        const Vector3 v = Vector3::Random();
+        const auto n = offsets[k + 1] - offsets[k];
+        for(std::size_t i = 0; i < n; i++)
+        {
+            const auto angle = TypeParam(6.283185307179586) * TypeParam(i) / TypeParam(n);
+            vertices.row(static_cast<Eigen::Index>(offsets[k] + i)) = (center + std::cos(angle) * u + std::sin(angle) * v).transpose();
+        }
+    }
+
+    plucker::Vector3Batch<TypeParam> res_vertices;
+    std::vector<std::size_t> res_offsets;
+    plucker::clip(vertices, offsets, plane_batch, atol, res_vertices, res_offsets, 3);
+    ASSERT_EQ(offsets.size(), res_offsets.size());
+    EXPECT_EQ(static_cast<std::size_t>(res_vertices.rows()), res_offsets.back());
+
+    auto clipped = 0;
+    for(std::size_t k = 0; k < count; k++)
+    {
+        const plucker::Vector3Batch<TypeParam> polygon = vertices.middleRows(static_cast<Eigen::Index>(offsets[k]), static_cast<Eigen::Index>(offsets[k + 1] - offsets[k]));
+        const auto expected = plucker::clip(polygon, planes.begin(), planes.end(), atol);
+        const auto n = static_cast<Eigen::Index>(res_offsets[k + 1] - res_offsets[k]);
+        ASSERT_EQ(expected.rows(), n);
+        for(Eigen::Index i = 0; i < n; i++)
+        {
+            const Vector3 vertex = res_vertices.row(static_cast<Eigen::Index>(res_offsets[k]) + i).transpose();
+            EXPECT_MAT_ALMOST_EQUAL(Vector3(expected.row(i).transpose()), vertex, TypeParam(10) * atol);
+        }
+        if(n > 0 && n != polygon.rows())
+            clipped++;
+    }
+    EXPECT_LT(0, clipped);
+
+    // Segments.
+    const plucker::SegmentBatch<TypeParam> segments = TypeParam(3) * plucker::SegmentBatch<TypeParam>::Random(300, 6);
+    plucker::SegmentBatch<TypeParam> res_segments;
+    std::vector<std::uint8_t> kept;
+    plucker::clip(segments, plane_batch, atol, res_segments, kept);
+    ASSERT_EQ(static_cast<std::size_t>(segments.rows()), kept.size());
+    for(Eigen::Index k = 0; k < segments.rows(); k++)
+    {
+        const Segment segment(segments.row(k).template head<3>().transpose(), segments.row(k).template tail<3>().transpose());
+        const auto expected = plucker::clip(segment, planes.begin(), planes.end(), atol);
+        EXPECT_EQ(std::get<0>(expected) ? 1 : 0, kept[static_cast<std::size_t>(k)]);
+        if(std::get<0>(expected) && kept[static_cast<std::size_t>(k)])
+        {
+            EXPECT_MAT_ALMOST_EQUAL(std::get<1>(expected).p0(), Vector3(res_segments.row(k).template head<3>().transpose()), TypeParam(10) * atol);
+            EXPECT_MAT_ALMOST_EQUAL(std::get<1>(expected).p1(), Vector3(res_segments.row(k).template tail<3>().transpose()), TypeParam(10) * atol);
+        }
+    }
+}
+
+TYPED_TEST(ClippingTest, clip_batch_boundary)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+
+    constexpr auto atol = ClippingTest<TypeParam>::absolute_tolerance();
+
+    // Keeps x <= 0.
+    plucker::Vector4Batch<TypeParam> plane_batch(1, 4);
+    plane_batch << TypeParam(1), TypeParam(0), TypeParam(0), TypeParam(0);
+    const plucker::Plane<TypeParam> plane(Vector3::UnitX(), TypeParam(0));
+
+    // One endpoint on the plane within tolerance and the other outside, both ways,
+    // and segments parallel to the plane inside, on and outside of it.
+    const auto h = atol / TypeParam(2);
+    plucker::SegmentBatch<TypeParam> segments(5, 6);
+    segments <<
+        h,             TypeParam(0), TypeParam(0), TypeParam(2), TypeParam(1), TypeParam(0),
+        TypeParam(2),  TypeParam(1), TypeParam(0), h,            TypeParam(0), TypeParam(0),
+        TypeParam(-1), TypeParam(0), TypeParam(0), TypeParam(-1), TypeParam(1), TypeParam(1),
+        h,             TypeParam(0), TypeParam(0), h,            TypeParam(2), TypeParam(0),
+        TypeParam(1),  TypeParam(0), TypeParam(0), TypeParam(1),  TypeParam(2), TypeParam(0);
+
+    plucker::SegmentBatch<TypeParam> res;
+    std::vector<std::uint8_t> kept;
+    plucker::clip(segments, plane_batch, atol, res, kept);
+    EXPECT_EQ((std::vector<std::uint8_t>{1, 1, 1, 1, 0}), kept);
+    for(Eigen::Index k = 0; k < segments.rows(); k++)
+    {
+        const Segment segment(segments.row(k).template head<3>().transpose(), segments.row(k).template tail<3>().transpose());
+        const auto expected = plucker::clip(segment, plane, atol);
+        ASSERT_EQ(std::get<0>(expected) ? 1 : 0, kept[static_cast<std::size_t>(k)]);
+        if(std::get<0>(expected))
+        {
+            EXPECT_MAT_ALMOST_EQUAL(std::get<1>(expected).p0(), Vector3(res.row(k).template head<3>().transpose()), atol);
+            EXPECT_MAT_ALMOST_EQUAL(std::get<1>(expected).p1(), Vector3(res.row(k).template tail<3>().transpose()), atol);
+        }
+    }
+}
+
+}   // namespace
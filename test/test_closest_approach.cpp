@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <plucker/plucker_base.h>
+#include <plucker/closest_approach.h>
+#include <plucker/plucker_find.h>
+#include <plucker/plucker_geometric.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class ClosestApproachTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(ClosestApproachTest, MyTypes);
+
+TYPED_TEST(ClosestApproachTest, find_closest_approach)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = ClosestApproachTest<TypeParam>::absolute_tolerance();
+
+    // Lines along x through (0, 3, 0) and along y through (1, 0, 2), closest at (1, 3, 0) and (1, 3, 2).
+    {
+        const Plucker line1(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(-3)));
+        const Plucker line2 = plucker_helper::make_line<TypeParam>(
+            Vector3(TypeParam(1), TypeParam(-3), TypeParam(2)), Vector3(TypeParam(1), TypeParam(-2), TypeParam(2)));
+
+        const auto res = plucker::find_closest_approach(line1, line2, atol);
+        ASSERT_TRUE(std::get<0>(res));
+        const auto& approach = std::get<1>(res);
+        EXPECT_ALMOST_EQUAL(TypeParam(1), approach.t1, atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(3), approach.t2, atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(4), approach.squared_distance, atol);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(3), TypeParam(0)), Vector3(approach.point1(line1).hnormalized()), atol);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(3), TypeParam(2)), Vector3(approach.point2(line2).hnormalized()), atol);
+    }
+
+    // Parallel lines.
+    {
+        const Plucker line1(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(0)));
+        const Plucker line2 = plucker_helper::make_line<TypeParam>(
+            Vector3(TypeParam(0), TypeParam(1), TypeParam(0)), Vector3(TypeParam(2), TypeParam(1), TypeParam(0)));
+        EXPECT_FALSE(std::get<0>(plucker::find_closest_approach(line1, line2, atol)));
+    }
+
+    // Points agree with find_closest_points, and distances with distance.
+    for(auto n = 0; n < 100; n++)
+    {
+        const Plucker line1 = plucker_helper::make_line<TypeParam>(Vector3::Random(), Vector3::Random());
+        const Plucker line2 = plucker_helper::make_line<TypeParam>(Vector3::Random(), Vector3::Random());
+
+        const auto res = plucker::find_closest_approach(line1, line2, atol);
+        const auto points = plucker::find_closest_points(line1, line2, atol);
+        ASSERT_EQ(std::get<0>(points), std::get<0>(res));
+        if(!std::get<0>(res))
+            continue;
+
+        const auto& approach = std::get<1>(res);
+        const auto scale = TypeParam(1) + std::abs(approach.t1) + std::abs(approach.t2);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(std::get<1>(points).hnormalized()), Vector3(approach.point1(line1).hnormalized()), scale * atol);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(std::get<2>(points).hnormalized()), Vector3(approach.point2(line2).hnormalized()), scale * atol);
+
+        const auto d = plucker::distance(line1, line2, atol);
+        EXPECT_ALMOST_EQUAL(d * d, approach.squared_distance, scale * atol);
+    }
+}
+
+TYPED_TEST(ClosestApproachTest, find_intersection_parameter)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using Plane = plucker::Plane<TypeParam>;
+
+    constexpr auto atol = ClosestApproachTest<TypeParam>::absolute_tolerance();
+
+    const Plane plane(TypeParam(0), TypeParam(0), TypeParam(1), TypeParam(-2));
+    for(auto n = 0; n < 100; n++)
+    {
+        const Plucker line = plucker_helper::make_line<TypeParam>(Vector3::Random(), Vector3::Random());
+
+        const auto res = plucker::find_intersection_parameter(line, plane, atol);
+        const auto point = plucker::find_intersection(line, plane, atol);
+        ASSERT_EQ(std::get<0>(point), std::get<0>(res));
+        if(!std::get<0>(res))
+            continue;
+
+        const auto t = std::get<1>(res);
+        const auto scale = TypeParam(1) + std::abs(t);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(std::get<1>(point).hnormalized()), Vector3(plucker::point_on_line(line, t).hnormalized()), scale * atol);
+    }
+
+    const Plucker line(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(0)));
+    EXPECT_FALSE(std::get<0>(plucker::find_intersection_parameter(line, plane, atol)));
+}
+
+TYPED_TEST(ClosestApproachTest, batch)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = ClosestApproachTest<TypeParam>::absolute_tolerance();
+
+    const Plucker line = plucker_helper::make_line<TypeParam>(Vector3::Random(), Vector3::Random());
+
+    const Eigen::Index count = 150;
+    plucker::PluckerBatch<TypeParam> lines(count, 6);
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        // Every fifth line is parallel to the first one.
+        const Vector3 from = Vector3::Random();
+        const Vector3 to = (k % 5 == 0) ? (from + TypeParam(2) * line.l()).eval() : Vector3::Random().eval();
+        lines.row(k) = plucker_helper::make_line<TypeParam>(from, to).coord().transpose();
+    }
+
+    plucker::VectorX<TypeParam> t1(count);
+    plucker::VectorX<TypeParam> t2(count);
+    plucker::VectorX<TypeParam> squared_distances(count);
+    plucker::find_closest_approaches(line, lines, atol, t1, t2, squared_distances);
+
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        const Plucker other(plucker::Vector6<TypeParam>(lines.row(k).transpose()));
+        const auto res = plucker::find_closest_approach(line, other, atol);
+        const auto d = plucker::distance(line, other, atol);
+        const auto scale = TypeParam(1) + d * d;
+
+        EXPECT_ALMOST_EQUAL(d * d, squared_distances(k), scale * TypeParam(10) * atol);
+        if(std::get<0>(res))
+        {
+            EXPECT_ALMOST_EQUAL(std::get<1>(res).t1, t1(k), scale * TypeParam(10) * atol);
+            EXPECT_ALMOST_EQUAL(std::get<1>(res).t2, t2(k), scale * TypeParam(10) * atol);
+        }
+        else
+        {
+            EXPECT_TRUE(std::isnan(t1(k)));
+            EXPECT_TRUE(std::isnan(t2(k)));
+        }
+    }
+
+    // Intersections with a plane.
+    const plucker::Plane<TypeParam> plane(TypeParam(1), TypeParam(2), TypeParam(-1), TypeParam(0.5));
+    plucker::VectorX<TypeParam> ts(count);
+    plucker::find_intersection_parameters(lines, plane, atol, ts);
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        const Plucker other(plucker::Vector6<TypeParam>(lines.row(k).transpose()));
+        const auto res = plucker::find_intersection_parameter(other, plane, atol);
+        if(std::get<0>(res))
+        {
+            EXPECT_ALMOST_EQUAL(std::get<1>(res), ts(k), (TypeParam(1) + std::abs(ts(k))) * TypeParam(10) * atol);
+        }
+        else
+        {
+            EXPECT_TRUE(std::isnan(ts(k)));
+        }
+    }
+
+    // The same through views of the line and the plane.
+    plucker::VectorX<TypeParam> squared_distances_from_view(count);
+    plucker::find_closest_approaches(plucker::PluckerView<const TypeParam>(line), lines, atol, t1, t2, squared_distances_from_view);
+    EXPECT_TRUE(squared_distances.isApprox(squared_distances_from_view));
+    plucker::VectorX<TypeParam> ts_from_view(count);
+    plucker::find_intersection_parameters(lines, plucker::PlaneView<const TypeParam>(plane), atol, ts_from_view);
+    for(Eigen::Index k = 0; k < count; k++)
+        EXPECT_TRUE((std::isnan(ts(k)) && std::isnan(ts_from_view(k))) || ts(k) == ts_from_view(k));
+}
+
+}   // namespace
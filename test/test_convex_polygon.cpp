@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/convex_polygon.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class ConvexPolygonTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // The triangle test in README.
+    static bool has_intersection(
+        const plucker::Plucker<T>& ray,
+        const plucker::Vector4<T>& p1,
+        const plucker::Vector4<T>& p2,
+        const plucker::Vector4<T>& p3)
+    {
+        if(ray * plucker::Plucker<T>(p1, p2) > T(0))
+            return false;
+        if(ray * plucker::Plucker<T>(p2, p3) > T(0))
+            return false;
+        if(ray * plucker::Plucker<T>(p3, p1) > T(0))
+            return false;
+        return true;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(ConvexPolygonTest, MyTypes);
+
+TYPED_TEST(ConvexPolygonTest, Constructor)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using Quad = plucker::Quad<TypeParam>;
+
+    constexpr auto atol = ConvexPolygonTest<TypeParam>::absolute_tolerance();
+
+    typename Quad::Vertices vertices;
+    vertices <<
+        TypeParam(0), TypeParam(0), TypeParam(0),
+        TypeParam(1), TypeParam(0), TypeParam(0),
+        TypeParam(1), TypeParam(1), TypeParam(0),
+        TypeParam(0), TypeParam(1), TypeParam(0);
+
+    const Quad quad(vertices);
+    EXPECT_EQ(4, quad.size());
+    for(Eigen::Index i = 0; i < 4; i++)
+    {
+        const Vector3 from = vertices.row(i).transpose();
+        const Vector3 to = vertices.row((i + 1) % 4).transpose();
+        EXPECT_MAT_ALMOST_EQUAL(Plucker(from.homogeneous().eval(), to.homogeneous().eval()).coord(), quad.edge(i).coord(), atol);
+    }
+}
+
+TYPED_TEST(ConvexPolygonTest, Alignment)
+{
+    using Triangle = plucker::ConvexPolygon<TypeParam, 3>;
+
+    // The vertices of a triangle of doubles take 72 bytes, but its edges take 144.
+    if((sizeof(typename Triangle::Edges) % 16) != 0)
+        GTEST_SKIP_("It does not need to be aligned.");
+
+    typename Triangle::Vertices vertices;
+    vertices <<
+        TypeParam(0), TypeParam(0), TypeParam(0),
+        TypeParam(1), TypeParam(0), TypeParam(0),
+        TypeParam(0), TypeParam(1), TypeParam(0);
+
+    {
+        Triangle* p = new Triangle(vertices);
+        const auto addr = reinterpret_cast<std::uintptr_t>(p->edges().data());
+        EXPECT_TRUE((addr % 16) == 0);
+        delete p;
+    }
+    {
+        Triangle* p = new Triangle[2];
+        const auto addr0 = reinterpret_cast<std::uintptr_t>(p[0].edges().data());
+        const auto addr1 = reinterpret_cast<std::uintptr_t>(p[1].edges().data());
+        EXPECT_TRUE((addr0 % 16) == 0);
+        EXPECT_TRUE((addr1 % 16) == 0);
+        delete[] p;
+    }
+}
+
+TYPED_TEST(ConvexPolygonTest, has_intersection)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Vector4 = plucker::Vector4<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using Quad = plucker::Quad<TypeParam>;
+    using Polygon = plucker::ConvexPolygon<TypeParam>;
+
+    // A quad and a regular hexagon on the plane z = -2.
+    typename Quad::Vertices quad_vertices;
+    quad_vertices <<
+        TypeParam(-2), TypeParam(-1), TypeParam(-2),
+        TypeParam(2), TypeParam(-2), TypeParam(-2),
+        TypeParam(3), TypeParam(2), TypeParam(-2),
+        TypeParam(-1), TypeParam(1), TypeParam(-2);
+    const Quad quad(quad_vertices);
+
+    typename Polygon::Vertices hexagon_vertices(6, 3);
+    for(Eigen::Index i = 0; i < 6; i++)
+    {
+        const auto angle = TypeParam(i) * TypeParam(1.0471975511965976);
+        hexagon_vertices.row(i) << TypeParam(2) * std::cos(angle), TypeParam(2) * std::sin(angle), TypeParam(-2);
+    }
+    const Polygon hexagon(hexagon_vertices);
+
+    const auto vertex = [&](Eigen::Index i) -> Vector4 { return quad_vertices.row(i).transpose().homogeneous(); };
+
+    for(auto n = 0; n < 500; n++)
+    {
+        const Vector3 from = Vector3(TypeParam(0), TypeParam(0), TypeParam(6)) + TypeParam(4) * Vector3::Random();
+        const Vector3 to = Vector3(TypeParam(0), TypeParam(0), TypeParam(-2)) + TypeParam(4) * Vector3::Random();
+        const Plucker ray(from.homogeneous().eval(), to.homogeneous().eval());
+
+        // Same as the quad split into two triangles.
+        const auto expected = ConvexPolygonTest<TypeParam>::has_intersection(ray, vertex(0), vertex(1), vertex(2))
+                           || ConvexPolygonTest<TypeParam>::has_intersection(ray, vertex(0), vertex(2), vertex(3));
+        EXPECT_EQ(expected, has_intersection(ray, quad));
+        EXPECT_EQ(expected, has_intersection(plucker::PluckerView<const TypeParam>(ray), quad));
+
+        // Inside the hexagon means within the inscribed circle at least.
+        const auto hit = (to - from).z() < TypeParam(0) && [&]
+        {
+            const auto t = (TypeParam(-2) - from.z()) / (to - from).z();
+            return (from + t * (to - from)).template head<2>().norm() < TypeParam(1.7);
+        }();
+        if(hit)
+        {
+            EXPECT_TRUE(has_intersection(ray, hexagon));
+        }
+    }
+
+    // Seen from behind.
+    const Plucker ray(Vector4(TypeParam(0), TypeParam(0), TypeParam(-6), TypeParam(1)), Vector4(TypeParam(0), TypeParam(0), TypeParam(-4), TypeParam(1)));
+    EXPECT_FALSE(has_intersection(ray, hexagon));
+}
+
+TYPED_TEST(ConvexPolygonTest, has_intersection_batch)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using Quad = plucker::Quad<TypeParam>;
+
+    std::vector<Quad, Eigen::aligned_allocator<Quad>> quads;
+    for(auto i = 0; i < 300; i++)
+    {
+        const Vector3 center = TypeParam(2) * Vector3::Random();
+        typename Quad::Vertices vertices;
+        vertices <<
+            center.x() - TypeParam(1), center.y() - TypeParam(1), center.z(),
+            center.x() + TypeParam(1), center.y() - TypeParam(1), center.z(),
+            center.x() + TypeParam(1), center.y() + TypeParam(1), center.z(),
+            center.x() - TypeParam(1), center.y() + TypeParam(1), center.z();
+        quads.push_back(Quad(vertices));
+    }
+
+    plucker::QuadBatch<TypeParam> batch(quads.size(), 24);
+    for(std::size_t i = 0; i < quads.size(); i++)
+        plucker::store(quads[i], batch, static_cast<Eigen::Index>(i));
+
+    std::vector<std::uint8_t> res;
+    for(auto n = 0; n < 20; n++)
+    {
+        const Vector3 from = Vector3(TypeParam(0), TypeParam(0), TypeParam(6)) + Vector3::Random();
+        const Vector3 to = TypeParam(2) * Vector3::Random();
+        const Plucker ray(from.homogeneous().eval(), to.homogeneous().eval());
+
+        plucker::has_intersection(ray, batch, res);
+        ASSERT_EQ(quads.size(), res.size());
+        for(std::size_t i = 0; i < quads.size(); i++)
+            EXPECT_EQ(has_intersection(ray, quads[i]) ? 1 : 0, res[i]);
+
+        // The same through a view of the ray.
+        std::vector<std::uint8_t> viewed;
+        plucker::has_intersection(plucker::PluckerView<const TypeParam>(ray), batch, viewed);
+        EXPECT_EQ(res, viewed);
+    }
+}
+
+}   // namespace
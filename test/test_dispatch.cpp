@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/dispatch.h>
+#include <plucker/plucker_geometric.h>
+#include <plucker/plucker_query.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class DispatchTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    /**
+     * Returns random lines, a count that leaves a remainder for every width.
+     */
+    static plucker::PluckerBatch<T> make_lines()
+    {
+        const Eigen::Index count = 53;
+        plucker::PluckerBatch<T> lines(count, 6);
+        for(Eigen::Index k = 0; k < count; k++)
+            lines.row(k) = plucker_helper::make_line<T>(plucker::Vector3<T>::Random(), plucker::Vector3<T>::Random()).coord().transpose();
+        return lines;
+    }
+
+    /**
+     * Returns the instruction sets the CPU supports.
+     */
+    static std::vector<plucker::dispatch::InstructionSet> instruction_sets()
+    {
+        std::vector<plucker::dispatch::InstructionSet> res{plucker::dispatch::InstructionSet::baseline};
+        if(plucker::dispatch::instruction_set() >= plucker::dispatch::InstructionSet::avx2)
+            res.push_back(plucker::dispatch::InstructionSet::avx2);
+        if(plucker::dispatch::instruction_set() >= plucker::dispatch::InstructionSet::avx512)
+            res.push_back(plucker::dispatch::InstructionSet::avx512);
+        return res;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(DispatchTest, MyTypes);
+
+TYPED_TEST(DispatchTest, product)
+{
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = DispatchTest<TypeParam>::absolute_tolerance();
+
+    const Plucker line = plucker_helper::make_line<TypeParam>(plucker::Vector3<TypeParam>::Random(), plucker::Vector3<TypeParam>::Random());
+    const plucker::PluckerBatch<TypeParam> lines = DispatchTest<TypeParam>::make_lines();
+
+    for(const auto set : DispatchTest<TypeParam>::instruction_sets())
+    {
+        plucker::VectorX<TypeParam> res(lines.rows());
+        plucker::dispatch::product(line, lines, res, set);
+        for(Eigen::Index k = 0; k < lines.rows(); k++)
+        {
+            const Plucker other(plucker::Vector6<TypeParam>(lines.row(k).transpose()));
+            EXPECT_ALMOST_EQUAL(line * other, res(k), atol);
+        }
+    }
+}
+
+TYPED_TEST(DispatchTest, normalize)
+{
+    using Vector6 = plucker::Vector6<TypeParam>;
+
+    constexpr auto atol = DispatchTest<TypeParam>::absolute_tolerance();
+
+    const plucker::PluckerBatch<TypeParam> lines = DispatchTest<TypeParam>::make_lines();
+
+    for(const auto set : DispatchTest<TypeParam>::instruction_sets())
+    {
+        plucker::PluckerBatch<TypeParam> res = lines;
+        plucker::dispatch::normalize(res, set);
+        for(Eigen::Index k = 0; k < lines.rows(); k++)
+        {
+            const Vector6 expected = lines.row(k).transpose() / lines.row(k).head(3).norm();
+            EXPECT_MAT_ALMOST_EQUAL(expected, Vector6(res.row(k).transpose()), atol);
+        }
+    }
+}
+
+TYPED_TEST(DispatchTest, squared_distance)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = DispatchTest<TypeParam>::absolute_tolerance();
+
+    const auto line = plucker_helper::make_line<TypeParam>(Vector3::Random(), Vector3::Random());
+    const plucker::Vector3Batch<TypeParam> points = plucker::Vector3Batch<TypeParam>::Random(37, 3);
+
+    // The moment of the line about the point, i.e. m - p x l.
+    const auto expected = [&](Eigen::Index k)
+    {
+        const Vector3 p = points.row(k).transpose();
+        return (line.m() - p.cross(line.l())).squaredNorm() / line.l().squaredNorm();
+    };
+
+    for(const auto set : DispatchTest<TypeParam>::instruction_sets())
+    {
+        plucker::VectorX<TypeParam> res(points.rows());
+        plucker::dispatch::squared_distance(line, points, res, set);
+        for(Eigen::Index k = 0; k < points.rows(); k++)
+            EXPECT_ALMOST_EQUAL(expected(k), res(k), atol);
+    }
+
+    // The default is the widest instruction set.
+    plucker::VectorX<TypeParam> res(points.rows());
+    plucker::dispatch::squared_distance(line, points, res);
+    EXPECT_ALMOST_EQUAL(expected(0), res(0), atol);
+
+    // The Eigen function of the same name is still found for a line and points.
+    plucker::VectorX<TypeParam> eigen_res(points.rows());
+    plucker::squared_distance(line, points, eigen_res);
+    squared_distance(line, points, eigen_res);
+    EXPECT_ALMOST_EQUAL(expected(0), eigen_res(0), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(1), normalize(line).l().norm(), atol);
+}
+
+TYPED_TEST(DispatchTest, intersection_tests)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = DispatchTest<TypeParam>::absolute_tolerance();
+
+    const Vector3 from = Vector3::Random();
+    const Vector3 to = Vector3::Random();
+    const auto line = plucker_helper::make_line<TypeParam>(from, to);
+    plucker::PluckerBatch<TypeParam> lines = DispatchTest<TypeParam>::make_lines();
+    for(Eigen::Index k = 0; k < lines.rows(); k += 3)
+    {
+        // Every sixth line is parallel to the line, and the others of every third cross it.
+        const Vector3 point = (k % 2 == 0) ? Vector3::Random().eval() : (from + TypeParam(0.3) * (to - from)).eval();
+        const Vector3 other = (k % 2 == 0) ? (point + line.l()).eval() : Vector3::Random().eval();
+        lines.row(k) = plucker_helper::make_line<TypeParam>(point, other).coord().transpose();
+    }
+
+    std::vector<std::uint8_t> coplanar;
+    std::vector<std::uint8_t> intersecting;
+    for(const auto set : DispatchTest<TypeParam>::instruction_sets())
+    {
+        plucker::dispatch::are_coplanar(line, lines, atol, coplanar, set);
+        plucker::dispatch::has_intersection(line, lines, atol, intersecting, set);
+        ASSERT_EQ(static_cast<std::size_t>(lines.rows()), coplanar.size());
+        ASSERT_EQ(static_cast<std::size_t>(lines.rows()), intersecting.size());
+        for(Eigen::Index k = 0; k < lines.rows(); k++)
+        {
+            const plucker::Plucker<TypeParam> other(plucker::Vector6<TypeParam>(lines.row(k).transpose()));
+            const auto i = static_cast<std::size_t>(k);
+            EXPECT_EQ(plucker::are_coplanar(line, other, atol), coplanar[i] == 1);
+            EXPECT_EQ(plucker::has_intersection(line, other, atol), intersecting[i] == 1);
+            if(k % 3 == 0)
+            {
+                EXPECT_EQ(1, coplanar[i]);
+                EXPECT_EQ(k % 2 == 0 ? 0 : 1, intersecting[i]);
+            }
+        }
+    }
+}
+
+TYPED_TEST(DispatchTest, views)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using View = plucker::PluckerView<const TypeParam>;
+
+    constexpr auto atol = DispatchTest<TypeParam>::absolute_tolerance();
+
+    const auto line = plucker_helper::make_line<TypeParam>(Vector3::Random(), Vector3::Random());
+    const View view(line);
+    const plucker::PluckerBatch<TypeParam> lines = DispatchTest<TypeParam>::make_lines();
+    const plucker::Vector3Batch<TypeParam> points = plucker::Vector3Batch<TypeParam>::Random(37, 3);
+
+    for(const auto set : DispatchTest<TypeParam>::instruction_sets())
+    {
+        plucker::VectorX<TypeParam> expected(lines.rows());
+        plucker::VectorX<TypeParam> res(lines.rows());
+        plucker::dispatch::product(line, lines, expected, set);
+        plucker::dispatch::product(view, lines, res, set);
+        for(Eigen::Index k = 0; k < res.size(); k++)
+            EXPECT_ALMOST_EQUAL(expected(k), res(k), atol);
+
+        expected.resize(points.rows());
+        res.resize(points.rows());
+        plucker::dispatch::squared_distance(line, points, expected, set);
+        plucker::dispatch::squared_distance(view, points, res, set);
+        for(Eigen::Index k = 0; k < res.size(); k++)
+            EXPECT_ALMOST_EQUAL(expected(k), res(k), atol);
+
+        std::vector<std::uint8_t> expected_flags;
+        std::vector<std::uint8_t> flags;
+        plucker::dispatch::are_coplanar(line, lines, atol, expected_flags, set);
+        plucker::dispatch::are_coplanar(view, lines, atol, flags, set);
+        EXPECT_EQ(expected_flags, flags);
+        plucker::dispatch::has_intersection(line, lines, atol, expected_flags, set);
+        plucker::dispatch::has_intersection(view, lines, atol, flags, set);
+        EXPECT_EQ(expected_flags, flags);
+    }
+}
+
+}   // namespace
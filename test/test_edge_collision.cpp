@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/edge_collision.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class EdgeCollisionTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    static plucker::MovingEdge<T> make_random_edge()
+    {
+        using Vector3 = plucker::Vector3<T>;
+        using Segment = plucker::Segment<T>;
+
+        const Segment start(Vector3::Random(), Vector3::Random());
+        const Vector3 v0 = Vector3::Random();
+        const Vector3 v1 = Vector3::Random();
+        return plucker::MovingEdge<T>(start, Segment(start.p0() + v0, start.p1() + v1));
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(EdgeCollisionTest, MyTypes);
+
+TYPED_TEST(EdgeCollisionTest, coplanarity_polynomial)
+{
+    constexpr auto atol = EdgeCollisionTest<TypeParam>::absolute_tolerance();
+
+    for(auto n = 0; n < 20; n++)
+    {
+        const auto edge1 = EdgeCollisionTest<TypeParam>::make_random_edge();
+        const auto edge2 = EdgeCollisionTest<TypeParam>::make_random_edge();
+        const auto c = plucker::detail::coplanarity_polynomial(edge1, edge2);
+        for(auto i = 0; i <= 4; i++)
+        {
+            const auto t = TypeParam(i) / TypeParam(4);
+            const auto expected = edge1.at(t).line() * edge2.at(t).line();
+            EXPECT_ALMOST_EQUAL(expected, plucker::detail::evaluate_cubic(c, t), TypeParam(10) * atol);
+        }
+    }
+}
+
+TYPED_TEST(EdgeCollisionTest, find_collision)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+    using MovingEdge = plucker::MovingEdge<TypeParam>;
+
+    constexpr auto atol = EdgeCollisionTest<TypeParam>::absolute_tolerance();
+    const auto distance_tolerance = TypeParam(1e-3);
+    const auto time_tolerance = TypeParam(1e-5);
+
+    const Segment fixed(Vector3(TypeParam(-1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(1), TypeParam(0), TypeParam(0)));
+    const MovingEdge edge1(fixed, fixed);
+
+    // An edge falling across the fixed one.
+    {
+        const MovingEdge edge2(
+            Segment(Vector3(TypeParam(0.5), TypeParam(-1), TypeParam(1)), Vector3(TypeParam(0.5), TypeParam(1), TypeParam(1))),
+            Segment(Vector3(TypeParam(0.5), TypeParam(-1), TypeParam(-3)), Vector3(TypeParam(0.5), TypeParam(1), TypeParam(-3))));
+        const auto res = find_collision(edge1, edge2, distance_tolerance, time_tolerance);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(0.25), std::get<1>(res), TypeParam(10) * atol);
+    }
+    // An edge falling past the end of the fixed one, so coplanar without contact.
+    {
+        const MovingEdge edge2(
+            Segment(Vector3(TypeParam(2), TypeParam(-1), TypeParam(1)), Vector3(TypeParam(2), TypeParam(1), TypeParam(1))),
+            Segment(Vector3(TypeParam(2), TypeParam(-1), TypeParam(-1)), Vector3(TypeParam(2), TypeParam(1), TypeParam(-1))));
+        EXPECT_FALSE(std::get<0>(find_collision(edge1, edge2, distance_tolerance, time_tolerance)));
+    }
+    // An edge turning about its middle, which touches the fixed one twice.
+    {
+        const MovingEdge edge2(
+            Segment(Vector3(TypeParam(0), TypeParam(-1), TypeParam(1)), Vector3(TypeParam(0), TypeParam(1), TypeParam(-1))),
+            Segment(Vector3(TypeParam(0), TypeParam(-1), TypeParam(-1)), Vector3(TypeParam(0), TypeParam(1), TypeParam(1))));
+        const auto res = find_collision(edge1, edge2, distance_tolerance, time_tolerance);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_GT(TypeParam(0.5), std::get<1>(res));
+    }
+
+    // A contact found is a contact.
+    for(auto n = 0; n < 200; n++)
+    {
+        const auto edge2 = EdgeCollisionTest<TypeParam>::make_random_edge();
+        const auto edge3 = EdgeCollisionTest<TypeParam>::make_random_edge();
+        const auto res = find_collision(edge2, edge3, distance_tolerance, time_tolerance);
+        if(!std::get<0>(res))
+            continue;
+        EXPECT_LE(TypeParam(0), std::get<1>(res));
+        EXPECT_GE(TypeParam(1), std::get<1>(res));
+        EXPECT_GE(distance_tolerance, distance(edge2.at(std::get<1>(res)), edge3.at(std::get<1>(res))));
+    }
+}
+
+TYPED_TEST(EdgeCollisionTest, find_collision_coplanar)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+    using MovingEdge = plucker::MovingEdge<TypeParam>;
+
+    const auto distance_tolerance = TypeParam(1e-3);
+    const auto time_tolerance = TypeParam(1e-5);
+
+    // Edges of a flat cloth on a tilted plane, where the cubic of coplanarity is rounding noise.
+    const Eigen::Matrix<TypeParam, 3, 3> rotation
+        = Eigen::AngleAxis<TypeParam>(TypeParam(0.7), Vector3(TypeParam(1), TypeParam(2), TypeParam(3)).normalized()).toRotationMatrix();
+    const Vector3 offset(TypeParam(0.3), TypeParam(-0.2), TypeParam(0.5));
+    const auto on_plane = [&](TypeParam x, TypeParam y) -> Vector3 { return rotation * Vector3(x, y, TypeParam(0)) + offset; };
+
+    const Segment fixed(on_plane(TypeParam(-1), TypeParam(0)), on_plane(TypeParam(1), TypeParam(0)));
+    const MovingEdge edge1(fixed, fixed);
+
+    // A parallel edge sliding onto the fixed one.
+    {
+        const MovingEdge edge2(
+            Segment(on_plane(TypeParam(-1), TypeParam(1)), on_plane(TypeParam(1), TypeParam(1))),
+            Segment(on_plane(TypeParam(-1), TypeParam(-1)), on_plane(TypeParam(1), TypeParam(-1))));
+        const auto res = find_collision(edge1, edge2, distance_tolerance, time_tolerance);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(0.5), std::get<1>(res), distance_tolerance);
+        EXPECT_GE(distance_tolerance, distance(edge1.at(std::get<1>(res)), edge2.at(std::get<1>(res))));
+    }
+    // A crossing edge turning into the end of the fixed one.
+    {
+        const MovingEdge edge2(
+            Segment(on_plane(TypeParam(2), TypeParam(-1)), on_plane(TypeParam(2), TypeParam(1))),
+            Segment(on_plane(TypeParam(2), TypeParam(-1)), on_plane(TypeParam(-2), TypeParam(1))));
+        const auto res = find_collision(edge1, edge2, distance_tolerance, time_tolerance);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(0.5), std::get<1>(res), distance_tolerance);
+    }
+    // An edge sliding along the fixed one without contact.
+    {
+        const MovingEdge edge2(
+            Segment(on_plane(TypeParam(-1), TypeParam(0.5)), on_plane(TypeParam(1), TypeParam(0.5))),
+            Segment(on_plane(TypeParam(2), TypeParam(0.5)), on_plane(TypeParam(4), TypeParam(0.5))));
+        EXPECT_FALSE(std::get<0>(find_collision(edge1, edge2, distance_tolerance, time_tolerance)));
+    }
+}
+
+TYPED_TEST(EdgeCollisionTest, find_collisions)
+{
+    const Eigen::Index count = 60;
+
+    plucker::MovingEdgeBatch<TypeParam> edges(count, 12);
+    for(Eigen::Index i = 0; i < count; i++)
+        plucker::store(EdgeCollisionTest<TypeParam>::make_random_edge(), edges, i);
+
+    std::vector<plucker::IndexPair> pairs;
+    for(std::size_t i = 0; i < static_cast<std::size_t>(count); i++)
+        for(auto j = i + 1; j < static_cast<std::size_t>(count); j++)
+            pairs.emplace_back(i, j);
+
+    const auto distance_tolerance = TypeParam(1e-3);
+    const auto time_tolerance = TypeParam(1e-5);
+
+    plucker::VectorX<TypeParam> times;
+    plucker::find_collisions(edges, pairs, distance_tolerance, time_tolerance, times, 3);
+    ASSERT_EQ(static_cast<Eigen::Index>(pairs.size()), times.size());
+
+    auto hits = 0;
+    for(std::size_t k = 0; k < pairs.size(); k++)
+    {
+        const auto edge1 = plucker::load(edges, static_cast<Eigen::Index>(pairs[k].first));
+        const auto edge2 = plucker::load(edges, static_cast<Eigen::Index>(pairs[k].second));
+        const auto res = find_collision(edge1, edge2, distance_tolerance, time_tolerance);
+        const auto t = times(static_cast<Eigen::Index>(k));
+        EXPECT_EQ(std::get<0>(res), std::isfinite(t));
+        if(std::get<0>(res))
+        {
+            EXPECT_EQ(std::get<1>(res), t);
+            hits++;
+        }
+    }
+    EXPECT_LT(0, hits);
+}
+
+}   // namespace
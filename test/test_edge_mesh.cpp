@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/edge_mesh.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class EdgeMeshTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(EdgeMeshTest, MyTypes);
+
+TYPED_TEST(EdgeMeshTest, Constructor)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = EdgeMeshTest<TypeParam>::absolute_tolerance();
+
+    const auto mesh = plucker_helper::make_octahedron<TypeParam>();
+
+    EXPECT_EQ(6u, mesh.vertex_count());
+    EXPECT_EQ(8u, mesh.triangle_count());
+    EXPECT_EQ(12u, mesh.edge_count());
+
+    for(std::size_t t = 0; t < mesh.triangle_count(); t++)
+    {
+        const auto row = static_cast<Eigen::Index>(t);
+        const Vector3 p1 = mesh.vertex(mesh.triangles()(row, 0));
+        const Vector3 p2 = mesh.vertex(mesh.triangles()(row, 1));
+        const Vector3 p3 = mesh.vertex(mesh.triangles()(row, 2));
+
+        // Faces are outward.
+        EXPECT_LT(TypeParam(0), (p2 - p1).cross(p3 - p1).dot(p1 + p2 + p3));
+
+        EXPECT_MAT_ALMOST_EQUAL(Plucker(p1.homogeneous().eval(), p2.homogeneous().eval()).coord(), mesh.triangle_edge(t, 0).coord(), atol);
+        EXPECT_MAT_ALMOST_EQUAL(Plucker(p2.homogeneous().eval(), p3.homogeneous().eval()).coord(), mesh.triangle_edge(t, 1).coord(), atol);
+        EXPECT_MAT_ALMOST_EQUAL(Plucker(p3.homogeneous().eval(), p1.homogeneous().eval()).coord(), mesh.triangle_edge(t, 2).coord(), atol);
+    }
+}
+
+TYPED_TEST(EdgeMeshTest, has_intersection)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    const auto mesh = plucker_helper::make_octahedron<TypeParam>();
+
+    std::vector<std::size_t> hits;
+    plucker::VectorX<TypeParam> products;
+
+    // Rays straight down, including the ones through edges and vertices.
+    for(auto i = -8; i <= 8; i++)
+    {
+        for(auto j = -8; j <= 8; j++)
+        {
+            const auto x = TypeParam(i) / TypeParam(8);
+            const auto y = TypeParam(j) / TypeParam(8);
+            const auto ray = Plucker(Vector3(x, y, TypeParam(5)).homogeneous().eval(), Vector3(x, y, TypeParam(4)).homogeneous().eval());
+
+            mesh.find_intersections(ray, hits, products);
+            if(std::abs(i) + std::abs(j) < 8)
+            {
+                EXPECT_LE(1u, hits.size()) << "x: " << x << ", y: " << y;
+            }
+            else if(std::abs(i) + std::abs(j) > 8)
+            {
+                EXPECT_EQ(0u, hits.size()) << "x: " << x << ", y: " << y;
+            }
+
+            for(std::size_t t = 0; t < mesh.triangle_count(); t++)
+            {
+                const auto hit = std::find(hits.begin(), hits.end(), t) != hits.end();
+                EXPECT_EQ(hit, mesh.has_intersection(ray, t));
+                EXPECT_EQ(hit, mesh.has_intersection(plucker::PluckerView<const TypeParam>(ray), t));
+            }
+        }
+    }
+}
+
+}   // namespace
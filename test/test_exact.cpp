@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/exact.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+using Vector3 = plucker::Vector3<std::int64_t>;
+using Plucker = plucker::Plucker<std::int64_t>;
+
+template<typename T, typename = void>
+struct has_product
+    : std::false_type
+{};
+
+template<typename T>
+struct has_product<T, decltype(void(std::declval<const T&>() * std::declval<const T&>()))>
+    : std::true_type
+{};
+
+class ExactTest
+    : public ::testing::Test
+{
+protected:
+    static Vector3 random_point(std::mt19937_64& engine, std::int64_t limit)
+    {
+        std::uniform_int_distribution<std::int64_t> dist(-limit, limit);
+        return Vector3(dist(engine), dist(engine), dist(engine));
+    }
+
+    // A grid of n x n squares on z = 0, two counterclockwise triangles each.
+    static plucker::EdgeMesh<std::int64_t> make_grid(std::int64_t n, std::int64_t size)
+    {
+        using Triangles = typename plucker::EdgeMesh<std::int64_t>::Triangles;
+
+        plucker::Vector3Batch<std::int64_t> vertices((n + 1) * (n + 1), 3);
+        for(std::int64_t y = 0; y <= n; y++)
+        {
+            for(std::int64_t x = 0; x <= n; x++)
+                vertices.row(y * (n + 1) + x) << x * size, y * size, 0;
+        }
+
+        Triangles triangles(2 * n * n, 3);
+        for(std::int64_t y = 0; y < n; y++)
+        {
+            for(std::int64_t x = 0; x < n; x++)
+            {
+                const auto v = static_cast<std::uint32_t>(y * (n + 1) + x);
+                const auto w = static_cast<std::uint32_t>(n + 1);
+                triangles.row(2 * (y * n + x)) << v, v + 1, v + w + 1;
+                triangles.row(2 * (y * n + x) + 1) << v, v + w + 1, v + w;
+            }
+        }
+        return plucker::EdgeMesh<std::int64_t>(vertices, triangles);
+    }
+};
+
+TEST_F(ExactTest, product)
+{
+    std::mt19937_64 engine(42);
+
+    // Small coordinates, for which double is exact too.
+    for(auto n = 0; n < 1000; n++)
+    {
+        const Plucker p1 = plucker_helper::make_line<std::int64_t>(ExactTest::random_point(engine, 100), ExactTest::random_point(engine, 100));
+        const Plucker p2 = plucker_helper::make_line<std::int64_t>(ExactTest::random_point(engine, 100), ExactTest::random_point(engine, 100));
+        const plucker::Plucker<double> q1(p1.coord().cast<double>().eval());
+        const plucker::Plucker<double> q2(p2.coord().cast<double>().eval());
+        const auto expected = q1 * q2;
+        EXPECT_EQ((expected > 0) - (expected < 0), plucker::sign_of_product(p1, p2));
+    }
+
+    // Coplanar lines through points at the limit.
+    const auto limit = plucker::detail::exact_coordinate_limit;
+    for(auto n = 0; n < 1000; n++)
+    {
+        const Vector3 a = ExactTest::random_point(engine, limit / 4);
+        const Vector3 u = ExactTest::random_point(engine, limit / 8);
+        const Vector3 v = ExactTest::random_point(engine, limit / 8);
+        const Plucker p1 = plucker_helper::make_line<std::int64_t>(a, a + u);
+        const Plucker p2 = plucker_helper::make_line<std::int64_t>(a + v, a + u + 2 * v);
+        EXPECT_TRUE(plucker::are_coplanar(p1, p2));
+        EXPECT_EQ(0, plucker::sign_of_product(p1, p2));
+
+        // One step off the plane.
+        const Vector3 w = u.cross(v).cwiseSign();
+        const Plucker p3 = plucker_helper::make_line<std::int64_t>(a + v + w, a + u + 2 * v);
+        if(w.squaredNorm() > 0)
+        {
+            EXPECT_FALSE(plucker::are_coplanar(p1, p3));
+        }
+    }
+}
+
+TEST_F(ExactTest, product_without_overflow)
+{
+    // Lines of std::int64_t coordinates are multiplied only by the exact functions.
+    EXPECT_FALSE(has_product<Plucker>::value);
+    EXPECT_FALSE(has_product<plucker::PluckerView<const std::int64_t>>::value);
+    EXPECT_TRUE(has_product<plucker::Plucker<double>>::value);
+
+    // The product is 8 L^3, beyond 64 bits.
+    const std::int64_t L = plucker::detail::exact_coordinate_limit - 1;
+    const Plucker p1 = plucker_helper::make_line<std::int64_t>(Vector3(-L, -L, -L), Vector3(L, L, L));
+    const Plucker p2 = plucker_helper::make_line<std::int64_t>(Vector3(L, -L, L), Vector3(L, L, -L));
+    EXPECT_TRUE(plucker::exact_product(p1, p2) == 8 * plucker::detail::exact_int(L) * L * L);
+    EXPECT_EQ(1, plucker::sign_of_product(p1, p2));
+    EXPECT_EQ(-1, plucker::sign_of_product(p2, -p1));
+    EXPECT_FALSE(plucker::are_coplanar(p1, p2));
+    EXPECT_FALSE(plucker::has_intersection(p1, p2));
+}
+
+TEST_F(ExactTest, predicates)
+{
+    const auto limit = plucker::detail::exact_coordinate_limit;
+
+    const Vector3 a(limit, -limit, 3);
+    const Vector3 b(-limit, limit - 1, 5);
+    const Vector3 c(7, limit, -limit);
+
+    const Plucker p1 = plucker_helper::make_line<std::int64_t>(a, b);
+    const Plucker p2 = plucker_helper::make_line<std::int64_t>(b, c);
+    const Plucker p3 = plucker_helper::make_line<std::int64_t>(c, (c + 2 * (b - a)).eval());
+    EXPECT_TRUE(plucker::has_intersection(p1, p2));
+    EXPECT_FALSE(plucker::are_parallel(p1, p2));
+    EXPECT_TRUE(plucker::are_parallel(p1, p3));
+    EXPECT_TRUE(plucker::are_coplanar(p1, p3));
+    EXPECT_FALSE(plucker::has_intersection(p1, p3));
+
+    const plucker::Plane<std::int64_t> plane(0, 0, 1, -4);
+    EXPECT_EQ(-1, plucker::orientation(plane, a));
+    EXPECT_EQ(1, plucker::orientation(plane, b));
+    EXPECT_EQ(0, plucker::orientation(plane, Vector3(limit, limit, 4)));
+}
+
+TEST_F(ExactTest, is_within_exact_range)
+{
+    const auto limit = plucker::detail::exact_coordinate_limit;
+
+    // Lines through points at the limit.
+    EXPECT_TRUE(plucker::detail::is_within_exact_range(plucker_helper::make_line<std::int64_t>(Vector3(-limit, -limit, -limit), Vector3(limit, limit, limit))));
+    EXPECT_TRUE(plucker::detail::is_within_exact_range(plucker_helper::make_line<std::int64_t>(Vector3(limit, -limit, limit), Vector3(-limit, limit, -limit))));
+
+    // Beyond the limit, the direction or the moment leaves the range.
+    EXPECT_FALSE(plucker::detail::is_within_exact_range(plucker_helper::make_line<std::int64_t>(Vector3(-limit, 0, 0), Vector3(limit + 1, 0, 0))));
+    EXPECT_FALSE(plucker::detail::is_within_exact_range(Plucker(Vector3(1, 0, 0), Vector3(0, 0, 2 * limit * limit + 1))));
+}
+
+TEST_F(ExactTest, view)
+{
+    const auto limit = plucker::detail::exact_coordinate_limit;
+
+    // Two lines, (l:m) each, in an external buffer.
+    const Plucker q1 = plucker_helper::make_line<std::int64_t>(Vector3(-limit, 3, limit), Vector3(limit, -5, 7));
+    const Plucker q2 = plucker_helper::make_line<std::int64_t>(Vector3(2, limit, -limit), Vector3(-limit, 11, limit));
+    std::int64_t buffer[12];
+    plucker::Vector6<std::int64_t>::Map(buffer) = q1.coord();
+    plucker::Vector6<std::int64_t>::Map(buffer + 6) = q2.coord();
+
+    const plucker::PluckerView<const std::int64_t> p1(buffer);
+    const plucker::PluckerView<const std::int64_t> p2(buffer + 6);
+    EXPECT_TRUE(plucker::exact_product(q1, q2) == plucker::exact_product(p1, p2));
+    EXPECT_EQ(plucker::sign_of_product(q1, q2), plucker::sign_of_product(p1, q2));
+    EXPECT_EQ(plucker::are_coplanar(q1, q2), plucker::are_coplanar(p1, p2));
+    EXPECT_EQ(plucker::are_parallel(q1, q2), plucker::are_parallel(p1, p2));
+    EXPECT_EQ(plucker::has_intersection(q1, q2), plucker::has_intersection(p1, p2));
+
+    const std::int64_t coords[4] = {0, 0, 1, -4};
+    const plucker::PlaneView<const std::int64_t> plane(coords);
+    EXPECT_EQ(1, plucker::orientation(plane, Vector3(limit, -limit, 5)));
+
+    // Through a triangle, and a mesh of it.
+    const Vector3 v0(0, 0, 0);
+    const Vector3 v1(10, 0, 0);
+    const Vector3 v2(0, 10, 0);
+    const Plucker ray = plucker_helper::make_line<std::int64_t>(Vector3(2, 2, 5), Vector3(2, 2, -5));
+    const plucker::PluckerView<const std::int64_t> view(ray);
+    EXPECT_TRUE(plucker::has_intersection(view, v0, v1, v2));
+
+    plucker::Vector3Batch<std::int64_t> vertices(3, 3);
+    vertices << v0.transpose(), v1.transpose(), v2.transpose();
+    typename plucker::EdgeMesh<std::int64_t>::Triangles triangles(1, 3);
+    triangles << 0, 1, 2;
+    const plucker::EdgeMesh<std::int64_t> mesh(vertices, triangles);
+
+    std::vector<std::size_t> hits;
+    std::vector<std::int8_t> signs;
+    plucker::find_intersections(mesh, view, hits, signs);
+    EXPECT_EQ(std::vector<std::size_t>(1, 0), hits);
+}
+
+TEST_F(ExactTest, has_intersection_with_triangle)
+{
+    const Vector3 p0(0, 0, 0);
+    const Vector3 p1(10, 0, 0);
+    const Vector3 p2(0, 10, 0);
+
+    // Downward rays, through the inside, a vertex, an edge and the outside.
+    EXPECT_TRUE(plucker::has_intersection(plucker_helper::make_line<std::int64_t>(Vector3(2, 2, 5), Vector3(2, 2, -5)), p0, p1, p2));
+    EXPECT_TRUE(plucker::has_intersection(plucker_helper::make_line<std::int64_t>(Vector3(0, 0, 5), Vector3(0, 0, -5)), p0, p1, p2));
+    EXPECT_TRUE(plucker::has_intersection(plucker_helper::make_line<std::int64_t>(Vector3(5, 5, 5), Vector3(5, 5, -5)), p0, p1, p2));
+    EXPECT_FALSE(plucker::has_intersection(plucker_helper::make_line<std::int64_t>(Vector3(6, 5, 5), Vector3(6, 5, -5)), p0, p1, p2));
+
+    // From behind, and within the plane.
+    EXPECT_FALSE(plucker::has_intersection(plucker_helper::make_line<std::int64_t>(Vector3(2, 2, -5), Vector3(2, 2, 5)), p0, p1, p2));
+    EXPECT_FALSE(plucker::has_intersection(plucker_helper::make_line<std::int64_t>(Vector3(-1, 2, 0), Vector3(5, 2, 0)), p0, p1, p2));
+}
+
+TEST_F(ExactTest, find_intersections)
+{
+    const auto mesh = ExactTest::make_grid(8, 1000);
+
+    std::vector<std::size_t> hits;
+    std::vector<std::int8_t> signs;
+
+    // Through a vertex shared by six triangles, all of them are hit.
+    plucker::find_intersections(mesh, plucker_helper::make_line<std::int64_t>(Vector3(3000, 4000, 10), Vector3(3000, 4000, -10)), hits, signs);
+    EXPECT_EQ(6u, hits.size());
+
+    // Through an edge shared by two triangles.
+    plucker::find_intersections(mesh, plucker_helper::make_line<std::int64_t>(Vector3(3500, 4000, 10), Vector3(3500, 4000, -10)), hits, signs);
+    EXPECT_EQ(2u, hits.size());
+
+    // Slanted rays on the grid points are hit by some triangle, and agree with the triangle test.
+    std::mt19937_64 engine(7);
+    std::uniform_int_distribution<std::int64_t> dist(1, 7999);
+    for(auto n = 0; n < 200; n++)
+    {
+        const Vector3 target(dist(engine), dist(engine), 0);
+        const Vector3 from = target + Vector3(dist(engine) % 5 - 2, dist(engine) % 5 - 2, 7);
+        const Plucker ray = plucker_helper::make_line<std::int64_t>(from, (2 * target - from).eval());
+        plucker::find_intersections(mesh, ray, hits, signs);
+        EXPECT_LE(1u, hits.size());
+
+        for(std::size_t t = 0; t < mesh.triangle_count(); t++)
+        {
+            const auto row = static_cast<Eigen::Index>(t);
+            const auto expected = plucker::has_intersection(ray,
+                mesh.vertex(mesh.triangles()(row, 0)), mesh.vertex(mesh.triangles()(row, 1)), mesh.vertex(mesh.triangles()(row, 2)));
+            EXPECT_EQ(expected, std::find(hits.begin(), hits.end(), t) != hits.end());
+        }
+    }
+
+    // An empty mesh has no hits.
+    const plucker::EdgeMesh<std::int64_t> empty(plucker::Vector3Batch<std::int64_t>(0, 3),
+        typename plucker::EdgeMesh<std::int64_t>::Triangles(0, 3));
+    plucker::find_intersections(empty, plucker_helper::make_line<std::int64_t>(Vector3(0, 0, 10), Vector3(0, 0, -10)), hits, signs);
+    EXPECT_TRUE(hits.empty());
+}
+
+}   // namespace
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/plucker_query.h>
+#include <plucker/plucker_geometric.h>
+#include <plucker/half.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+class HalfTest
+    : public ::testing::Test
+{
+protected:
+    static constexpr float absolute_tolerance(){ return 1e-4f; }
+    static constexpr float relative_tolerance(){ return 1e-5f; }
+
+    // Random lines, with every tenth parallel to the first.
+    static plucker::PluckerBatch<float> make_lines(Eigen::Index count)
+    {
+        plucker::PluckerBatch<float> lines(count, 6);
+        for(Eigen::Index i = 0; i < count; i++)
+        {
+            const plucker::Vector3<float> p = 4.0f * plucker::Vector3<float>::Random();
+            const plucker::Vector3<float> l = (i % 10 == 0) ? plucker::Vector3<float>::UnitX().eval() : plucker::Vector3<float>::Random().eval();
+            lines.row(i) << l.transpose(), p.cross(l).transpose();
+        }
+        return lines;
+    }
+};
+
+TEST_F(HalfTest, conversion)
+{
+    using plucker::detail::float_to_half;
+    using plucker::detail::half_to_float;
+
+    EXPECT_EQ(0x0000u, float_to_half(0.0f));
+    EXPECT_EQ(0x8000u, float_to_half(-0.0f));
+    EXPECT_EQ(0x3c00u, float_to_half(1.0f));
+    EXPECT_EQ(0xc000u, float_to_half(-2.0f));
+    EXPECT_EQ(0x2e66u, float_to_half(0.1f));
+    EXPECT_EQ(0x7bffu, float_to_half(65504.0f));
+    EXPECT_EQ(0x7c00u, float_to_half(1e5f));
+    EXPECT_EQ(0xfc00u, float_to_half(-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ(0x0001u, float_to_half(std::ldexp(1.0f, -24)));
+    EXPECT_EQ(0x0000u, float_to_half(std::ldexp(1.0f, -26)));
+    EXPECT_TRUE(std::isnan(half_to_float(float_to_half(std::numeric_limits<float>::quiet_NaN()))));
+
+    // Ties go to even.
+    EXPECT_EQ(0x3c00u, float_to_half(1.0f + std::ldexp(1.0f, -11)));
+    EXPECT_EQ(0x3c02u, float_to_half(1.0f + 3.0f * std::ldexp(1.0f, -11)));
+
+    // Every half survives a round trip, one at a time and in bulk.
+    std::vector<std::uint16_t> halves;
+    for(std::uint32_t h = 0; h < 0x10000u; h++)
+    {
+        const auto value = static_cast<std::uint16_t>(h);
+        if(std::isnan(half_to_float(value)))
+            continue;
+        EXPECT_EQ(value, float_to_half(half_to_float(value)));
+        halves.push_back(value);
+    }
+
+    std::vector<float> floats(halves.size());
+    std::vector<std::uint16_t> back(halves.size());
+    plucker::detail::half_to_float(halves.data(), floats.data(), halves.size());
+    plucker::detail::float_to_half(floats.data(), back.data(), floats.size());
+    for(std::size_t i = 0; i < halves.size(); i++)
+    {
+        EXPECT_EQ(half_to_float(halves[i]), floats[i]);
+        EXPECT_EQ(halves[i], back[i]);
+    }
+
+    // Rounding in bulk matches one at a time.
+    const plucker::VectorX<float> values = 100.0f * plucker::VectorX<float>::Random(1003);
+    std::vector<std::uint16_t> rounded(static_cast<std::size_t>(values.rows()));
+    plucker::detail::float_to_half(values.data(), rounded.data(), rounded.size());
+    for(std::size_t i = 0; i < rounded.size(); i++)
+        EXPECT_EQ(float_to_half(values(static_cast<Eigen::Index>(i))), rounded[i]);
+}
+
+TEST_F(HalfTest, store_and_load)
+{
+    const auto lines = HalfTest::make_lines(301);
+
+    plucker::PluckerHalfBatch halves;
+    plucker::store(lines, halves);
+    ASSERT_EQ(lines.rows(), halves.rows());
+
+    plucker::PluckerBatch<float> loaded;
+    plucker::load(halves, loaded);
+    ASSERT_EQ(lines.rows(), loaded.rows());
+
+    // Half precision keeps 11 significant bits.
+    for(Eigen::Index i = 0; i < lines.rows(); i++)
+    {
+        for(Eigen::Index j = 0; j < 6; j++)
+        {
+            EXPECT_NEAR(lines(i, j), loaded(i, j), std::ldexp(std::abs(lines(i, j)), -11) + 1e-7f);
+        }
+    }
+
+    const plucker::Plucker<float> line(plucker::Vector6<float>(lines.row(7).transpose()));
+    plucker::store(line, halves, 0);
+    EXPECT_MAT_ALMOST_EQUAL(plucker::Vector6<float>(loaded.row(7).transpose()), plucker::load(halves, 0).coord(), 0.0f);
+}
+
+TEST_F(HalfTest, kernels)
+{
+    constexpr auto atol = HalfTest::absolute_tolerance();
+
+    const auto lines = HalfTest::make_lines(601);
+    plucker::PluckerHalfBatch halves;
+    plucker::store(lines, halves);
+    plucker::PluckerBatch<float> loaded;
+    plucker::load(halves, loaded);
+
+    // A line crossing the tenth line.
+    const plucker::Plucker<float> other(plucker::Vector6<float>(loaded.row(0).transpose()));
+    const plucker::Vector3<float> crossing_l = plucker::Vector3<float>::UnitY();
+    const plucker::Vector3<float> on_tenth = plucker::Vector3<float>(loaded.row(10).head<3>().transpose()).cross(plucker::Vector3<float>(loaded.row(10).tail<3>().transpose()))
+        / loaded.row(10).head<3>().squaredNorm();
+    const plucker::Plucker<float> line(crossing_l, on_tenth.cross(crossing_l));
+
+    plucker::VectorX<float> products(lines.rows());
+    plucker::VectorX<float> distances(lines.rows());
+    plucker::product(line, halves, products);
+    plucker::distance(line, halves, atol, distances);
+
+    std::vector<std::uint8_t> coplanar;
+    std::vector<std::uint8_t> parallel;
+    std::vector<std::uint8_t> intersecting;
+    plucker::are_coplanar(line, halves, 1e-3f, coplanar);
+    plucker::are_parallel(other, halves, 1e-3f, parallel);
+    plucker::has_intersection(line, halves, 1e-3f, intersecting);
+
+    // The same as float on the stored values.
+    for(Eigen::Index i = 0; i < lines.rows(); i++)
+    {
+        const auto k = static_cast<std::size_t>(i);
+        const plucker::Plucker<float> p(plucker::Vector6<float>(loaded.row(i).transpose()));
+        EXPECT_ALMOST_EQUAL(line * p, products(i), atol);
+        EXPECT_ALMOST_EQUAL(plucker::distance(line, p, atol), distances(i), 10.0f * atol);
+        EXPECT_EQ(plucker::are_coplanar(line, p, 1e-3f) ? 1 : 0, coplanar[k]);
+        EXPECT_EQ(plucker::are_parallel(other, p, 1e-3f) ? 1 : 0, parallel[k]);
+        EXPECT_EQ(plucker::has_intersection(line, p, 1e-3f) ? 1 : 0, intersecting[k]);
+    }
+    EXPECT_EQ(1, intersecting[10]);
+    EXPECT_EQ(1, parallel[20]);
+}
+
+TEST_F(HalfTest, view)
+{
+    constexpr auto atol = HalfTest::absolute_tolerance();
+
+    const auto lines = HalfTest::make_lines(101);
+    plucker::PluckerHalfBatch halves;
+    plucker::store(lines, halves);
+
+    // A line in an external buffer.
+    const float buffer[6] = {0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 2.0f};
+    const plucker::PluckerView<const float> view(buffer);
+    const plucker::Plucker<float> line(plucker::Vector6<float>(view.coord()));
+
+    plucker::VectorX<float> expected(lines.rows());
+    plucker::VectorX<float> viewed(lines.rows());
+    plucker::product(line, halves, expected);
+    plucker::product(view, halves, viewed);
+    EXPECT_TRUE(expected == viewed);
+
+    plucker::distance(line, halves, atol, expected);
+    plucker::distance(view, halves, atol, viewed);
+    EXPECT_TRUE(expected == viewed);
+
+    std::vector<std::uint8_t> expected_flags;
+    std::vector<std::uint8_t> viewed_flags;
+    plucker::are_coplanar(line, halves, 1e-3f, expected_flags);
+    plucker::are_coplanar(view, halves, 1e-3f, viewed_flags);
+    EXPECT_EQ(expected_flags, viewed_flags);
+    plucker::are_parallel(line, halves, 1e-3f, expected_flags);
+    plucker::are_parallel(view, halves, 1e-3f, viewed_flags);
+    EXPECT_EQ(expected_flags, viewed_flags);
+    plucker::has_intersection(line, halves, 1e-3f, expected_flags);
+    plucker::has_intersection(view, halves, 1e-3f, viewed_flags);
+    EXPECT_EQ(expected_flags, viewed_flags);
+
+    plucker::store(view, halves, 0);
+    EXPECT_MAT_ALMOST_EQUAL(line.coord(), plucker::load(halves, 0).coord(), 0.0f);
+}
+
+}   // namespace
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/homogeneous.h>
+#include <plucker/plucker_common.h>
+#include <plucker/plucker_find.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class HomogeneousTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    static plucker::PluckerBatch<T> make_lines(Eigen::Index count)
+    {
+        plucker::PluckerBatch<T> lines(count, 6);
+        for(Eigen::Index k = 0; k < count; k++)
+        {
+            const plucker::Vector3<T> from = plucker::Vector3<T>::Random();
+            const plucker::Vector3<T> to = plucker::Vector3<T>::Random();
+            lines.row(k) = plucker::Plucker<T>(from.homogeneous().eval(), to.homogeneous().eval()).coord().transpose();
+        }
+        return lines;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(HomogeneousTest, MyTypes);
+
+TYPED_TEST(HomogeneousTest, dehomogenize)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = HomogeneousTest<TypeParam>::absolute_tolerance();
+    const auto inf = std::numeric_limits<TypeParam>::infinity();
+
+    plucker::Vector4Batch<TypeParam> points(4, 4);
+    points <<
+        TypeParam(2), TypeParam(4), TypeParam(-6), TypeParam(2),
+        TypeParam(1), TypeParam(0), TypeParam(0),  TypeParam(0),
+        TypeParam(3), inf,          TypeParam(1),  TypeParam(1),
+        TypeParam(0), TypeParam(3), TypeParam(4),  TypeParam(-0.5);
+
+    plucker::Vector3Batch<TypeParam> res;
+    plucker::dehomogenize(points, atol, res);
+    ASSERT_EQ(4, res.rows());
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(2), TypeParam(-3)), Vector3(res.row(0).transpose()), atol);
+    EXPECT_TRUE(res.row(1).array().isNaN().all());
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(0), TypeParam(-6), TypeParam(-8)), Vector3(res.row(3).transpose()), atol);
+
+    std::vector<std::uint8_t> flags;
+    plucker::is_at_infinity(points, atol, flags);
+    EXPECT_EQ((std::vector<std::uint8_t>{0, 1, 0, 0}), flags);
+    plucker::is_finite(points, atol, flags);
+    EXPECT_EQ((std::vector<std::uint8_t>{1, 0, 0, 1}), flags);
+
+    // Back to w = 1.
+    plucker::Vector4Batch<TypeParam> homogeneous;
+    plucker::homogenize(res, homogeneous);
+    EXPECT_MAT_ALMOST_EQUAL(plucker::Vector4<TypeParam>(TypeParam(1), TypeParam(2), TypeParam(-3), TypeParam(1)),
+        plucker::Vector4<TypeParam>(homogeneous.row(0).transpose()), atol);
+
+    // Points to w = 1, and directions to unit length.
+    plucker::Vector4Batch<TypeParam> normalized = points.topRows(2);
+    normalized(1, 0) = TypeParam(-3);
+    plucker::normalize(normalized, atol);
+    EXPECT_MAT_ALMOST_EQUAL(plucker::Vector4<TypeParam>(TypeParam(1), TypeParam(2), TypeParam(-3), TypeParam(1)),
+        plucker::Vector4<TypeParam>(normalized.row(0).transpose()), atol);
+    EXPECT_MAT_ALMOST_EQUAL(plucker::Vector4<TypeParam>(TypeParam(-1), TypeParam(0), TypeParam(0), TypeParam(0)),
+        plucker::Vector4<TypeParam>(normalized.row(1).transpose()), atol);
+}
+
+TYPED_TEST(HomogeneousTest, points_of_lines)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = HomogeneousTest<TypeParam>::absolute_tolerance();
+
+    const Eigen::Index count = 40;
+    plucker::PluckerBatch<TypeParam> lines = HomogeneousTest<TypeParam>::make_lines(count);
+    // A line parallel to the plane below.
+    lines.row(0) << TypeParam(1), TypeParam(-1), TypeParam(0), TypeParam(0), TypeParam(0), TypeParam(1);
+
+    const plucker::VectorX<TypeParam> t = plucker::VectorX<TypeParam>::Random(count);
+    const plucker::Plane<TypeParam> plane(TypeParam(0), TypeParam(0), TypeParam(1), TypeParam(-0.5));
+
+    plucker::Vector4Batch<TypeParam> closest;
+    plucker::Vector4Batch<TypeParam> on_lines;
+    plucker::Vector4Batch<TypeParam> intersections;
+    plucker::closest_points(lines, closest);
+    plucker::points_on_lines(lines, t, on_lines);
+    plucker::find_intersections(lines, plane, intersections);
+
+    plucker::Vector3Batch<TypeParam> points;
+    plucker::dehomogenize(intersections, atol, points);
+
+    std::vector<std::uint8_t> at_infinity;
+    plucker::is_at_infinity(intersections, atol, at_infinity);
+
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        const Plucker line(plucker::Vector6<TypeParam>(lines.row(k).transpose()));
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(plucker::closest_point(line).hnormalized()), Vector3(closest.row(k).hnormalized().transpose()), atol);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(plucker::point_on_line(line, t(k)).hnormalized()), Vector3(on_lines.row(k).hnormalized().transpose()), atol);
+
+        const auto res = plucker::find_intersection(line, plane, atol);
+        EXPECT_EQ(std::get<0>(res), at_infinity[static_cast<std::size_t>(k)] == 0);
+        if(std::get<0>(res))
+        {
+            const Vector3 expected = std::get<1>(res).hnormalized();
+            EXPECT_MAT_ALMOST_EQUAL(expected, Vector3(points.row(k).transpose()), (TypeParam(1) + expected.norm()) * atol);
+        }
+    }
+    EXPECT_EQ(1, at_infinity[0]);
+
+    // The same through a view of the plane.
+    plucker::Vector4Batch<TypeParam> from_view;
+    plucker::find_intersections(lines, plucker::PlaneView<const TypeParam>(plane), from_view);
+    EXPECT_TRUE(intersections.isApprox(from_view));
+}
+
+}   // namespace
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <plucker/plucker_base.h>
+#include <plucker/plucker_query.h>
+#include <plucker/line_fitter.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class LineFitterTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(LineFitterTest, MyTypes);
+
+TYPED_TEST(LineFitterTest, fit)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using LineFitter = plucker::LineFitter<TypeParam>;
+
+    constexpr auto atol = LineFitterTest<TypeParam>::absolute_tolerance();
+
+    const auto from = Vector3(TypeParam(1), TypeParam(2), TypeParam(3));
+    const auto to = Vector3(TypeParam(3), TypeParam(-2), TypeParam(5));
+    const Plucker expected(from.homogeneous().eval(), to.homogeneous().eval());
+
+    // Too few points.
+    {
+        LineFitter fitter;
+        EXPECT_FALSE(std::get<0>(fitter.fit()));
+
+        fitter.add(from);
+        EXPECT_FALSE(std::get<0>(fitter.fit()));
+    }
+    // Points on a line.
+    {
+        LineFitter fitter;
+        for(auto i = 0; i <= 10; i++)
+            fitter.add(Vector3(from + TypeParam(i) / TypeParam(10) * (to - from)));
+
+        EXPECT_EQ(11u, fitter.count());
+
+        const auto res = fitter.fit();
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(1), std::get<1>(res).l().norm(), atol);
+        EXPECT_TRUE(plucker::are_parallel(expected, std::get<1>(res), atol));
+        EXPECT_TRUE(plucker::contains(std::get<1>(res), from.homogeneous().eval(), TypeParam(10) * atol));
+        EXPECT_ALMOST_EQUAL(TypeParam(0), fitter.residual(), TypeParam(10) * atol);
+    }
+}
+
+TYPED_TEST(LineFitterTest, residual)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using LineFitter = plucker::LineFitter<TypeParam>;
+
+    constexpr auto atol = LineFitterTest<TypeParam>::absolute_tolerance();
+
+    // Points at a distance of 1 from the z-axis.
+    LineFitter fitter;
+    fitter.add(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)));
+    fitter.add(Vector3(TypeParam(-1), TypeParam(0), TypeParam(0)));
+    fitter.add(Vector3(TypeParam(0), TypeParam(1), TypeParam(10)));
+    fitter.add(Vector3(TypeParam(0), TypeParam(-1), TypeParam(10)));
+
+    const auto res = fitter.fit();
+    EXPECT_TRUE(std::get<0>(res));
+    EXPECT_ALMOST_EQUAL(TypeParam(1), std::abs(std::get<1>(res).l().z()), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(4), fitter.residual(), atol);
+}
+
+TYPED_TEST(LineFitterTest, add_batch_and_merge)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using LineFitter = plucker::LineFitter<TypeParam>;
+    using Points = Eigen::Matrix<TypeParam, Eigen::Dynamic, 3>;
+
+    constexpr auto atol = LineFitterTest<TypeParam>::absolute_tolerance();
+
+    const Points points = Points::Random(64, 3);
+
+    LineFitter expected;
+    for(auto i = 0; i < points.rows(); i++)
+        expected.add(Vector3(points.row(i).transpose()));
+
+    // Batch insertion.
+    {
+        LineFitter fitter;
+        fitter.add(points);
+        EXPECT_EQ(expected.count(), fitter.count());
+        EXPECT_MAT_ALMOST_EQUAL(expected.centroid(), fitter.centroid(), atol);
+        EXPECT_MAT_ALMOST_EQUAL(expected.scatter(), fitter.scatter(), atol);
+    }
+    // Points given by column expressions.
+    {
+        LineFitter fitter;
+        for(auto i = 0; i < points.rows(); i++)
+            fitter.add(points.row(i).transpose());
+        EXPECT_EQ(expected.count(), fitter.count());
+        EXPECT_MAT_ALMOST_EQUAL(expected.centroid(), fitter.centroid(), atol);
+        EXPECT_MAT_ALMOST_EQUAL(expected.scatter(), fitter.scatter(), atol);
+
+        const Vector3 p = Vector3::UnitX();
+        const Vector3 q = Vector3::UnitY();
+        fitter.add(p + q);
+        EXPECT_EQ(expected.count() + 1, fitter.count());
+    }
+    // Merging partial fits.
+    {
+        LineFitter fitter1;
+        LineFitter fitter2;
+        fitter1.add(points.topRows(20));
+        fitter2.add(points.bottomRows(44));
+
+        LineFitter empty;
+        fitter1 += empty;
+        EXPECT_EQ(20u, fitter1.count());
+
+        fitter1 += fitter2;
+        EXPECT_EQ(expected.count(), fitter1.count());
+        EXPECT_MAT_ALMOST_EQUAL(expected.centroid(), fitter1.centroid(), atol);
+        EXPECT_MAT_ALMOST_EQUAL(expected.scatter(), fitter1.scatter(), atol);
+        EXPECT_ALMOST_EQUAL(expected.residual(), fitter1.residual(), atol);
+
+        fitter1.clear();
+        EXPECT_EQ(0u, fitter1.count());
+    }
+}
+
+}   // namespace
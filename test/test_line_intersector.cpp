@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/line_intersector.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class LineIntersectorTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(LineIntersectorTest, MyTypes);
+
+TYPED_TEST(LineIntersectorTest, find_point)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using LineIntersector = plucker::LineIntersector<TypeParam>;
+
+    constexpr auto atol = LineIntersectorTest<TypeParam>::absolute_tolerance();
+
+    const auto target = Vector3(TypeParam(1), TypeParam(2), TypeParam(3));
+
+    // Lines through a common point.
+    {
+        LineIntersector intersector;
+        EXPECT_FALSE(std::get<0>(intersector.find_point(atol)));
+
+        const Plucker first(target.homogeneous().eval(), Vector3(TypeParam(4), TypeParam(2), TypeParam(3)).homogeneous().eval());
+        intersector.add(plucker::PluckerView<const TypeParam>(first));
+        intersector.add(Plucker(Vector3(TypeParam(1), TypeParam(-2), TypeParam(3)).homogeneous().eval(), target.homogeneous().eval()));
+        intersector.add(Plucker(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)).homogeneous().eval(), TypeParam(2) * target.homogeneous()), TypeParam(3));
+
+        const auto res = intersector.find_point(atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_MAT_ALMOST_EQUAL(target, std::get<1>(res).hnormalized(), atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(5), intersector.weight(), atol);
+    }
+    // Two skew lines, the midpoint of the common perpendicular.
+    {
+        LineIntersector intersector;
+        intersector.add(Plucker(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(TypeParam(0), TypeParam(0), TypeParam(0))));
+        intersector.add(Plucker(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(2), TypeParam(0)).cross(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)))));
+
+        const auto res = intersector.find_point(atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(0), TypeParam(1), TypeParam(0)), std::get<1>(res).hnormalized(), atol);
+    }
+    // Parallel lines.
+    {
+        LineIntersector intersector;
+        intersector.add(Plucker(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(TypeParam(0), TypeParam(0), TypeParam(0))));
+        intersector.add(Plucker(Vector3(TypeParam(0), TypeParam(0), TypeParam(2)), Vector3(TypeParam(2), TypeParam(0), TypeParam(0))));
+
+        EXPECT_FALSE(std::get<0>(intersector.find_point(atol)));
+    }
+}
+
+TYPED_TEST(LineIntersectorTest, merge)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using LineIntersector = plucker::LineIntersector<TypeParam>;
+
+    constexpr auto atol = LineIntersectorTest<TypeParam>::absolute_tolerance();
+
+    const Plucker line1(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(TypeParam(0), TypeParam(0), TypeParam(0)));
+    const Plucker line2(Vector3(TypeParam(1), TypeParam(1), TypeParam(0)), Vector3(TypeParam(1), TypeParam(-1), TypeParam(0)));
+
+    LineIntersector expected;
+    expected.add(line1);
+    expected.add(line2);
+
+    LineIntersector res1;
+    LineIntersector res2;
+    res1.add(line1);
+    res2.add(line2);
+    res1.merge(res2);
+
+    EXPECT_MAT_ALMOST_EQUAL(expected.matrix(), res1.matrix(), atol);
+    EXPECT_MAT_ALMOST_EQUAL(expected.vector(), res1.vector(), atol);
+
+    res1.clear();
+    EXPECT_ALMOST_EQUAL(TypeParam(0), res1.weight(), atol);
+}
+
+TYPED_TEST(LineIntersectorTest, find_nearest_points)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Vector4 = plucker::Vector4<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = LineIntersectorTest<TypeParam>::absolute_tolerance();
+
+    std::vector<Plucker, Eigen::aligned_allocator<Plucker>> lines;
+    std::vector<std::size_t> offsets(1, 0);
+    std::vector<Vector3, Eigen::aligned_allocator<Vector3>> targets;
+
+    // Problems of 2 to 5 lines through random points.
+    for(auto k = 0; k < 20; k++)
+    {
+        const Vector3 target = TypeParam(5) * Vector3::Random();
+        const auto n = 2 + k % 4;
+        for(auto i = 0; i < n; i++)
+        {
+            const Vector3 from = TypeParam(5) * Vector3::Random();
+            lines.push_back(Plucker(from.homogeneous().eval(), target.homogeneous().eval()));
+        }
+        offsets.push_back(lines.size());
+        targets.push_back(target);
+    }
+    // A problem of parallel lines.
+    lines.push_back(Plucker(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(TypeParam(0), TypeParam(0), TypeParam(0))));
+    lines.push_back(Plucker(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(TypeParam(1), TypeParam(0), TypeParam(0))));
+    offsets.push_back(lines.size());
+
+    plucker::PluckerBatch<TypeParam> batch(lines.size(), 6);
+    for(std::size_t i = 0; i < lines.size(); i++)
+        batch.row(static_cast<Eigen::Index>(i)) = lines[i].coord().transpose();
+
+    plucker::Vector4Batch<TypeParam> points;
+    plucker::find_nearest_points(batch, offsets, atol, points);
+
+    ASSERT_EQ(21, points.rows());
+    for(std::size_t k = 0; k < targets.size(); k++)
+    {
+        const Vector4 point = points.row(static_cast<Eigen::Index>(k)).transpose();
+        EXPECT_MAT_ALMOST_EQUAL(targets[k], point.hnormalized(), TypeParam(10) * atol);
+
+        const auto res = plucker::find_nearest_point(lines.begin() + static_cast<std::ptrdiff_t>(offsets[k]), lines.begin() + static_cast<std::ptrdiff_t>(offsets[k + 1]), atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_MAT_ALMOST_EQUAL(point.hnormalized(), std::get<1>(res).hnormalized(), TypeParam(10) * atol);
+    }
+    EXPECT_ALMOST_EQUAL(TypeParam(0), points(20, 3), atol);
+}
+
+}   // namespace
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <plucker/plucker_base.h>
+#include <plucker/line_set.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class LineSetTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(LineSetTest, MyTypes);
+
+TYPED_TEST(LineSetTest, hash)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    const auto from = Vector3(TypeParam(1), TypeParam(2), TypeParam(6));
+    const auto to = Vector3(TypeParam(0), TypeParam(2), TypeParam(4));
+    const Plucker line(from.homogeneous().eval(), to.homogeneous().eval());
+
+    const auto key1 = plucker::quantize(canonicalize(line), TypeParam(0.01));
+    const auto key2 = plucker::quantize(canonicalize(TypeParam(2) * line), TypeParam(0.01));
+    const auto key3 = plucker::quantize(canonicalize(line), TypeParam(0.1));
+
+    const std::hash<plucker::LineKey> hasher;
+    EXPECT_TRUE(key1 == key2);
+    EXPECT_EQ(hasher(key1), hasher(key2));
+    EXPECT_TRUE(key1 != key3);
+
+    // The same through a view of the coordinates.
+    const Plucker canonical = canonicalize(line);
+    EXPECT_TRUE(key1 == plucker::quantize(plucker::PluckerView<const TypeParam>(canonical), TypeParam(0.01)));
+}
+
+TYPED_TEST(LineSetTest, insert)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using LineSet = plucker::LineSet<TypeParam>;
+
+    const auto tol = TypeParam(1e-3);
+
+    const auto from = Vector3(TypeParam(1), TypeParam(2), TypeParam(6));
+    const auto to = Vector3(TypeParam(0), TypeParam(2), TypeParam(4));
+    const Plucker line(from.homogeneous().eval(), to.homogeneous().eval());
+
+    LineSet set(tol);
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(std::get<0>(set.find(line)));
+
+    const auto res1 = set.insert(line);
+    EXPECT_TRUE(res1.second);
+    EXPECT_EQ(0u, res1.first);
+
+    // Same line with another scale or direction.
+    const auto res2 = set.insert(TypeParam(-2) * line);
+    EXPECT_FALSE(res2.second);
+    EXPECT_EQ(0u, res2.first);
+
+    // Same line within tolerance.
+    const Plucker perturbed(line.l(), (line.m() + Vector3::Constant(TypeParam(0.5) * tol)).eval());
+    EXPECT_FALSE(set.insert(perturbed).second);
+
+    // Another line.
+    const Plucker other(line.l(), (line.m() + Vector3::Constant(TypeParam(10) * tol)).eval());
+    const auto res3 = set.insert(other);
+    EXPECT_TRUE(res3.second);
+    EXPECT_EQ(1u, res3.first);
+
+    EXPECT_EQ(2u, set.size());
+    EXPECT_TRUE(std::get<0>(set.find(other)));
+    EXPECT_EQ(1u, std::get<1>(set.find(other)));
+
+    // Lines in external memory.
+    EXPECT_EQ(1u, std::get<1>(set.find(plucker::PluckerView<const TypeParam>(other))));
+    EXPECT_FALSE(set.insert(plucker::PluckerView<const TypeParam>(line)).second);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+}
+
+TYPED_TEST(LineSetTest, insert_near_cell_boundaries)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using LineSet = plucker::LineSet<TypeParam>;
+
+    const auto tol = TypeParam(1e-3);
+
+    // Moments straddling cell boundaries, i.e. multiples of 4 * tol.
+    LineSet set(tol);
+    for(auto i = 0; i < 100; i++)
+    {
+        const auto c = TypeParam(4) * tol * TypeParam(i);
+        const Plucker line(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(c - TypeParam(0.25) * tol, c, TypeParam(0)));
+        const Plucker same(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(c + TypeParam(0.25) * tol, c, TypeParam(0)));
+
+        EXPECT_TRUE(set.insert(line).second);
+        EXPECT_FALSE(set.insert(same).second);
+    }
+    EXPECT_EQ(100u, set.size());
+}
+
+TYPED_TEST(LineSetTest, insert_with_ambiguous_sign)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using LineSet = plucker::LineSet<TypeParam>;
+
+    const auto tol = TypeParam(1e-3);
+
+    // The largest component of the direction differs between the two lines.
+    const Plucker line1(Vector3(TypeParam(1), TypeParam(-1) - TypeParam(0.1) * tol, TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(1)));
+    const Plucker line2(Vector3(TypeParam(1), TypeParam(-1) + TypeParam(0.1) * tol, TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(1)));
+
+    LineSet set(tol);
+    EXPECT_TRUE(set.insert(line1).second);
+    EXPECT_FALSE(set.insert(line2).second);
+    EXPECT_EQ(1u, set.size());
+}
+
+}   // namespace
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/occlusion.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class OcclusionTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // Reference test of a segment against a triangle from either side.
+    static bool crosses(
+        const plucker::Vector3<T>& from,
+        const plucker::Vector3<T>& to,
+        const plucker::Vector3<T>& p1,
+        const plucker::Vector3<T>& p2,
+        const plucker::Vector3<T>& p3)
+    {
+        const plucker::Vector3<T> d = to - from;
+        const plucker::Vector3<T> e1 = p2 - p1;
+        const plucker::Vector3<T> e2 = p3 - p1;
+        const plucker::Vector3<T> q = d.cross(e2);
+        const auto det = e1.dot(q);
+        if(det == T(0))
+            return false;
+        const plucker::Vector3<T> s = from - p1;
+        const auto u = s.dot(q) / det;
+        const plucker::Vector3<T> r = s.cross(e1);
+        const auto v = d.dot(r) / det;
+        const auto t = e2.dot(r) / det;
+        return u >= T(0) && v >= T(0) && u + v <= T(1) && t > T(0) && t < T(1);
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(OcclusionTest, MyTypes);
+
+TYPED_TEST(OcclusionTest, is_occluded)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    const auto mesh = plucker_helper::make_octahedron<TypeParam>();
+    const plucker::OcclusionQuery<TypeParam> query(mesh);
+
+    // Through the octahedron.
+    EXPECT_TRUE(query.is_occluded(Vector3(TypeParam(0.1), TypeParam(0.2), TypeParam(5)), Vector3(TypeParam(0.1), TypeParam(0.2), TypeParam(-5))));
+    // From inside to outside.
+    EXPECT_TRUE(query.is_occluded(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(3), TypeParam(1), TypeParam(2))));
+    // Both ends inside.
+    EXPECT_FALSE(query.is_occluded(Vector3(TypeParam(0.1), TypeParam(0), TypeParam(0)), Vector3(TypeParam(-0.1), TypeParam(0.1), TypeParam(0))));
+    // Stopping short of the octahedron.
+    EXPECT_FALSE(query.is_occluded(Vector3(TypeParam(0.1), TypeParam(0.2), TypeParam(5)), Vector3(TypeParam(0.1), TypeParam(0.2), TypeParam(2))));
+    // Passing by.
+    EXPECT_FALSE(query.is_occluded(Vector3(TypeParam(2), TypeParam(0), TypeParam(5)), Vector3(TypeParam(2), TypeParam(0), TypeParam(-5))));
+
+    // Same as a triangle by triangle reference.
+    const auto& triangles = mesh.triangles();
+    for(auto n = 0; n < 500; n++)
+    {
+        const Vector3 from = TypeParam(2) * Vector3::Random();
+        const Vector3 to = TypeParam(2) * Vector3::Random();
+
+        auto expected = false;
+        for(Eigen::Index t = 0; t < triangles.rows(); t++)
+        {
+            expected = expected || OcclusionTest<TypeParam>::crosses(from, to,
+                mesh.vertex(triangles(t, 0)), mesh.vertex(triangles(t, 1)), mesh.vertex(triangles(t, 2)));
+        }
+        EXPECT_EQ(expected, query.is_occluded(plucker::Segment<TypeParam>(from, to)));
+    }
+}
+
+TYPED_TEST(OcclusionTest, is_occluded_batch)
+{
+    const auto mesh = plucker_helper::make_octahedron<TypeParam>();
+    const plucker::OcclusionQuery<TypeParam> query(mesh);
+
+    const Eigen::Index count = 1000;
+    const plucker::SegmentBatch<TypeParam> segments = TypeParam(2) * plucker::SegmentBatch<TypeParam>::Random(count, 6);
+
+    std::vector<std::uint64_t> mask;
+    for(const auto threads : { 1u, 3u })
+    {
+        query.is_occluded(segments, mask, threads);
+        ASSERT_EQ(static_cast<std::size_t>((count + 63) / 64), mask.size());
+        for(Eigen::Index k = 0; k < count; k++)
+        {
+            const plucker::Vector3<TypeParam> from = segments.row(k).template head<3>().transpose();
+            const plucker::Vector3<TypeParam> to = segments.row(k).template tail<3>().transpose();
+            const auto bit = (mask[static_cast<std::size_t>(k / 64)] >> (k % 64)) & 1u;
+            EXPECT_EQ(query.is_occluded(from, to) ? 1u : 0u, bit);
+        }
+    }
+}
+
+}   // namespace
@@ -98,6 +98,28 @@ TYPED_TEST(PlaneTest, Accessor)
     }
 }
 
+TYPED_TEST(PlaneTest, View)
+{
+    using Vector3 = typename plucker::Plane<TypeParam>::Vector3;
+    using Plane = plucker::Plane<TypeParam>;
+
+    constexpr auto atol = PlaneTest<TypeParam>::absolute_tolerance();
+
+    TypeParam buffer[4] = {TypeParam(0), TypeParam(0), TypeParam(1), TypeParam(-3)};
+
+    const plucker::PlaneView<const TypeParam> view(buffer);
+    EXPECT_EQ(buffer, view.coord().data());
+    EXPECT_ALMOST_EQUAL(TypeParam(1), view.c(), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(-3), view.d(), atol);
+    EXPECT_MAT_ALMOST_EQUAL(Vector3::UnitZ().eval(), Vector3(view.normal()), atol);
+
+    Plane plane;
+    plucker::PlaneView<TypeParam> writable(plane);
+    writable.coord() << TypeParam(1), TypeParam(2), TypeParam(3), TypeParam(4);
+    EXPECT_ALMOST_EQUAL(TypeParam(2), plane.b(), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(4), plane.d(), atol);
+}
+
 TYPED_TEST(PlaneTest, Alignment)
 {
     using Plane = plucker::Plane<TypeParam>;
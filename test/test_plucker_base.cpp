@@ -203,6 +203,47 @@ TYPED_TEST(PluckerBaseTest, Multiplication)
     }
 }
 
+TYPED_TEST(PluckerBaseTest, View)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Vector6 = plucker::Vector6<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = PluckerBaseTest<TypeParam>::absolute_tolerance();
+
+    // Two lines, (l:m) each, in an external buffer.
+    TypeParam buffer[12] = {
+        TypeParam(0), TypeParam(0), TypeParam(-2), TypeParam(4), TypeParam(0), TypeParam(0),
+        TypeParam(0), TypeParam(-2), TypeParam(0), TypeParam(0), TypeParam(0), TypeParam(4)};
+
+    const plucker::PluckerView<const TypeParam> p1(buffer);
+    plucker::PluckerView<TypeParam> p2(buffer + 6);
+    EXPECT_EQ(buffer, p1.coord().data());
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(0), TypeParam(0), TypeParam(-2)), Vector3(p1.l()), atol);
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(4), TypeParam(0), TypeParam(0)), Vector3(p1.m()), atol);
+
+    // Products of views and lines alike.
+    const Plucker q1(Vector6(p1.coord()));
+    const Plucker q2(Vector6(p2.coord()));
+    EXPECT_ALMOST_EQUAL(q1 * q2, p1 * p2, atol);
+    EXPECT_ALMOST_EQUAL(q1 * q2, q1 * p2, atol);
+
+    // Unary and scalar operators of views.
+    EXPECT_MAT_ALMOST_EQUAL(q1.coord(), (+p1).coord(), atol);
+    EXPECT_MAT_ALMOST_EQUAL((-q1).coord(), (-p1).coord(), atol);
+    EXPECT_MAT_ALMOST_EQUAL((q1 * TypeParam(3)).coord(), (p1 * TypeParam(3)).coord(), atol);
+    EXPECT_MAT_ALMOST_EQUAL((TypeParam(3) * q1).coord(), (TypeParam(3) * p1).coord(), atol);
+
+    // Writes go to the buffer.
+    p2.coord() *= TypeParam(2);
+    EXPECT_ALMOST_EQUAL(TypeParam(8), buffer[11], atol);
+
+    Plucker p(q1);
+    plucker::PluckerView<TypeParam> view(p);
+    view.coord().template head<3>() = Vector3::UnitX();
+    EXPECT_MAT_ALMOST_EQUAL(Vector3::UnitX().eval(), Vector3(p.l()), atol);
+}
+
 TYPED_TEST(PluckerBaseTest, Alignment)
 {
     using Vector6 = plucker::Vector6<TypeParam>;
@@ -127,6 +127,80 @@ TYPED_TEST(PluckerFindTest, find_intersection_of_two_planes)
     }
 }
 
+TYPED_TEST(PluckerFindTest, find_intersection_of_three_planes)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plane = plucker::Plane<TypeParam>;
+
+    constexpr auto atol = PluckerFindTest<TypeParam>::absolute_tolerance();
+
+    {
+        const auto plane1 = Plane(TypeParam(1), TypeParam(0), TypeParam(0), TypeParam(-1));
+        const auto plane2 = Plane(TypeParam(0), TypeParam(1), TypeParam(0), TypeParam(-2));
+        const auto plane3 = Plane(TypeParam(1), TypeParam(1), TypeParam(1), TypeParam(-6));
+
+        const auto res = find_intersection(plane1, plane2, plane3, atol);
+        const Vector3 intersection = std::get<1>(res).hnormalized();
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(2), TypeParam(3)), intersection, atol);
+    }
+    {
+        // Three planes through a common line.
+        const auto plane1 = Plane(TypeParam(1), TypeParam(0), TypeParam(0), TypeParam(0));
+        const auto plane2 = Plane(TypeParam(0), TypeParam(1), TypeParam(0), TypeParam(0));
+        const auto plane3 = Plane(TypeParam(1), TypeParam(1), TypeParam(0), TypeParam(0));
+
+        const auto res = find_intersection(plane1, plane2, plane3, atol);
+        EXPECT_FALSE(std::get<0>(res));
+    }
+}
+
+TYPED_TEST(PluckerFindTest, find_with_views)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+    using Plane = plucker::Plane<TypeParam>;
+
+    constexpr auto atol = PluckerFindTest<TypeParam>::absolute_tolerance();
+
+    // Lines as components of records in an external buffer.
+    struct Record
+    {
+        int id;
+        TypeParam line[6];
+    };
+    Record records[2];
+    Eigen::Map<plucker::Vector6<TypeParam>>(records[0].line) = Plucker(Vector3::UnitX().homogeneous().eval(), Vector3::UnitY().homogeneous().eval()).coord();
+    Eigen::Map<plucker::Vector6<TypeParam>>(records[1].line) = Plucker(Vector3::Zero().homogeneous().eval(), Vector3::UnitY().homogeneous().eval()).coord();
+    const TypeParam plane_coord[4] = {TypeParam(0), TypeParam(0), TypeParam(1), TypeParam(-1)};
+
+    const plucker::PluckerView<const TypeParam> p1(records[0].line);
+    const plucker::PluckerView<const TypeParam> p2(records[1].line);
+    const plucker::PlaneView<const TypeParam> plane(plane_coord);
+
+    {
+        const auto res = find_intersection(p1, p2, atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_MAT_ALMOST_EQUAL(Vector3::UnitY().eval(), Vector3(std::get<1>(res).hnormalized()), atol);
+    }
+    {
+        // Mixed with an owning line.
+        const Plucker q2(plucker::Vector6<TypeParam>(p2.coord()));
+        const auto res = find_closest_points(p1, q2, atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_MAT_ALMOST_EQUAL(Vector3::UnitY().eval(), Vector3(std::get<1>(res).hnormalized()), atol);
+    }
+    {
+        const auto res = find_intersection(p1, plane, atol);
+        EXPECT_FALSE(std::get<0>(res));
+    }
+    {
+        const Plane xy(Vector3::UnitZ(), TypeParam(0));
+        const auto res = find_intersection(plane, xy, atol);
+        EXPECT_FALSE(std::get<0>(res));
+    }
+}
+
 TYPED_TEST(PluckerFindTest, find_closest_points)
 {
     using Vector3 = plucker::Vector3<TypeParam>;
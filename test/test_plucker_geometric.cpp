@@ -49,6 +49,27 @@ TYPED_TEST(PluckerGeometricTest, normalize)
     EXPECT_ALMOST_EQUAL(line.m().norm() / line.l().norm(), res.m().norm(), atol);
 }
 
+TYPED_TEST(PluckerGeometricTest, canonicalize)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = PluckerGeometricTest<TypeParam>::absolute_tolerance();
+
+    const auto from = Vector3(TypeParam(1), TypeParam(2), TypeParam(6));
+    const auto to = Vector3(TypeParam(0), TypeParam(2), TypeParam(4));
+
+    const Plucker line(from.homogeneous().eval(), to.homogeneous().eval());
+
+    const auto res1 = canonicalize(line);
+    const auto res2 = canonicalize(TypeParam(-3) * line);
+
+    EXPECT_ALMOST_EQUAL(TypeParam(1), res1.l().norm(), atol);
+    EXPECT_LT(TypeParam(0), res1.l().z());
+    EXPECT_TRUE(plucker::are_same(line, res1, atol));
+    EXPECT_MAT_ALMOST_EQUAL(res1.coord(), res2.coord(), atol);
+}
+
 TYPED_TEST(PluckerGeometricTest, squared_distance_from_origin_to_line)
 {
     using Vector3 = plucker::Vector3<TypeParam>;
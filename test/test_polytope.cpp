@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/polytope.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class PolytopeTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // The box [-1, 1]^3 scaled by `size` and moved by `center`.
+    static plucker::Vector4Batch<T> make_box(const plucker::Vector3<T>& center, T size)
+    {
+        plucker::Vector4Batch<T> planes(6, 4);
+        for(Eigen::Index i = 0; i < 3; i++)
+        {
+            const plucker::Vector3<T> n = plucker::Vector3<T>::Unit(i);
+            planes.row(2 * i) << n.transpose(), -center(i) - size;
+            planes.row(2 * i + 1) << -n.transpose(), center(i) - size;
+        }
+        return planes;
+    }
+
+    // Counts the rows of `vertices` near `point`.
+    static int count_near(const plucker::Vector3Batch<T>& vertices, const plucker::Vector3<T>& point, T tolerance)
+    {
+        auto count = 0;
+        for(Eigen::Index i = 0; i < vertices.rows(); i++)
+        {
+            if((vertices.row(i).transpose() - point).norm() <= tolerance)
+                count++;
+        }
+        return count;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(PolytopeTest, MyTypes);
+
+TYPED_TEST(PolytopeTest, find_vertices)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = PolytopeTest<TypeParam>::absolute_tolerance();
+
+    // The eight corners of a box.
+    {
+        const auto planes = PolytopeTest<TypeParam>::make_box(Vector3(TypeParam(1), TypeParam(2), TypeParam(3)), TypeParam(0.5));
+        const auto vertices = plucker::find_vertices(planes, atol);
+        EXPECT_EQ(8, vertices.rows());
+        for(auto corner = 0; corner < 8; corner++)
+        {
+            const Vector3 point(
+                TypeParam(1) + ((corner & 1) ? TypeParam(0.5) : TypeParam(-0.5)),
+                TypeParam(2) + ((corner & 2) ? TypeParam(0.5) : TypeParam(-0.5)),
+                TypeParam(3) + ((corner & 4) ? TypeParam(0.5) : TypeParam(-0.5)));
+            EXPECT_EQ(1, PolytopeTest<TypeParam>::count_near(vertices, point, atol));
+        }
+    }
+
+    // A square pyramid has its apex on four planes, reported once.
+    {
+        plucker::Vector4Batch<TypeParam> planes(5, 4);
+        planes <<
+            TypeParam(1), TypeParam(0), TypeParam(1), TypeParam(-1),
+            TypeParam(-1), TypeParam(0), TypeParam(1), TypeParam(-1),
+            TypeParam(0), TypeParam(1), TypeParam(1), TypeParam(-1),
+            TypeParam(0), TypeParam(-1), TypeParam(1), TypeParam(-1),
+            TypeParam(0), TypeParam(0), TypeParam(-1), TypeParam(0);
+        const auto vertices = plucker::find_vertices(planes, atol);
+        EXPECT_EQ(5, vertices.rows());
+        EXPECT_EQ(1, PolytopeTest<TypeParam>::count_near(vertices, Vector3::UnitZ(), atol));
+    }
+
+    // The corners of rotated boxes far off the origin, whose planes are scaled up,
+    // so the rounding on the planes of a corner exceeds the tolerance.
+    for(auto n = 0; n < 20; n++)
+    {
+        const Eigen::Matrix<TypeParam, 3, 3> rotation = Eigen::Quaternion<TypeParam>::UnitRandom().toRotationMatrix();
+        const Vector3 center = TypeParam(1000) * Vector3::Random();
+        auto planes = PolytopeTest<TypeParam>::make_box(Vector3::Zero(), TypeParam(1));
+        for(Eigen::Index p = 0; p < planes.rows(); p++)
+        {
+            const Vector3 normal = rotation * Vector3(planes.row(p).template head<3>().transpose());
+            planes.row(p) << normal.transpose(), planes(p, 3) - normal.dot(center);
+            planes.row(p) *= TypeParam(1000) * (TypeParam(p) + TypeParam(1));
+        }
+        EXPECT_EQ(8, plucker::find_vertices(planes, atol).rows());
+    }
+
+    // Empty.
+    {
+        plucker::Vector4Batch<TypeParam> planes(4, 4);
+        planes <<
+            TypeParam(1), TypeParam(0), TypeParam(0), TypeParam(1),
+            TypeParam(-1), TypeParam(0), TypeParam(0), TypeParam(2),
+            TypeParam(0), TypeParam(1), TypeParam(0), TypeParam(0),
+            TypeParam(0), TypeParam(0), TypeParam(1), TypeParam(0);
+        EXPECT_EQ(0, plucker::find_vertices(planes, atol).rows());
+    }
+}
+
+TYPED_TEST(PolytopeTest, find_vertices_batch)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = PolytopeTest<TypeParam>::absolute_tolerance();
+
+    // Boxes cut by a random extra plane through their center.
+    const std::size_t count = 100;
+    plucker::Vector4Batch<TypeParam> planes(static_cast<Eigen::Index>(7 * count), 4);
+    std::vector<std::size_t> offsets(1, 0);
+    for(std::size_t k = 0; k < count; k++)
+    {
+        const Vector3 center = TypeParam(5) * Vector3::Random();
+        const auto row = static_cast<Eigen::Index>(offsets.back());
+        planes.middleRows(row, 6) = PolytopeTest<TypeParam>::make_box(center, TypeParam(1));
+        const Vector3 n = Vector3::Random().normalized();
+        planes.row(row + 6) << n.transpose(), -n.dot(center);
+        offsets.push_back(offsets.back() + 7);
+    }
+
+    plucker::Vector3Batch<TypeParam> vertices;
+    std::vector<std::size_t> res_offsets;
+    plucker::find_vertices(planes, offsets, atol, vertices, res_offsets, 3);
+    ASSERT_EQ(offsets.size(), res_offsets.size());
+    EXPECT_EQ(static_cast<std::size_t>(vertices.rows()), res_offsets.back());
+
+    for(std::size_t k = 0; k < count; k++)
+    {
+        const plucker::Vector4Batch<TypeParam> polytope = planes.middleRows(static_cast<Eigen::Index>(offsets[k]), 7);
+        const auto expected = plucker::find_vertices(polytope, atol);
+        const auto n = static_cast<Eigen::Index>(res_offsets[k + 1] - res_offsets[k]);
+        ASSERT_EQ(expected.rows(), n);
+        EXPECT_LE(4, n);
+        for(Eigen::Index i = 0; i < n; i++)
+        {
+            const Vector3 vertex = vertices.row(static_cast<Eigen::Index>(res_offsets[k]) + i).transpose();
+            EXPECT_MAT_ALMOST_EQUAL(Vector3(expected.row(i).transpose()), vertex, atol);
+
+            // Inside all planes, and on at least three.
+            const plucker::VectorX<TypeParam> d = polytope * vertex.homogeneous();
+            EXPECT_GE(TypeParam(10) * atol, d.maxCoeff());
+            EXPECT_LE(3, (d.array().abs() <= TypeParam(10) * atol).count());
+        }
+    }
+}
+
+}   // namespace
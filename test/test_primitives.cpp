@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/plucker_common.h>
+#include <plucker/primitives.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class PrimitivesTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    static plucker::Vector3<T> point_at(const plucker::Plucker<T>& line, T t)
+    {
+        return plucker::point_on_line(line, t).hnormalized();
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(PrimitivesTest, MyTypes);
+
+TYPED_TEST(PrimitivesTest, squared_distance)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = PrimitivesTest<TypeParam>::absolute_tolerance();
+
+    const auto line = plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(2), TypeParam(0), TypeParam(0)));
+
+    // A segment crossing over the line.
+    EXPECT_ALMOST_EQUAL(TypeParam(4), plucker::squared_distance(line, Vector3(TypeParam(1), TypeParam(-1), TypeParam(2)), Vector3(TypeParam(1), TypeParam(1), TypeParam(2))), atol);
+    // A segment whose nearest point is an end point.
+    EXPECT_ALMOST_EQUAL(TypeParam(2), plucker::squared_distance(line, Vector3(TypeParam(0), TypeParam(1), TypeParam(1)), Vector3(TypeParam(0), TypeParam(3), TypeParam(3))), atol);
+    // A segment parallel to the line.
+    EXPECT_ALMOST_EQUAL(TypeParam(9), plucker::squared_distance(line, Vector3(TypeParam(-5), TypeParam(0), TypeParam(3)), Vector3(TypeParam(5), TypeParam(0), TypeParam(3))), atol);
+
+    // Same as the nearest of points sampled along the segment.
+    for(auto n = 0; n < 100; n++)
+    {
+        const auto random_line = plucker_helper::make_line<TypeParam>(Vector3::Random(), Vector3::Random());
+        const auto normalized = normalize(random_line);
+        const Vector3 p0 = TypeParam(2) * Vector3::Random();
+        const Vector3 p1 = TypeParam(2) * Vector3::Random();
+
+        auto expected = std::numeric_limits<TypeParam>::max();
+        for(auto i = 0; i <= 1000; i++)
+        {
+            const Vector3 p = p0 + (TypeParam(i) / TypeParam(1000)) * (p1 - p0);
+            expected = std::min(expected, plucker::distance(normalized, p));
+        }
+        EXPECT_NEAR(expected, std::sqrt(plucker::squared_distance(random_line, p0, p1)), TypeParam(1e-2));
+    }
+}
+
+TYPED_TEST(PrimitivesTest, Sphere)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Sphere = plucker::Sphere<TypeParam>;
+
+    constexpr auto atol = PrimitivesTest<TypeParam>::absolute_tolerance();
+
+    const Sphere sphere(Vector3(TypeParam(1), TypeParam(2), TypeParam(3)), TypeParam(2));
+
+    // An unnormalized line through the center.
+    const auto line = plucker_helper::make_line<TypeParam>(Vector3(TypeParam(1), TypeParam(2), TypeParam(-3)), Vector3(TypeParam(1), TypeParam(2), TypeParam(0)));
+    EXPECT_TRUE(has_intersection(line, sphere));
+    {
+        const auto res = find_intersection(normalize(line), sphere);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(1), std::get<1>(res), atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(5), std::get<2>(res), atol);
+    }
+
+    // A line passing by the sphere.
+    const auto miss = plucker_helper::make_line<TypeParam>(Vector3(TypeParam(4), TypeParam(2), TypeParam(0)), Vector3(TypeParam(4), TypeParam(3), TypeParam(0)));
+    EXPECT_FALSE(has_intersection(miss, sphere));
+    EXPECT_FALSE(std::get<0>(find_intersection(normalize(miss), sphere)));
+
+    // The points found are on the sphere.
+    for(auto n = 0; n < 100; n++)
+    {
+        const auto random_line = normalize(plucker_helper::make_line<TypeParam>(Vector3::Random(), (sphere.center() + TypeParam(2) * Vector3::Random()).eval()));
+        const auto res = find_intersection(random_line, sphere);
+        EXPECT_EQ(has_intersection(random_line, sphere), std::get<0>(res));
+        if(!std::get<0>(res))
+            continue;
+        EXPECT_ALMOST_EQUAL(sphere.radius(), (PrimitivesTest<TypeParam>::point_at(random_line, std::get<1>(res)) - sphere.center()).norm(), TypeParam(1e-3));
+        EXPECT_ALMOST_EQUAL(sphere.radius(), (PrimitivesTest<TypeParam>::point_at(random_line, std::get<2>(res)) - sphere.center()).norm(), TypeParam(1e-3));
+    }
+}
+
+TYPED_TEST(PrimitivesTest, Capsule)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Capsule = plucker::Capsule<TypeParam>;
+
+    const Capsule capsule(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(4)), TypeParam(1));
+
+    // A line across the body.
+    EXPECT_TRUE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(-5), TypeParam(0.5), TypeParam(2)), Vector3(TypeParam(5), TypeParam(0.5), TypeParam(2))), capsule));
+    // A line across a cap, but not the cylinder capped at p0.
+    EXPECT_TRUE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(-5), TypeParam(0), TypeParam(-0.5)), Vector3(TypeParam(5), TypeParam(0), TypeParam(-0.5))), capsule));
+    // A line beyond a cap.
+    EXPECT_FALSE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(-5), TypeParam(0), TypeParam(5.5)), Vector3(TypeParam(5), TypeParam(0), TypeParam(5.5))), capsule));
+    // A line parallel to the axis.
+    EXPECT_FALSE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(1.5), TypeParam(0), TypeParam(0)), Vector3(TypeParam(1.5), TypeParam(0), TypeParam(1))), capsule));
+    EXPECT_TRUE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0.5), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0.5), TypeParam(0), TypeParam(1))), capsule));
+}
+
+TYPED_TEST(PrimitivesTest, InfiniteCylinder)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = PrimitivesTest<TypeParam>::absolute_tolerance();
+
+    const auto axis = plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(1)));
+
+    EXPECT_TRUE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(-5), TypeParam(0.5), TypeParam(100)), Vector3(TypeParam(5), TypeParam(0.5), TypeParam(100))), axis, TypeParam(1), atol));
+    EXPECT_FALSE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(-5), TypeParam(1.5), TypeParam(100)), Vector3(TypeParam(5), TypeParam(1.5), TypeParam(100))), axis, TypeParam(1), atol));
+    // Lines parallel to the axis.
+    EXPECT_TRUE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0.5), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0.5), TypeParam(0), TypeParam(1))), axis, TypeParam(1), atol));
+    EXPECT_FALSE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(1.5), TypeParam(0), TypeParam(0)), Vector3(TypeParam(1.5), TypeParam(0), TypeParam(1))), axis, TypeParam(1), atol));
+}
+
+TYPED_TEST(PrimitivesTest, Cylinder)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Cylinder = plucker::Cylinder<TypeParam>;
+
+    constexpr auto atol = PrimitivesTest<TypeParam>::absolute_tolerance();
+
+    const Cylinder cylinder(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(2)), TypeParam(1));
+
+    // A line across the side.
+    {
+        const auto line = normalize(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(TypeParam(1), TypeParam(0), TypeParam(1))));
+        const auto res = find_intersection(line, cylinder, atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(-1), std::get<1>(res), atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(1), std::get<2>(res), atol);
+    }
+    // A line along the axis through the caps.
+    {
+        const auto line = normalize(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0.5), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0.5), TypeParam(0), TypeParam(1))));
+        const auto res = find_intersection(line, cylinder, atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(0), std::get<1>(res), atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(2), std::get<2>(res), atol);
+    }
+    // A line beyond a cap, and one outside the side.
+    EXPECT_FALSE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0), TypeParam(0), TypeParam(3)), Vector3(TypeParam(1), TypeParam(0), TypeParam(3))), cylinder, atol));
+    EXPECT_FALSE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(1.5), TypeParam(0), TypeParam(0)), Vector3(TypeParam(1.5), TypeParam(0), TypeParam(1))), cylinder, atol));
+    // A line crossing the edge of a cap, which the infinite cylinder test would miss.
+    EXPECT_FALSE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0), TypeParam(0), TypeParam(3.5)), Vector3(TypeParam(1), TypeParam(0), TypeParam(2.5))), cylinder, atol));
+    EXPECT_TRUE(has_intersection(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0), TypeParam(0), TypeParam(2.5)), Vector3(TypeParam(1), TypeParam(0), TypeParam(1.5))), cylinder, atol));
+
+    // A cylinder of zero height, through which the line passes.
+    {
+        const Cylinder degenerate(Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), Vector3(TypeParam(0), TypeParam(0), TypeParam(1)), TypeParam(1));
+        const auto line = normalize(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0), TypeParam(0), TypeParam(2))));
+        EXPECT_FALSE(std::get<0>(find_intersection(line, degenerate, atol)));
+        EXPECT_FALSE(has_intersection(line, degenerate, atol));
+    }
+
+    // The points found are on the boundary.
+    for(auto n = 0; n < 100; n++)
+    {
+        const auto line = normalize(plucker_helper::make_line<TypeParam>(TypeParam(3) * Vector3::Random(), Vector3::Random() + Vector3::UnitZ()));
+        const auto res = find_intersection(line, cylinder, atol);
+        if(!std::get<0>(res))
+            continue;
+        for(const auto t : { std::get<1>(res), std::get<2>(res) })
+        {
+            const Vector3 p = PrimitivesTest<TypeParam>::point_at(line, t);
+            const auto radial = p.template head<2>().norm();
+            const auto on_side = std::abs(radial - TypeParam(1)) < TypeParam(1e-3) && p.z() > -TypeParam(1e-3) && p.z() < TypeParam(2) + TypeParam(1e-3);
+            const auto on_cap = radial < TypeParam(1) + TypeParam(1e-3) && (std::abs(p.z()) < TypeParam(1e-3) || std::abs(p.z() - TypeParam(2)) < TypeParam(1e-3));
+            EXPECT_TRUE(on_side || on_cap) << "p: " << p.transpose();
+        }
+    }
+}
+
+TYPED_TEST(PrimitivesTest, has_intersection_batch)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Sphere = plucker::Sphere<TypeParam>;
+    using Capsule = plucker::Capsule<TypeParam>;
+
+    const Eigen::Index count = 300;
+
+    plucker::SphereBatch<TypeParam> spheres(count, 4);
+    spheres.template leftCols<3>() = TypeParam(4) * plucker::Vector3Batch<TypeParam>::Random(count, 3);
+    spheres.col(3) = plucker::VectorX<TypeParam>::Random(count).cwiseAbs();
+
+    plucker::CapsuleBatch<TypeParam> capsules(count, 7);
+    capsules.template leftCols<3>() = TypeParam(4) * plucker::Vector3Batch<TypeParam>::Random(count, 3);
+    capsules.template middleCols<3>(3) = capsules.template leftCols<3>() + plucker::Vector3Batch<TypeParam>::Random(count, 3);
+    capsules.col(6) = TypeParam(0.5) * plucker::VectorX<TypeParam>::Random(count).cwiseAbs();
+
+    std::vector<std::uint8_t> res;
+    for(auto n = 0; n < 20; n++)
+    {
+        const auto line = plucker_helper::make_line<TypeParam>(TypeParam(4) * Vector3::Random(), TypeParam(4) * Vector3::Random());
+
+        plucker::has_intersection(line, spheres, res);
+        ASSERT_EQ(static_cast<std::size_t>(count), res.size());
+        auto first = count;
+        for(Eigen::Index i = 0; i < count; i++)
+        {
+            const Sphere sphere(spheres.row(i).template head<3>().transpose(), spheres(i, 3));
+            EXPECT_EQ(has_intersection(line, sphere) ? 1 : 0, res[static_cast<std::size_t>(i)]);
+            if(res[static_cast<std::size_t>(i)] && first == count)
+                first = i;
+        }
+        {
+            const auto hit = plucker::find_first_intersection(line, spheres);
+            EXPECT_EQ(first != count, std::get<0>(hit));
+            if(std::get<0>(hit))
+            {
+                EXPECT_EQ(first, std::get<1>(hit));
+            }
+        }
+
+        plucker::has_intersection(line, capsules, res);
+        ASSERT_EQ(static_cast<std::size_t>(count), res.size());
+        first = count;
+        for(Eigen::Index i = 0; i < count; i++)
+        {
+            const Capsule capsule(capsules.row(i).template head<3>().transpose(), capsules.row(i).template segment<3>(3).transpose(), capsules(i, 6));
+            EXPECT_EQ(has_intersection(line, capsule) ? 1 : 0, res[static_cast<std::size_t>(i)]);
+            if(res[static_cast<std::size_t>(i)] && first == count)
+                first = i;
+        }
+        {
+            const auto hit = plucker::find_first_intersection(line, capsules);
+            EXPECT_EQ(first != count, std::get<0>(hit));
+            if(std::get<0>(hit))
+            {
+                EXPECT_EQ(first, std::get<1>(hit));
+            }
+        }
+    }
+}
+
+TYPED_TEST(PrimitivesTest, with_views)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = PrimitivesTest<TypeParam>::absolute_tolerance();
+
+    // Normalized lines along z through (0.5, 0, 0) and the origin, in an external buffer.
+    TypeParam coords[12];
+    plucker::PluckerView<TypeParam>(coords).coord() = normalize(plucker_helper::make_line<TypeParam>(Vector3(TypeParam(0.5), TypeParam(0), TypeParam(0)), Vector3(TypeParam(0.5), TypeParam(0), TypeParam(1)))).coord();
+    plucker::PluckerView<TypeParam>(coords + 6).coord() = normalize(plucker_helper::make_line<TypeParam>(Vector3::Zero().eval(), Vector3::UnitZ().eval())).coord();
+    const plucker::PluckerView<const TypeParam> line(coords);
+    const plucker::PluckerView<const TypeParam> axis(coords + 6);
+
+    EXPECT_ALMOST_EQUAL(TypeParam(0.25), plucker::squared_distance(line, Vector3(TypeParam(-1), TypeParam(0.5), TypeParam(0)), Vector3(TypeParam(1), TypeParam(0.5), TypeParam(0))), atol);
+
+    const plucker::Sphere<TypeParam> sphere(Vector3(TypeParam(0), TypeParam(0), TypeParam(2)), TypeParam(1));
+    EXPECT_TRUE(has_intersection(line, sphere));
+    EXPECT_TRUE(std::get<0>(find_intersection(line, sphere)));
+    EXPECT_TRUE(has_intersection(line, plucker::Capsule<TypeParam>(Vector3::Zero(), Vector3::UnitX(), TypeParam(0.1))));
+    EXPECT_TRUE(has_intersection(line, axis, TypeParam(1), atol));
+    {
+        const auto res = find_intersection(line, plucker::Cylinder<TypeParam>(Vector3::Zero(), Vector3::UnitZ(), TypeParam(1)), atol);
+        EXPECT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(0), std::get<1>(res), atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(1), std::get<2>(res), atol);
+    }
+
+    plucker::SphereBatch<TypeParam> spheres(2, 4);
+    spheres << TypeParam(5), TypeParam(0), TypeParam(0), TypeParam(1),
+               TypeParam(0), TypeParam(0), TypeParam(2), TypeParam(1);
+    std::vector<std::uint8_t> res;
+    plucker::has_intersection(line, spheres, res);
+    EXPECT_EQ(std::vector<std::uint8_t>({0, 1}), res);
+    EXPECT_EQ(Eigen::Index(1), std::get<1>(plucker::find_first_intersection(line, spheres)));
+}
+
+}   // namespace
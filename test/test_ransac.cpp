@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <plucker/plucker_base.h>
+#include <plucker/plucker_query.h>
+#include <plucker/ransac.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class RansacTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // Points on the line through (1, 2, 3) along (1, 1, 0), followed by outliers.
+    static plucker::Vector3Batch<T> make_points(Eigen::Index inliers, Eigen::Index outliers)
+    {
+        plucker::Vector3Batch<T> points(inliers + outliers, 3);
+        for(Eigen::Index i = 0; i < inliers; i++)
+        {
+            const auto t = static_cast<T>(i) / static_cast<T>(inliers) * T(10);
+            points.row(i) << T(1) + t, T(2) + t, T(3);
+        }
+        points.bottomRows(outliers) = T(20) * plucker::Vector3Batch<T>::Random(outliers, 3);
+        return points;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(RansacTest, MyTypes);
+
+TYPED_TEST(RansacTest, squared_distance)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Plucker = plucker::Plucker<TypeParam>;
+
+    constexpr auto atol = RansacTest<TypeParam>::absolute_tolerance();
+
+    const auto from = Vector3(TypeParam(0), TypeParam(2), TypeParam(6));
+    const auto to = Vector3(TypeParam(0), TypeParam(2), TypeParam(4));
+    const Plucker line(from.homogeneous().eval(), to.homogeneous().eval());
+
+    const plucker::Vector3Batch<TypeParam> points = plucker::Vector3Batch<TypeParam>::Random(16, 3);
+
+    plucker::VectorX<TypeParam> res(points.rows());
+    plucker::distance(line, points, res);
+
+    for(Eigen::Index i = 0; i < points.rows(); i++)
+    {
+        const Vector3 point = points.row(i).transpose();
+        EXPECT_ALMOST_EQUAL(plucker::distance(normalize(line), point), res(i), atol);
+    }
+
+    // The same through a view of the coordinates.
+    plucker::VectorX<TypeParam> from_view(points.rows());
+    plucker::distance(plucker::PluckerView<const TypeParam>(line), points, from_view);
+    EXPECT_TRUE(res.isApprox(from_view));
+}
+
+TYPED_TEST(RansacTest, find_line_ransac)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = RansacTest<TypeParam>::absolute_tolerance();
+
+    const auto points = RansacTest<TypeParam>::make_points(200, 100);
+
+    plucker::RansacOptions<TypeParam> options;
+    options.threshold = TypeParam(0.01);
+    options.seed = 42;
+    options.num_threads = 1;
+
+    const auto res = plucker::find_line_ransac(points, options);
+    EXPECT_TRUE(res.found);
+    EXPECT_GE(res.inlier_count, 200u);
+    EXPECT_LE(res.iterations, options.max_iterations);
+    EXPECT_ALMOST_EQUAL(TypeParam(1), res.line.l().norm(), atol);
+    EXPECT_TRUE(plucker::contains(res.line, Vector3(TypeParam(1), TypeParam(2), TypeParam(3)).homogeneous().eval(), TypeParam(1e-3)));
+    EXPECT_TRUE(plucker::contains(res.line, Vector3(TypeParam(5), TypeParam(6), TypeParam(3)).homogeneous().eval(), TypeParam(1e-3)));
+
+    const auto inliers = plucker::find_inliers(res.line, points, options.threshold);
+    EXPECT_EQ(res.inlier_count, inliers.size());
+
+    // The same through a view of the line.
+    const auto viewed = plucker::find_inliers(plucker::PluckerView<const TypeParam>(res.line), points, options.threshold);
+    EXPECT_EQ(inliers, viewed);
+}
+
+TYPED_TEST(RansacTest, find_line_ransac_is_deterministic)
+{
+    const auto points = RansacTest<TypeParam>::make_points(50, 500);
+
+    plucker::RansacOptions<TypeParam> options;
+    options.threshold = TypeParam(0.01);
+    options.seed = 7;
+    options.hypotheses_per_round = 16;
+
+    options.num_threads = 1;
+    const auto res1 = plucker::find_line_ransac(points, options);
+    options.num_threads = 4;
+    const auto res2 = plucker::find_line_ransac(points, options);
+
+    EXPECT_TRUE(res1.found);
+    EXPECT_EQ(res1.inlier_count, res2.inlier_count);
+    EXPECT_EQ(res1.iterations, res2.iterations);
+    EXPECT_TRUE(res1.line.coord() == res2.line.coord());
+}
+
+TYPED_TEST(RansacTest, find_line_ransac_degenerate)
+{
+    plucker::RansacOptions<TypeParam> options;
+    options.threshold = TypeParam(0.01);
+
+    {
+        const plucker::Vector3Batch<TypeParam> points(1, 3);
+        const auto res = plucker::find_line_ransac(points, options);
+        EXPECT_FALSE(res.found);
+    }
+    {
+        const plucker::Vector3Batch<TypeParam> points = plucker::Vector3Batch<TypeParam>::Ones(8, 3);
+        options.max_iterations = 10;
+        const auto res = plucker::find_line_ransac(points, options);
+        EXPECT_FALSE(res.found);
+        EXPECT_EQ(10u, res.iterations);
+    }
+}
+
+}   // namespace
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/rasterizer.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class RasterizerTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    // A closed octahedron whose faces are counterclockwise seen from outside,
+    // optionally with a slanted ground triangle rising behind the camera.
+    static plucker::EdgeMesh<T> make_scene(bool ground)
+    {
+        using Triangles = typename plucker::EdgeMesh<T>::Triangles;
+
+        plucker::Vector3Batch<T> vertices(ground ? 9 : 6, 3);
+        vertices.topRows(6) = plucker_helper::octahedron_vertices<T>();
+
+        Triangles triangles(ground ? 9 : 8, 3);
+        triangles.topRows(8) = plucker_helper::octahedron_triangles<T>();
+
+        if(ground)
+        {
+            vertices.bottomRows(3) <<
+                -T(50), -T(10), -T(2),
+                 T(50), -T(10), -T(2),
+                 T(0),   T(50),  T(5);
+            triangles.row(8) << 6, 7, 8;
+        }
+        return plucker::EdgeMesh<T>(vertices, triangles);
+    }
+
+    // A camera at (0.2, -0.1, 4) looking down, whose size is not a multiple of the tile.
+    static plucker::PinholeCamera<T> make_camera()
+    {
+        Eigen::Matrix<T, 3, 3> rotation;
+        rotation <<
+            T(1),  T(0),  T(0),
+            T(0), -T(1),  T(0),
+            T(0),  T(0), -T(1);
+        return plucker::PinholeCamera<T>(
+            plucker::Vector3<T>(T(0.2), T(-0.1), T(4)), rotation,
+            T(20), T(22), T(13), T(10), 27, 21);
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(RasterizerTest, MyTypes);
+
+TYPED_TEST(RasterizerTest, product_coefficients)
+{
+    constexpr auto atol = RasterizerTest<TypeParam>::absolute_tolerance();
+
+    const auto camera = RasterizerTest<TypeParam>::make_camera();
+    const plucker::Plucker<TypeParam> line(
+        plucker::Vector4<TypeParam>(TypeParam(1), TypeParam(2), TypeParam(-1), TypeParam(1)),
+        plucker::Vector4<TypeParam>(TypeParam(-1), TypeParam(0), TypeParam(1), TypeParam(1)));
+
+    const plucker::Vector3<TypeParam> f = camera.product_coefficients().transpose() * line.coord();
+    for(auto y = 0; y < camera.height(); y += 5)
+    {
+        for(auto x = 0; x < camera.width(); x += 5)
+        {
+            EXPECT_ALMOST_EQUAL(line * camera.ray(x, y), f(0) + f(1) * TypeParam(x) + f(2) * TypeParam(y), TypeParam(10) * atol);
+        }
+    }
+}
+
+TYPED_TEST(RasterizerTest, rasterize)
+{
+    using index_type = typename plucker::EdgeMesh<TypeParam>::index_type;
+
+    constexpr auto atol = RasterizerTest<TypeParam>::absolute_tolerance();
+    const auto inf = std::numeric_limits<TypeParam>::infinity();
+
+    const auto camera = RasterizerTest<TypeParam>::make_camera();
+    const TypeParam ranges[3][2] = {{TypeParam(0), inf}, {TypeParam(3.2), inf}, {TypeParam(0), TypeParam(3.2)}};
+
+    for(const auto ground : {false, true})
+    {
+        const auto mesh = RasterizerTest<TypeParam>::make_scene(ground);
+        for(const auto& range : ranges)
+        {
+            // Reference by casting the ray of each pixel.
+            std::vector<plucker::RayHit<TypeParam>> expected;
+            plucker::find_closest_hits(mesh, camera, range[0], range[1], expected, 1);
+
+            std::vector<TypeParam> depths;
+            std::vector<index_type> ids;
+            plucker::rasterize(mesh, camera, range[0], range[1], depths, ids, 3);
+            ASSERT_EQ(camera.pixel_count(), depths.size());
+            ASSERT_EQ(camera.pixel_count(), ids.size());
+
+            auto misses = 0;
+            for(std::size_t k = 0; k < expected.size(); k++)
+            {
+                if(std::isinf(expected[k].t))
+                {
+                    misses++;
+                    EXPECT_TRUE(std::isinf(depths[k]));
+                    EXPECT_EQ(std::numeric_limits<index_type>::max(), ids[k]);
+                }
+                else
+                {
+                    EXPECT_EQ(expected[k].triangle, ids[k]);
+                    EXPECT_ALMOST_EQUAL(expected[k].t, depths[k], TypeParam(10) * atol);
+                }
+            }
+            EXPECT_LT(misses, static_cast<int>(expected.size()));
+            if(!ground && range[1] == inf)
+            {
+                EXPECT_LT(0, misses);
+            }
+        }
+    }
+}
+
+}   // namespace
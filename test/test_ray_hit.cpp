@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/ray_hit.h>
+#include "gtest_helper.h"
+#include "plucker_helper.h"
+
+namespace
+{
+
+template<typename T>
+class RayHitTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // Reference hit by Moller-Trumbore, culling back faces.
+    static bool moller_trumbore(
+        const plucker::Vector3<T>& origin,
+        const plucker::Vector3<T>& direction,
+        const plucker::Vector3<T>& p0,
+        const plucker::Vector3<T>& p1,
+        const plucker::Vector3<T>& p2,
+        T& t, T& u, T& v)
+    {
+        const plucker::Vector3<T> e1 = p1 - p0;
+        const plucker::Vector3<T> e2 = p2 - p0;
+        const plucker::Vector3<T> q = direction.cross(e2);
+        const auto det = e1.dot(q);
+        if(det <= T(0))
+            return false;
+        const plucker::Vector3<T> s = origin - p0;
+        u = s.dot(q) / det;
+        const plucker::Vector3<T> r = s.cross(e1);
+        v = direction.dot(r) / det;
+        t = e2.dot(r) / det;
+        return u >= T(0) && v >= T(0) && u + v <= T(1);
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(RayHitTest, MyTypes);
+
+TYPED_TEST(RayHitTest, find_hit)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = RayHitTest<TypeParam>::absolute_tolerance();
+
+    const auto mesh = plucker_helper::make_octahedron<TypeParam>();
+    const auto& triangles = mesh.triangles();
+
+    auto hits = 0;
+    for(auto n = 0; n < 200; n++)
+    {
+        const Vector3 origin = TypeParam(3) * Vector3::Random();
+        const Vector3 direction = Vector3::Random() - TypeParam(0.3) * origin;
+
+        for(std::size_t t = 0; t < mesh.triangle_count(); t++)
+        {
+            const auto row = static_cast<Eigen::Index>(t);
+            TypeParam rt, ru, rv;
+            const auto expected = RayHitTest<TypeParam>::moller_trumbore(origin, direction,
+                mesh.vertex(triangles(row, 0)), mesh.vertex(triangles(row, 1)), mesh.vertex(triangles(row, 2)), rt, ru, rv);
+
+            const auto res = plucker::find_hit(mesh, origin, direction, t);
+            EXPECT_EQ(expected, std::get<0>(res));
+            if(!expected || !std::get<0>(res))
+                continue;
+
+            hits++;
+            const auto& hit = std::get<1>(res);
+            EXPECT_EQ(t, hit.triangle);
+            EXPECT_ALMOST_EQUAL(rt, hit.t, TypeParam(10) * atol);
+            EXPECT_ALMOST_EQUAL(ru, hit.u, TypeParam(10) * atol);
+            EXPECT_ALMOST_EQUAL(rv, hit.v, TypeParam(10) * atol);
+
+            // The same through a view of the ray.
+            const plucker::Plucker<TypeParam> ray(origin.homogeneous().eval(), (origin + direction).homogeneous().eval());
+            const auto viewed = plucker::find_hit(mesh, plucker::PluckerView<const TypeParam>(ray), origin, direction, t);
+            EXPECT_TRUE(std::get<0>(viewed));
+            EXPECT_ALMOST_EQUAL(hit.t, std::get<1>(viewed).t, atol);
+        }
+    }
+    EXPECT_LT(0, hits);
+}
+
+TYPED_TEST(RayHitTest, find_closest_hit)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    constexpr auto atol = RayHitTest<TypeParam>::absolute_tolerance();
+    const auto inf = std::numeric_limits<TypeParam>::infinity();
+
+    const auto mesh = plucker_helper::make_octahedron<TypeParam>();
+    plucker::VectorX<TypeParam> products;
+
+    // Straight down onto the upper faces.
+    {
+        const Vector3 origin(TypeParam(0.1), TypeParam(0.2), TypeParam(5));
+        const Vector3 direction(TypeParam(0), TypeParam(0), TypeParam(-2));
+        const auto res = plucker::find_closest_hit(mesh, origin, direction, TypeParam(0), inf, products);
+        ASSERT_TRUE(std::get<0>(res));
+        EXPECT_ALMOST_EQUAL(TypeParam(2.15), std::get<1>(res).t, atol);
+
+        // Nothing within the range.
+        EXPECT_FALSE(std::get<0>(plucker::find_closest_hit(mesh, origin, direction, TypeParam(0), TypeParam(2), products)));
+        // From inside, the lower faces are seen from behind.
+        EXPECT_FALSE(std::get<0>(plucker::find_closest_hit(mesh, Vector3::Zero().eval(), direction, TypeParam(0), inf, products)));
+    }
+
+    // Origins and directions as batches.
+    const Eigen::Index count = 300;
+    const plucker::Vector3Batch<TypeParam> origins = TypeParam(3) * plucker::Vector3Batch<TypeParam>::Random(count, 3);
+    const plucker::Vector3Batch<TypeParam> directions = plucker::Vector3Batch<TypeParam>::Random(count, 3) - TypeParam(0.3) * origins;
+
+    std::vector<plucker::RayHit<TypeParam>> hits;
+    plucker::find_closest_hits(mesh, origins, directions, TypeParam(0), inf, hits, 3);
+    ASSERT_EQ(static_cast<std::size_t>(count), hits.size());
+
+    const auto& triangles = mesh.triangles();
+    for(Eigen::Index k = 0; k < count; k++)
+    {
+        const Vector3 origin = origins.row(k).transpose();
+        const Vector3 direction = directions.row(k).transpose();
+
+        auto expected = inf;
+        for(Eigen::Index t = 0; t < triangles.rows(); t++)
+        {
+            TypeParam rt, ru, rv;
+            if(RayHitTest<TypeParam>::moller_trumbore(origin, direction,
+                mesh.vertex(triangles(t, 0)), mesh.vertex(triangles(t, 1)), mesh.vertex(triangles(t, 2)), rt, ru, rv) && rt >= TypeParam(0))
+                expected = std::min(expected, rt);
+        }
+
+        const auto& hit = hits[static_cast<std::size_t>(k)];
+        if(std::isinf(expected))
+        {
+            EXPECT_TRUE(std::isinf(hit.t));
+        }
+        else
+        {
+            EXPECT_ALMOST_EQUAL(expected, hit.t, TypeParam(10) * atol);
+        }
+    }
+}
+
+}   // namespace
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/plucker_geometric.h>
+#include <plucker/segment.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class SegmentTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // Reference distance from the nearest of sampled points.
+    static T sampled_distance(const plucker::Segment<T>& segment1, const plucker::Segment<T>& segment2)
+    {
+        auto res = std::numeric_limits<T>::max();
+        for(auto i = 0; i <= 200; i++)
+            for(auto j = 0; j <= 200; j++)
+                res = std::min(res, (segment1.point(T(i) / T(200)) - segment2.point(T(j) / T(200))).norm());
+        return res;
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(SegmentTest, MyTypes);
+
+TYPED_TEST(SegmentTest, Constructor)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+
+    constexpr auto atol = SegmentTest<TypeParam>::absolute_tolerance();
+
+    const Vector3 p0(TypeParam(1), TypeParam(2), TypeParam(3));
+    const Vector3 p1(TypeParam(4), TypeParam(6), TypeParam(3));
+    const Segment segment(p0, p1);
+    EXPECT_ALMOST_EQUAL(TypeParam(5), segment.length(), atol);
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(2.5), TypeParam(4), TypeParam(3)), segment.point(TypeParam(0.5)), atol);
+
+    // From an interval of the line through the segment.
+    const auto line = normalize(segment.line());
+    const auto t0 = line.l().dot(p0);
+    const auto t1 = line.l().dot(p1);
+    const Segment other(line, t0, t1);
+    EXPECT_MAT_ALMOST_EQUAL(p0, other.p0(), atol);
+    EXPECT_MAT_ALMOST_EQUAL(p1, other.p1(), atol);
+
+    // And from a view of the line.
+    const Segment viewed(plucker::PluckerView<const TypeParam>(line), t0, t1);
+    EXPECT_MAT_ALMOST_EQUAL(p0, viewed.p0(), atol);
+    EXPECT_MAT_ALMOST_EQUAL(p1, viewed.p1(), atol);
+}
+
+TYPED_TEST(SegmentTest, closest_point)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+
+    constexpr auto atol = SegmentTest<TypeParam>::absolute_tolerance();
+
+    const Segment segment(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(2), TypeParam(0), TypeParam(0)));
+
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)), closest_point(segment, Vector3(TypeParam(1), TypeParam(3), TypeParam(0))), atol);
+    EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(2), TypeParam(0), TypeParam(0)), closest_point(segment, Vector3(TypeParam(5), TypeParam(0), TypeParam(4))), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(5), distance(segment, Vector3(TypeParam(5), TypeParam(0), TypeParam(4))), atol);
+    EXPECT_ALMOST_EQUAL(TypeParam(4), squared_distance(segment, Vector3(TypeParam(-2), TypeParam(0), TypeParam(0))), atol);
+
+    // A degenerate segment.
+    const Segment point(Vector3(TypeParam(1), TypeParam(1), TypeParam(1)), Vector3(TypeParam(1), TypeParam(1), TypeParam(1)));
+    EXPECT_ALMOST_EQUAL(TypeParam(3), squared_distance(point, Vector3(TypeParam(0), TypeParam(0), TypeParam(2))), atol);
+}
+
+TYPED_TEST(SegmentTest, find_closest_points)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Segment = plucker::Segment<TypeParam>;
+
+    constexpr auto atol = SegmentTest<TypeParam>::absolute_tolerance();
+
+    const Segment segment1(Vector3(TypeParam(0), TypeParam(0), TypeParam(0)), Vector3(TypeParam(2), TypeParam(0), TypeParam(0)));
+
+    // Crossing segments.
+    {
+        const Segment segment2(Vector3(TypeParam(1), TypeParam(-1), TypeParam(1)), Vector3(TypeParam(1), TypeParam(1), TypeParam(1)));
+        const auto res = find_closest_points(segment1, segment2);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(0), TypeParam(0)), std::get<0>(res), atol);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(1), TypeParam(0), TypeParam(1)), std::get<1>(res), atol);
+        EXPECT_ALMOST_EQUAL(TypeParam(1), distance(segment1, segment2), atol);
+    }
+    // Segments whose lines meet beyond them.
+    {
+        const Segment segment2(Vector3(TypeParam(4), TypeParam(1), TypeParam(0)), Vector3(TypeParam(4), TypeParam(3), TypeParam(0)));
+        const auto res = find_closest_points(segment1, segment2);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(2), TypeParam(0), TypeParam(0)), std::get<0>(res), atol);
+        EXPECT_MAT_ALMOST_EQUAL(Vector3(TypeParam(4), TypeParam(1), TypeParam(0)), std::get<1>(res), atol);
+    }
+    // Parallel segments.
+    {
+        const Segment segment2(Vector3(TypeParam(1), TypeParam(2), TypeParam(0)), Vector3(TypeParam(5), TypeParam(2), TypeParam(0)));
+        EXPECT_ALMOST_EQUAL(TypeParam(4), squared_distance(segment1, segment2), atol);
+    }
+
+    // Same as the nearest of sampled points.
+    for(auto n = 0; n < 50; n++)
+    {
+        const Segment segment2(Vector3::Random(), Vector3::Random());
+        const Segment segment3(Vector3::Random(), Vector3::Random());
+        EXPECT_NEAR(SegmentTest<TypeParam>::sampled_distance(segment2, segment3), distance(segment2, segment3), TypeParam(2e-2));
+    }
+}
+
+TYPED_TEST(SegmentTest, find_pairs_within)
+{
+    using Segment = plucker::Segment<TypeParam>;
+
+    const auto threshold = TypeParam(0.2);
+
+    plucker::SegmentBatch<TypeParam> segments1(150, 6);
+    segments1.template leftCols<3>() = TypeParam(4) * plucker::Vector3Batch<TypeParam>::Random(150, 3);
+    segments1.template rightCols<3>() = segments1.template leftCols<3>() + plucker::Vector3Batch<TypeParam>::Random(150, 3);
+
+    plucker::SegmentBatch<TypeParam> segments2(400, 6);
+    segments2.template leftCols<3>() = TypeParam(4) * plucker::Vector3Batch<TypeParam>::Random(400, 3);
+    segments2.template rightCols<3>() = segments2.template leftCols<3>() + plucker::Vector3Batch<TypeParam>::Random(400, 3);
+
+    const auto segment = [](const plucker::SegmentBatch<TypeParam>& batch, Eigen::Index i)
+    {
+        return Segment(batch.row(i).template head<3>().transpose(), batch.row(i).template tail<3>().transpose());
+    };
+
+    std::vector<plucker::IndexPair> expected;
+    for(Eigen::Index i = 0; i < segments1.rows(); i++)
+        for(Eigen::Index j = 0; j < segments2.rows(); j++)
+            if(distance(segment(segments1, i), segment(segments2, j)) <= threshold)
+                expected.emplace_back(static_cast<std::size_t>(i), static_cast<std::size_t>(j));
+    EXPECT_LT(0u, expected.size());
+
+    std::vector<plucker::IndexPair> expected_self;
+    for(Eigen::Index i = 0; i < segments2.rows(); i++)
+        for(Eigen::Index j = i + 1; j < segments2.rows(); j++)
+            if(distance(segment(segments2, i), segment(segments2, j)) <= threshold)
+                expected_self.emplace_back(static_cast<std::size_t>(i), static_cast<std::size_t>(j));
+    EXPECT_LT(0u, expected_self.size());
+
+    std::vector<plucker::IndexPair> pairs;
+    for(const auto threads : { 1u, 3u })
+    {
+        plucker::find_pairs_within(segments1, segments2, threshold, pairs, threads);
+        EXPECT_EQ(expected, pairs);
+
+        plucker::find_pairs_within(segments2, threshold, pairs, threads);
+        EXPECT_EQ(expected_self, pairs);
+    }
+}
+
+}   // namespace
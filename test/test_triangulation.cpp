@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/plucker_geometric.h>
+#include <plucker/triangulation.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class TriangulationTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // A camera at `center` looking at the origin.
+    static plucker::Camera<T> look_at_origin(const plucker::Vector3<T>& center)
+    {
+        using Vector3 = plucker::Vector3<T>;
+        using Matrix3 = typename plucker::Camera<T>::Matrix3;
+
+        const Vector3 z = (-center).normalized();
+        const Vector3 x = Vector3(T(0), T(1), T(0)).cross(z).normalized();
+        const Vector3 y = z.cross(x);
+
+        Matrix3 rotation;
+        rotation << x.transpose(), y.transpose(), z.transpose();
+        return plucker::Camera<T>(T(500), T(500), T(320), T(240), rotation, -rotation * center);
+    }
+
+    static plucker::Vector2<T> project(const plucker::Camera<T>& camera, const plucker::Vector3<T>& point)
+    {
+        const plucker::Vector3<T> p = camera.rotation() * point + camera.translation();
+        return plucker::Vector2<T>(camera.fx() * p.x() / p.z() + camera.cx(), camera.fy() * p.y() / p.z() + camera.cy());
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(TriangulationTest, MyTypes);
+
+TYPED_TEST(TriangulationTest, back_project)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    const auto camera = TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(1), TypeParam(2), TypeParam(-10)));
+    const auto point = Vector3(TypeParam(0.5), TypeParam(-0.25), TypeParam(1));
+
+    const auto ray = camera.back_project(TriangulationTest<TypeParam>::project(camera, point));
+
+    EXPECT_ALMOST_EQUAL(TypeParam(1), ray.l().norm(), TypeParam(1e-4));
+    EXPECT_ALMOST_EQUAL(TypeParam(0), plucker::distance(ray, point), TypeParam(1e-3));
+    EXPECT_ALMOST_EQUAL(TypeParam(0), plucker::distance(ray, camera.center()), TypeParam(1e-3));
+    EXPECT_LT(TypeParam(0), ray.l().dot(point - camera.center()));
+
+    // The same camera in the conventions of the camera rays.
+    const auto& pinhole = camera.pinhole();
+    EXPECT_MAT_ALMOST_EQUAL(camera.center(), pinhole.position(), TypeParam(1e-4));
+    EXPECT_MAT_ALMOST_EQUAL(camera.direction(TypeParam(300.5), TypeParam(200.5)), pinhole.direction(300, 200), TypeParam(1e-4));
+}
+
+TYPED_TEST(TriangulationTest, triangulate)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    typename plucker::Triangulator<TypeParam>::camera_container cameras;
+    cameras.push_back(TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(0), TypeParam(0), TypeParam(-10))));
+    cameras.push_back(TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(8), TypeParam(1), TypeParam(-6))));
+    cameras.push_back(TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(-8), TypeParam(-1), TypeParam(-6))));
+    cameras.push_back(TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(1), TypeParam(8), TypeParam(-6))));
+
+    std::vector<Vector3, Eigen::aligned_allocator<Vector3>> targets;
+    std::vector<std::size_t> camera_indices;
+    std::vector<std::size_t> offsets(1, 0);
+    std::vector<plucker::Vector2<TypeParam>, Eigen::aligned_allocator<plucker::Vector2<TypeParam>>> observations;
+
+    for(auto k = 0; k < 50; k++)
+    {
+        const Vector3 target = Vector3::Random();
+        for(std::size_t c = 0; c < cameras.size(); c++)
+        {
+            // Every fifth track has a wrong observation in the last camera.
+            auto pixel = TriangulationTest<TypeParam>::project(cameras[c], target);
+            if(k % 5 == 0 && c + 1 == cameras.size())
+                pixel.x() += TypeParam(40);
+
+            camera_indices.push_back(c);
+            observations.push_back(pixel);
+        }
+        offsets.push_back(camera_indices.size());
+        targets.push_back(target);
+    }
+    // A track seen by a single camera.
+    camera_indices.push_back(0);
+    observations.push_back(plucker::Vector2<TypeParam>(TypeParam(320), TypeParam(240)));
+    offsets.push_back(camera_indices.size());
+
+    plucker::Vector2Batch<TypeParam> pixels(observations.size(), 2);
+    for(std::size_t i = 0; i < observations.size(); i++)
+        pixels.row(static_cast<Eigen::Index>(i)) = observations[i].transpose();
+
+    plucker::TriangulationOptions<TypeParam> options;
+    options.threshold = TypeParam(0.01);
+    options.num_threads = 3;
+
+    plucker::Triangulator<TypeParam> triangulator;
+    plucker::Vector4Batch<TypeParam> points;
+    triangulator.triangulate(cameras, camera_indices, pixels, offsets, options, points);
+
+    ASSERT_EQ(51, points.rows());
+    EXPECT_EQ(observations.size(), static_cast<std::size_t>(triangulator.rays().rows()));
+    for(std::size_t k = 0; k < targets.size(); k++)
+    {
+        const auto row = static_cast<Eigen::Index>(k);
+        EXPECT_ALMOST_EQUAL(TypeParam(1), points(row, 3), TypeParam(1e-6));
+        EXPECT_MAT_ALMOST_EQUAL(targets[k], points.row(row).template head<3>().transpose(), TypeParam(1e-3));
+
+        const auto last = offsets[k + 1] - 1;
+        EXPECT_EQ((k % 5 == 0) ? 0 : 1, triangulator.inliers()[last]);
+        EXPECT_EQ(1, triangulator.inliers()[offsets[k]]);
+    }
+    EXPECT_ALMOST_EQUAL(TypeParam(0), points(50, 3), TypeParam(1e-6));
+    EXPECT_EQ(0, triangulator.inliers().back());
+}
+
+TYPED_TEST(TriangulationTest, default_options)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+
+    typename plucker::Triangulator<TypeParam>::camera_container cameras;
+    cameras.push_back(TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(0), TypeParam(0), TypeParam(-10))));
+    cameras.push_back(TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(8), TypeParam(1), TypeParam(-6))));
+    cameras.push_back(TriangulationTest<TypeParam>::look_at_origin(Vector3(TypeParam(-8), TypeParam(-1), TypeParam(-6))));
+
+    // Noisy observations of one point keep all of them.
+    const Vector3 target(TypeParam(0.2), TypeParam(-0.1), TypeParam(0.3));
+    const TypeParam noise[] = {TypeParam(0.4), TypeParam(-0.3), TypeParam(0.2)};
+
+    std::vector<std::size_t> camera_indices;
+    plucker::Vector2Batch<TypeParam> pixels(static_cast<Eigen::Index>(cameras.size()), 2);
+    for(std::size_t c = 0; c < cameras.size(); c++)
+    {
+        const auto row = static_cast<Eigen::Index>(c);
+        pixels.row(row) = TriangulationTest<TypeParam>::project(cameras[c], target).transpose();
+        pixels(row, 0) += noise[c];
+        pixels(row, 1) -= noise[c];
+        camera_indices.push_back(c);
+    }
+    const std::vector<std::size_t> offsets{0, cameras.size()};
+
+    plucker::Triangulator<TypeParam> triangulator;
+    plucker::Vector4Batch<TypeParam> points;
+    triangulator.triangulate(cameras, camera_indices, pixels, offsets, plucker::TriangulationOptions<TypeParam>(), points);
+
+    ASSERT_EQ(1, points.rows());
+    EXPECT_ALMOST_EQUAL(TypeParam(1), points(0, 3), TypeParam(1e-6));
+    EXPECT_MAT_ALMOST_EQUAL(target, Vector3(points.row(0).template head<3>().transpose()), TypeParam(0.05));
+    EXPECT_EQ((std::vector<std::uint8_t>{1, 1, 1}), triangulator.inliers());
+}
+
+}   // namespace
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <plucker/plucker_base.h>
+#include <plucker/uniform_grid.h>
+#include "gtest_helper.h"
+
+namespace
+{
+
+template<typename T>
+class UniformGridTest
+    : public ::testing::Test
+{
+protected:
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    absolute_tolerance(){ return 1e-4f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    absolute_tolerance(){ return 1e-8; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, float>::value, U>::type
+    relative_tolerance(){ return 1e-5f; }
+
+    template<typename U = T>
+    static constexpr typename std::enable_if<std::is_same<U, double>::value, U>::type
+    relative_tolerance(){ return 1e-5; }
+
+    // Small triangles scattered in a cube, facing anywhere.
+    static plucker::EdgeMesh<T> make_soup(Eigen::Index count)
+    {
+        using Triangles = typename plucker::EdgeMesh<T>::Triangles;
+
+        plucker::Vector3Batch<T> vertices(3 * count, 3);
+        Triangles triangles(count, 3);
+        for(Eigen::Index t = 0; t < count; t++)
+        {
+            const plucker::Vector3<T> center = T(2) * plucker::Vector3<T>::Random();
+            for(Eigen::Index i = 0; i < 3; i++)
+            {
+                vertices.row(3 * t + i) = (center + T(0.5) * plucker::Vector3<T>::Random()).transpose();
+                triangles(t, i) = static_cast<std::uint32_t>(3 * t + i);
+            }
+        }
+        return plucker::EdgeMesh<T>(vertices, triangles);
+    }
+};
+
+using MyTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(UniformGridTest, MyTypes);
+
+TYPED_TEST(UniformGridTest, Constructor)
+{
+    using Grid = plucker::UniformGrid<TypeParam>;
+
+    const auto mesh = UniformGridTest<TypeParam>::make_soup(100);
+    const Grid grid(mesh, typename Grid::Resolution(4, 5, 6));
+    EXPECT_EQ(120u, grid.cell_count());
+
+    // Every triangle is listed in the cell of each of its vertices.
+    for(std::size_t t = 0; t < mesh.triangle_count(); t++)
+    {
+        for(auto i = 0; i < 3; i++)
+        {
+            const plucker::Vector3<TypeParam> p = mesh.vertex(mesh.triangles()(static_cast<Eigen::Index>(t), i));
+            int index[3];
+            for(auto j = 0; j < 3; j++)
+            {
+                const auto c = static_cast<int>(std::floor((p(j) - grid.bounds().min()(j)) / grid.cell_size()(j)));
+                index[j] = std::max(0, std::min(grid.resolution()(j) - 1, c));
+            }
+            const std::uint32_t* first;
+            const std::uint32_t* last;
+            std::tie(first, last) = grid.cell(grid.cell_index(index[0], index[1], index[2]));
+            EXPECT_NE(last, std::find(first, last, static_cast<std::uint32_t>(t)));
+        }
+    }
+
+    const Grid automatic(mesh);
+    EXPECT_LE(1, automatic.resolution().minCoeff());
+}
+
+TYPED_TEST(UniformGridTest, traverse)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Grid = plucker::UniformGrid<TypeParam>;
+
+    constexpr auto atol = UniformGridTest<TypeParam>::absolute_tolerance();
+
+    const auto mesh = UniformGridTest<TypeParam>::make_soup(50);
+    const Grid grid(mesh, typename Grid::Resolution(7, 3, 5));
+
+    for(auto n = 0; n < 100; n++)
+    {
+        const Vector3 origin = TypeParam(4) * Vector3::Random();
+        Vector3 direction = Vector3::Random();
+        if(n % 5 == 0)
+            direction(n % 3) = TypeParam(0);
+
+        std::vector<std::size_t> cells;
+        auto previous = -std::numeric_limits<TypeParam>::infinity();
+        grid.traverse(origin, direction, TypeParam(0), TypeParam(10),
+            [&](std::size_t c, TypeParam t0, TypeParam t1)
+            {
+                // Ranges are in order and contiguous.
+                if(!cells.empty())
+                {
+                    EXPECT_ALMOST_EQUAL(previous, t0, TypeParam(10) * atol);
+                }
+                EXPECT_LE(t0, t1 + atol);
+                cells.push_back(c);
+                previous = t1;
+
+                // The middle of the range is in the cell.
+                const Vector3 p = origin + TypeParam(0.5) * (t0 + t1) * direction;
+                const Vector3 q = (p - grid.bounds().min()).cwiseQuotient(grid.cell_size());
+                const auto x = static_cast<std::size_t>(std::max(0, std::min(grid.resolution()(0) - 1, static_cast<int>(std::floor(q(0))))));
+                const auto y = static_cast<std::size_t>(std::max(0, std::min(grid.resolution()(1) - 1, static_cast<int>(std::floor(q(1))))));
+                const auto z = static_cast<std::size_t>(std::max(0, std::min(grid.resolution()(2) - 1, static_cast<int>(std::floor(q(2))))));
+                EXPECT_EQ(grid.cell_index(static_cast<int>(x), static_cast<int>(y), static_cast<int>(z)), c);
+                return true;
+            });
+
+        // No cell twice.
+        auto sorted = cells;
+        std::sort(sorted.begin(), sorted.end());
+        EXPECT_EQ(sorted.end(), std::adjacent_find(sorted.begin(), sorted.end()));
+    }
+
+    // A zero direction from inside the grid, unbounded in t, crosses no cell.
+    auto visits = 0;
+    grid.traverse(Vector3::Zero().eval(), Vector3::Zero().eval(), TypeParam(0), std::numeric_limits<TypeParam>::infinity(),
+        [&](std::size_t, TypeParam, TypeParam) { visits++; return true; });
+    EXPECT_EQ(0, visits);
+
+    typename Grid::Mailbox mailbox;
+    EXPECT_FALSE(std::get<0>(grid.find_closest_hit(Vector3::Zero().eval(), Vector3::Zero().eval(),
+        TypeParam(0), std::numeric_limits<TypeParam>::infinity(), mailbox)));
+}
+
+TYPED_TEST(UniformGridTest, find_closest_hit)
+{
+    using Vector3 = plucker::Vector3<TypeParam>;
+    using Grid = plucker::UniformGrid<TypeParam>;
+
+    constexpr auto atol = UniformGridTest<TypeParam>::absolute_tolerance();
+    const auto inf = std::numeric_limits<TypeParam>::infinity();
+
+    const auto mesh = UniformGridTest<TypeParam>::make_soup(300);
+    const Grid grid(mesh);
+
+    const Eigen::Index count = 300;
+    const plucker::Vector3Batch<TypeParam> origins = TypeParam(4) * plucker::Vector3Batch<TypeParam>::Random(count, 3);
+    const plucker::Vector3Batch<TypeParam> directions = plucker::Vector3Batch<TypeParam>::Random(count, 3) - TypeParam(0.2) * origins;
+
+    std::vector<plucker::RayHit<TypeParam>> expected;
+    plucker::find_closest_hits(mesh, origins, directions, TypeParam(0), inf, expected, 1);
+
+    std::vector<plucker::RayHit<TypeParam>> hits;
+    grid.find_closest_hits(origins, directions, TypeParam(0), inf, hits, 3);
+    ASSERT_EQ(expected.size(), hits.size());
+
+    typename Grid::Mailbox mailbox;
+    auto found = 0;
+    for(std::size_t k = 0; k < hits.size(); k++)
+    {
+        const auto row = static_cast<Eigen::Index>(k);
+        const auto any = grid.has_intersection(Vector3(origins.row(row).transpose()), Vector3(directions.row(row).transpose()), TypeParam(0), inf, mailbox);
+        if(std::isinf(expected[k].t))
+        {
+            EXPECT_TRUE(std::isinf(hits[k].t));
+            EXPECT_FALSE(any);
+            continue;
+        }
+        found++;
+        EXPECT_TRUE(any);
+        EXPECT_EQ(expected[k].triangle, hits[k].triangle);
+        EXPECT_ALMOST_EQUAL(expected[k].t, hits[k].t, atol);
+        EXPECT_ALMOST_EQUAL(expected[k].u, hits[k].u, atol);
+        EXPECT_ALMOST_EQUAL(expected[k].v, hits[k].v, atol);
+
+        // The same given the line of the ray.
+        const Vector3 origin = origins.row(row).transpose();
+        const Vector3 direction = directions.row(row).transpose();
+        const plucker::Plucker<TypeParam> ray(origin.homogeneous().eval(), (origin + direction).homogeneous().eval());
+        const auto hit = grid.find_closest_hit(ray, origin, direction, TypeParam(0), inf, mailbox);
+        EXPECT_TRUE(std::get<0>(hit));
+        EXPECT_EQ(expected[k].triangle, std::get<1>(hit).triangle);
+
+        const auto viewed = grid.find_closest_hit(plucker::PluckerView<const TypeParam>(ray), origin, direction, TypeParam(0), inf, mailbox);
+        EXPECT_TRUE(std::get<0>(viewed));
+        EXPECT_EQ(expected[k].triangle, std::get<1>(viewed).triangle);
+    }
+    EXPECT_LT(0, found);
+}
+
+}   // namespace